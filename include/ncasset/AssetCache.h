@@ -0,0 +1,113 @@
+#pragma once
+
+#include "AssetPackage.h"
+#include "AssetsFwd.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <typeindex>
+#include <unordered_map>
+
+namespace nc::asset
+{
+/** @brief A shared, immutable reference to a cached asset. */
+template<class T>
+using AssetHandle = std::shared_ptr<const T>;
+
+/** @brief Counters describing how an AssetCache has been used. */
+struct AssetCacheStats
+{
+    /** @brief Requests served by a cached asset or by joining a load already in flight. */
+    size_t hits = 0;
+
+    /** @brief Requests that loaded their asset. */
+    size_t misses = 0;
+
+    /** @brief Assets dropped to stay within the byte budget. */
+    size_t evictions = 0;
+
+    /** @brief Bytes charged against the budget by cached assets. */
+    size_t bytes = 0;
+
+    /** @brief Number of cached assets. */
+    size_t entries = 0;
+};
+
+/**
+ * @brief A thread-safe, least-recently-used cache of imported assets, keyed by asset id.
+ *
+ * Each asset is charged its uncompressed blob size, and least-recently-used assets are evicted
+ * once the total exceeds the byte budget. Eviction only releases the cache's reference, so
+ * handles already returned stay valid. Concurrent requests for an asset that is still loading
+ * wait on the same load instead of reading it again. If a load throws, every waiting request
+ * rethrows the error and nothing is cached.
+ *
+ * Supported asset types are AudioClip, ConcaveCollider, CubeMap, HullCollider, Mesh,
+ * SkeletalAnimation, and Texture.
+ */
+class AssetCache
+{
+    public:
+        /** @brief Create an empty cache that holds at most byteBudget bytes of assets. */
+        explicit AssetCache(size_t byteBudget);
+
+        AssetCache(const AssetCache&) = delete;
+        AssetCache& operator=(const AssetCache&) = delete;
+
+        /** @brief Get an asset from a package, importing it on a miss. */
+        template<class T>
+        auto Get(const AssetPackage& package, size_t assetId) -> AssetHandle<T>;
+
+        /**
+         * @brief Get the asset stored in an .nca file, importing it on a miss.
+         * @note The file's NcaHeader is read to find its asset id, even on a hit.
+         */
+        template<class T>
+        auto Get(const std::filesystem::path& ncaPath) -> AssetHandle<T>;
+
+        /** @brief Check if an asset is cached, without affecting its recency. */
+        auto Contains(size_t assetId) const -> bool;
+
+        /** @brief Drop a cached asset. Returns false if it was not cached. */
+        auto Erase(size_t assetId) -> bool;
+
+        /** @brief Drop all cached assets. Loads in flight are still cached when they complete. */
+        void Clear();
+
+        /** @brief Change the byte budget, evicting assets if the cache is now over budget. */
+        void SetByteBudget(size_t byteBudget);
+
+        /** @brief Get the byte budget. */
+        auto GetByteBudget() const -> size_t;
+
+        /** @brief Get the cache's counters. */
+        auto GetStats() const -> AssetCacheStats;
+
+    private:
+        struct Entry
+        {
+            size_t assetId;
+            std::type_index type;
+            std::shared_ptr<const void> asset;
+            size_t size;
+        };
+
+        using EntryList = std::list<Entry>;
+
+        mutable std::mutex m_mutex;
+        EntryList m_entries;
+        std::unordered_map<size_t, EntryList::iterator> m_lookup;
+        std::unordered_map<size_t, std::shared_future<Entry>> m_loading;
+        size_t m_byteBudget;
+        AssetCacheStats m_stats;
+
+        auto Acquire(size_t assetId, std::type_index type, const std::function<Entry()>& load) -> std::shared_ptr<const void>;
+        void Insert(Entry entry);
+        void EvictToBudget();
+};
+} // namespace nc::asset
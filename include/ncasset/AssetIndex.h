@@ -0,0 +1,85 @@
+#pragma once
+
+#include "NcaHeader.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace nc::asset
+{
+class ThreadPool;
+
+/** @brief An .nca file and its header as recorded in an AssetIndex. */
+struct AssetIndexEntry
+{
+    /** @brief Path to the .nca file, relative to the index root. */
+    std::filesystem::path path;
+
+    /** @brief The header read from the file. */
+    NcaHeader header;
+
+    /** @brief Size of the file in bytes when the header was read. */
+    uint64_t fileSize = 0;
+
+    /** @brief Last write time of the file, in file clock ticks, when the header was read. */
+    int64_t lastWriteTime = 0;
+};
+
+/**
+ * @brief A persistent map from asset id to the .nca files under a directory tree.
+ *
+ * Refresh() walks the tree and reads only the NcaHeader of each .nca file,
+ * spreading the work across a thread pool. An index saved with Save() can be
+ * loaded on a later run, after which Refresh() only reopens files whose size
+ * or last write time no longer match the index.
+ */
+class AssetIndex
+{
+    public:
+        /** @brief Create an empty index for a content directory. */
+        explicit AssetIndex(std::filesystem::path root);
+
+        /**
+         * @brief Load entries from a previously saved index file.
+         * @return False if the file is missing or not a valid index, leaving the index empty.
+         */
+        auto Load(const std::filesystem::path& indexPath) -> bool;
+
+        /** @brief Write the index to a file. */
+        void Save(const std::filesystem::path& indexPath) const;
+
+        /**
+         * @brief Rescan the root directory, reading headers of new or modified files on a thread pool.
+         * @return The number of files whose headers were read.
+         */
+        auto Refresh(ThreadPool& pool) -> size_t;
+
+        /** @brief Find the entry for an asset, or nullptr if it is not indexed. */
+        auto Find(size_t assetId) const -> const AssetIndexEntry*;
+
+        /** @brief Get the absolute path of an indexed asset. Throws if the asset is not indexed. */
+        auto GetPath(size_t assetId) const -> std::filesystem::path;
+
+        /** @brief Get all entries, sorted by path. */
+        auto GetEntries() const noexcept -> std::span<const AssetIndexEntry>
+        {
+            return m_entries;
+        }
+
+        /** @brief Get the content directory the index describes. */
+        auto GetRoot() const noexcept -> const std::filesystem::path&
+        {
+            return m_root;
+        }
+
+    private:
+        std::filesystem::path m_root;
+        std::vector<AssetIndexEntry> m_entries;
+        std::unordered_map<size_t, size_t> m_lookup;
+
+        void RebuildLookup();
+};
+} // namespace nc::asset
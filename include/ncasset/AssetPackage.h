@@ -0,0 +1,92 @@
+#pragma once
+
+#include "NcpHeader.h"
+
+#include <concepts>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace nc::asset
+{
+struct NcaHeader;
+
+/**
+ * @brief A read-only handle to an .ncp asset package.
+ *
+ * The package file is opened and its look up table is loaded once on
+ * construction. Assets are then located by id without touching the file
+ * system, using the perfect hash stored with the table: a lookup reads one
+ * bucket seed and one entry. Reads are serialized internally, so a single AssetPackage may be
+ * shared between threads. Any zstd dictionaries stored in the package are
+ * registered on construction.
+ */
+class AssetPackage
+{
+    public:
+        /** @brief Open a package and load its look up table. */
+        explicit AssetPackage(const std::filesystem::path& ncpPath);
+
+        AssetPackage(const AssetPackage&) = delete;
+        AssetPackage& operator=(const AssetPackage&) = delete;
+
+        /** @brief Get the package header. */
+        auto GetHeader() const noexcept -> const NcpHeader&
+        {
+            return m_header;
+        }
+
+        /** @brief Get the path the package was opened from. */
+        auto GetPath() const noexcept -> const std::filesystem::path&
+        {
+            return m_path;
+        }
+
+        /** @brief Get all look up table entries in file order, which is hash slot order. */
+        auto GetEntries() const noexcept -> std::span<const LutEntry>
+        {
+            return m_entries;
+        }
+
+        /** @brief Check if the package contains an asset. */
+        auto Contains(size_t assetId) const -> bool;
+
+        /**
+         * @brief Get the look up table entry for an asset. Throws if the asset is not present.
+         * @note Every import from a package goes through here, so this is where load traces are recorded.
+         */
+        auto GetEntry(size_t assetId) const -> const LutEntry&;
+
+        /**
+         * @brief Check that an NcaHeader read for an asset belongs to it. Throws if it does not.
+         * @note Identical assets may share one stored nca, whose header names only one of them.
+         */
+        void ValidateHeader(size_t assetId, const NcaHeader& header) const;
+
+        /**
+         * @brief Invoke a reader with the package stream positioned at an asset's NcaHeader.
+         * @note The package is locked for the duration of the call.
+         */
+        template<std::invocable<std::istream&> F>
+        auto Read(size_t assetId, F&& reader) const -> std::invoke_result_t<F, std::istream&>
+        {
+            auto lock = std::lock_guard{m_mutex};
+            return reader(SeekTo(GetEntry(assetId)));
+        }
+
+    private:
+        std::filesystem::path m_path;
+        NcpHeader m_header;
+        std::vector<LutEntry> m_entries;
+        std::vector<uint32_t> m_seeds;
+        mutable std::ifstream m_file;
+        mutable std::mutex m_mutex;
+
+        auto Find(size_t assetId) const noexcept -> const LutEntry*;
+        auto SeekTo(const LutEntry& entry) const -> std::istream&;
+};
+} // namespace nc::asset
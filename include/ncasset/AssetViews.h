@@ -0,0 +1,66 @@
+#pragma once
+
+#include "Assets.h"
+
+#include <optional>
+#include <span>
+
+namespace nc::asset
+{
+/** @brief Read-only view of an AudioClip stored in mapped memory. */
+struct AudioClipView
+{
+    size_t samplesPerChannel;
+    std::span<const double> leftChannel;
+    std::span<const double> rightChannel;
+};
+
+/** @brief Read-only view of a ConcaveCollider stored in mapped memory. */
+struct ConcaveColliderView
+{
+    Vector3 extents;
+    float maxExtent;
+    std::span<const Triangle> triangles;
+};
+
+/** @brief Read-only view of a CubeMap stored in mapped memory. */
+struct CubeMapView
+{
+    static constexpr uint32_t numChannels = CubeMap::numChannels;
+
+    uint32_t faceSideLength;
+    std::span<const unsigned char> pixelData;
+};
+
+/** @brief Read-only view of a HullCollider stored in mapped memory. */
+struct HullColliderView
+{
+    Vector3 extents;
+    float maxExtent;
+    std::span<const Vector3> vertices;
+};
+
+/**
+ * @brief Read-only view of a Mesh stored in mapped memory.
+ * @note Vertex and index data are not copied. BonesData is string-keyed, so it
+ *       is decoded into an owning object when present.
+ */
+struct MeshView
+{
+    Vector3 extents;
+    float maxExtent;
+    std::span<const MeshVertex> vertices;
+    std::span<const uint32_t> indices;
+    std::optional<BonesData> bonesData;
+};
+
+/** @brief Read-only view of a Texture stored in mapped memory. */
+struct TextureView
+{
+    static constexpr uint32_t numChannels = Texture::numChannels;
+
+    uint32_t width;
+    uint32_t height;
+    std::span<const unsigned char> pixelData;
+};
+} // namespace nc::asset
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nc::asset
+{
+/** @brief What happened to an asset reported by an AssetWatcher. */
+enum class AssetChangeType
+{
+    /** @brief An asset id appeared in a watched directory or package. */
+    Added,
+
+    /** @brief An asset was rewritten. */
+    Modified,
+
+    /** @brief An asset id is no longer present. */
+    Removed
+};
+
+/** @brief A change to a watched asset. */
+struct AssetChange
+{
+    /** @brief Id of the asset, from its NcaHeader or package look up table entry. */
+    size_t assetId;
+
+    /** @brief What happened to the asset. */
+    AssetChangeType type;
+
+    /** @brief The .nca file or .ncp package holding the asset. */
+    std::filesystem::path path;
+};
+
+/** @brief Receives changes from AssetWatcher::Poll(). */
+using AssetChangeCallback = std::function<void(const AssetChange&)>;
+
+/** @brief Selects how an AssetWatcher detects changes. */
+enum class AssetWatchMode
+{
+    /** @brief Use inotify where the platform supports it, and polling otherwise. */
+    Automatic,
+
+    /** @brief Always rescan watched files on an interval. */
+    Polling
+};
+
+/**
+ * @brief Reports which assets changed in watched output directories and packages.
+ *
+ * On Linux, the watched directories are registered with inotify, and Poll() only reads
+ * the headers of .nca files that were written, moved, or deleted since the last call.
+ * Elsewhere, Poll() rescans every watched file once per poll interval, and rereads
+ * the header of any file whose size or last write time changed. Files are only
+ * reported once their size matches their header, so partially written files are
+ * picked up by a later poll.
+ *
+ * If a directory can't be registered with inotify, such as when the watch limit is
+ * reached, or its watch is lost because it was deleted or moved, everything is
+ * rescanned once per poll interval until the directory can be watched again.
+ *
+ * A package is reread when it is replaced, and its entries are compared by their
+ * last updated time. Entries rebuilt within the same second as their previous
+ * version are not reported.
+ */
+class AssetWatcher
+{
+    public:
+        /** @brief The default time between rescans when polling. */
+        static constexpr auto defaultPollInterval = std::chrono::milliseconds{500};
+
+        explicit AssetWatcher(AssetWatchMode mode = AssetWatchMode::Automatic, std::chrono::milliseconds pollInterval = defaultPollInterval);
+        ~AssetWatcher() noexcept;
+
+        AssetWatcher(const AssetWatcher&) = delete;
+        AssetWatcher& operator=(const AssetWatcher&) = delete;
+
+        /**
+         * @brief Watch the .nca files directly within a directory.
+         * @note Files already present are recorded without being reported.
+         */
+        void WatchDirectory(const std::filesystem::path& directory);
+
+        /**
+         * @brief Watch the entries of a package, which need not exist yet.
+         * @note Entries already present are recorded without being reported.
+         */
+        void WatchPackage(const std::filesystem::path& ncpPath);
+
+        /**
+         * @brief Report changes since the last call without blocking.
+         * @return The number of changes passed to the callback.
+         */
+        auto Poll(const AssetChangeCallback& onChange) -> size_t;
+
+        /** @brief Check if changes are detected with inotify. */
+        auto IsUsingInotify() const noexcept -> bool;
+
+    private:
+        class Inotify;
+
+        struct WatchedFile
+        {
+            size_t assetId;
+            uint64_t fileSize;
+            int64_t lastWriteTime;
+        };
+
+        struct WatchedPackage
+        {
+            std::filesystem::path path;
+            uint64_t fileSize = 0;
+            int64_t lastWriteTime = 0;
+            std::unordered_map<size_t, int64_t> entries;
+        };
+
+        std::unique_ptr<Inotify> m_inotify;
+        std::vector<std::filesystem::path> m_directories;
+        std::unordered_map<std::string, WatchedFile> m_files;
+        std::vector<WatchedPackage> m_packages;
+        std::chrono::milliseconds m_pollInterval;
+        std::chrono::steady_clock::time_point m_lastScan;
+
+        void Scan(const AssetChangeCallback& onChange);
+        void ScanDirectory(const std::filesystem::path& directory, const AssetChangeCallback& onChange);
+        void RefreshFile(const std::filesystem::path& path, const AssetChangeCallback& onChange);
+        void RefreshPackage(WatchedPackage& package, const AssetChangeCallback& onChange);
+};
+} // namespace nc::asset
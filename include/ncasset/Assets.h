@@ -7,6 +7,7 @@
 #include <optional>
 #include <string>
 #include <unordered_map>
+#include <variant>
 #include <vector>
 
 namespace nc::asset
@@ -127,6 +128,15 @@ struct Texture
     std::vector<unsigned char> pixelData;
 };
 
+/** @brief A rectangle of pixels within a Texture, with its origin at the top-left. */
+struct TextureRegion
+{
+    uint32_t x;
+    uint32_t y;
+    uint32_t width;
+    uint32_t height;
+};
+
 struct CubeMap
 {
     static constexpr uint32_t numChannels = 4u;
@@ -134,4 +144,7 @@ struct CubeMap
     uint32_t faceSideLength;
     std::vector<unsigned char> pixelData;
 };
+
+/** @brief Holds any importable asset type. */
+using AnyAsset = std::variant<AudioClip, ConcaveCollider, CubeMap, HullCollider, Mesh, SkeletalAnimation, Texture>;
 } // namespace nc::asset
@@ -11,4 +11,17 @@ struct Mesh;
 struct MeshVertex;
 struct SkeletalAnimation;
 struct Texture;
+struct TextureRegion;
 } // namespace nc::asset
+
+namespace nc::asset::pmr
+{
+struct AudioClip;
+struct BonesData;
+struct ConcaveCollider;
+struct CubeMap;
+struct HullCollider;
+struct Mesh;
+struct SkeletalAnimation;
+struct Texture;
+} // namespace nc::asset::pmr
@@ -0,0 +1,82 @@
+#pragma once
+
+#include "Assets.h"
+#include "AssetType.h"
+
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <future>
+#include <optional>
+#include <span>
+#include <variant>
+#include <vector>
+
+namespace nc::asset
+{
+class AssetPackage;
+class BulkReader;
+class ThreadPool;
+
+/** @brief Identifies an asset to load as part of a batch. */
+struct ImportRequest
+{
+    /** @brief Path to an .nca file, or the id of an asset in the batch's package. */
+    std::variant<std::filesystem::path, size_t> source;
+
+    /** @brief The expected type of the asset. */
+    AssetType type;
+};
+
+/** @brief The outcome of a single request delivered to an ImportCallback. */
+struct ImportResult
+{
+    /** @brief Index of the request within the batch. */
+    size_t requestIndex;
+
+    /** @brief The imported asset, or empty on failure. */
+    std::optional<AnyAsset> asset;
+
+    /** @brief The exception thrown while importing, or null on success. */
+    std::exception_ptr error;
+};
+
+/** @brief Receives results as requests complete. May be invoked concurrently from worker threads. */
+using ImportCallback = std::function<void(ImportResult&&)>;
+
+/**
+ * @brief Import assets concurrently on a thread pool.
+ * @param requests The assets to import.
+ * @param pool The pool to decode on.
+ * @param package Package used for requests identified by asset id. It must outlive the batch.
+ * @return A future for each request, in request order.
+ */
+auto ImportBatch(std::span<const ImportRequest> requests,
+                 ThreadPool& pool,
+                 const AssetPackage* package = nullptr) -> std::vector<std::future<AnyAsset>>;
+
+/** @brief Import assets concurrently on a shared internal pool with one thread per hardware thread. */
+auto ImportBatch(std::span<const ImportRequest> requests,
+                 const AssetPackage* package = nullptr) -> std::vector<std::future<AnyAsset>>;
+
+/**
+ * @brief Import assets concurrently, delivering each result to a callback as it completes.
+ * @note The callback is invoked from worker threads and must not throw.
+ */
+void ImportBatch(std::span<const ImportRequest> requests,
+                 ThreadPool& pool,
+                 ImportCallback onComplete,
+                 const AssetPackage* package = nullptr);
+
+/**
+ * @brief Import assets, reading all .nca files of the batch together with a BulkReader.
+ * @note Each file is handed to the pool for decoding as soon as it has been read. Returns once
+ *       every file has been read; decoding may still be in progress. The callback is invoked
+ *       from worker threads, or the calling thread for files that failed to read, and must not throw.
+ */
+void ImportBatch(std::span<const ImportRequest> requests,
+                 BulkReader& reader,
+                 ThreadPool& pool,
+                 ImportCallback onComplete,
+                 const AssetPackage* package = nullptr);
+} // namespace nc::asset
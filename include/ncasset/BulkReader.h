@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace nc::asset
+{
+class ThreadPool;
+
+/** @brief A file delivered to a BulkReadCallback. */
+struct BulkReadResult
+{
+    /** @brief Index of the file's path within the batch. */
+    size_t pathIndex;
+
+    /** @brief The complete file contents, or empty on failure. */
+    std::vector<std::byte> bytes;
+
+    /** @brief The exception describing why the file could not be read, or null on success. */
+    std::exception_ptr error;
+};
+
+/** @brief Receives files as their reads complete. Must not throw. */
+using BulkReadCallback = std::function<void(BulkReadResult&&)>;
+
+/** @brief Selects how a BulkReader issues reads. */
+enum class BulkReadMode
+{
+    /** @brief Use io_uring where the platform and kernel support it, and blocking reads otherwise. */
+    Automatic,
+
+    /** @brief Always use blocking reads on a thread pool. */
+    Blocking
+};
+
+/**
+ * @brief Reads many .nca files with their opens and reads in flight together.
+ *
+ * On Linux, each file's open, statx, read, and close are queued on an io_uring, with
+ * up to the queue depth operations outstanding at once, so a batch costs a handful of
+ * syscalls rather than several per file. A file's NcaHeader and blob are read with a
+ * single request, as its size comes from the statx completion. Where io_uring is not
+ * available, files are read with blocking reads on a thread pool of up to queue
+ * depth threads.
+ */
+class BulkReader
+{
+    public:
+        /** @brief The default number of operations kept in flight. */
+        static constexpr auto defaultQueueDepth = 256u;
+
+        explicit BulkReader(unsigned queueDepth = defaultQueueDepth, BulkReadMode mode = BulkReadMode::Automatic);
+        ~BulkReader() noexcept;
+
+        BulkReader(const BulkReader&) = delete;
+        BulkReader& operator=(const BulkReader&) = delete;
+
+        /**
+         * @brief Read files, passing each to a callback as soon as it has been read.
+         * @note Returns once every file has been delivered. With io_uring, the callback is
+         *       invoked on the calling thread; otherwise it may be invoked concurrently from
+         *       pool threads. A BulkReader reads one batch at a time. Throws if io_uring fails,
+         *       once the operations already queued have completed and their files are closed.
+         *       If they cannot be completed, later batches use blocking reads.
+         */
+        void Read(std::span<const std::filesystem::path> paths, const BulkReadCallback& onRead);
+
+        /** @brief Check if reads are issued through io_uring. */
+        auto IsUsingIoUring() const noexcept -> bool;
+
+    private:
+        class Ring;
+
+        std::unique_ptr<Ring> m_ring;
+        std::unique_ptr<ThreadPool> m_pool;
+        unsigned m_queueDepth;
+
+        void ReadWithRing(std::span<const std::filesystem::path> paths, const BulkReadCallback& onRead);
+        void ReadWithPool(std::span<const std::filesystem::path> paths, const BulkReadCallback& onRead);
+};
+} // namespace nc::asset
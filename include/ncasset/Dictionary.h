@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+
+namespace nc::asset
+{
+/** @brief Get the reserved asset id for a zstd dictionary stored in a package. */
+auto GetDictionaryAssetId(uint32_t dictionaryId) -> size_t;
+
+/** @brief Check if an asset id is reserved for a zstd dictionary. */
+auto IsDictionaryAssetId(size_t assetId) -> bool;
+
+/**
+ * @brief Make a trained zstd dictionary available for decompressing assets.
+ * @return The dictionary id that compressed blobs refer to.
+ * @note Dictionaries are shared by all threads and stay registered for the lifetime of the
+ *       process. Dictionaries embedded in a package are registered when the AssetPackage is
+ *       opened; throws if NcAsset was built without zstd support.
+ */
+auto RegisterDictionary(std::span<const std::byte> dictionary) -> uint32_t;
+
+/** @brief Register all dictionaries from a .ncd file written alongside loose .nca files. */
+void RegisterDictionaries(const std::filesystem::path& ncdPath);
+} // namespace nc::asset
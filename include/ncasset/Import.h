@@ -1,10 +1,16 @@
 #pragma once
 
+#include "AssetPackage.h"
 #include "Assets.h"
+#include "AssetViews.h"
+#include "MappedFile.h"
 #include "NcaHeader.h"
+#include "PmrAssets.h"
+#include "VertexLayout.h"
 
 #include <filesystem>
 #include <iosfwd>
+#include <memory_resource>
 
 namespace nc::asset
 {
@@ -50,9 +56,286 @@ auto ImportTexture(const std::filesystem::path& ncaPath) -> Texture;
 /** @brief Read a Texture asset from a binary stream */
 auto ImportTexture(std::istream& data) -> Texture;
 
+/**
+ * @brief Read an asset of whichever type is named by an .nca file's header.
+ * @note The file is opened and its header is read once. Shaders and fonts cannot be imported.
+ */
+auto ImportAny(const std::filesystem::path& ncaPath) -> AnyAsset;
+
+/** @brief Read an asset of whichever type is named by its header from a binary stream. */
+auto ImportAny(std::istream& data) -> AnyAsset;
+
+/**
+ * @brief Read an asset of whichever type is named by an .nca file's header, along with the header.
+ * @note The header is read once, so this is cheaper than importing the header and asset separately.
+ */
+auto ImportAnyWithHeader(const std::filesystem::path& ncaPath) -> DeserializedResult<AnyAsset>;
+
+/** @brief Read an asset of whichever type is named by its header from a binary stream, along with the header. */
+auto ImportAnyWithHeader(std::istream& data) -> DeserializedResult<AnyAsset>;
+
 /** @brief Read the header from an .nca file. */
 auto ImportNcaHeader(const std::filesystem::path& ncaPath) -> NcaHeader;
 
 /** @brief Read the header from an asset in a binary stream. */
 auto ImportNcaHeader(std::istream& data) -> NcaHeader;
+
+/** @brief Read an AudioClip asset from a package. */
+auto ImportAudioClip(const AssetPackage& package, size_t assetId) -> AudioClip;
+
+/** @brief Read a ConcaveCollider asset from a package. */
+auto ImportConcaveCollider(const AssetPackage& package, size_t assetId) -> ConcaveCollider;
+
+/** @brief Read a CubeMap asset from a package. */
+auto ImportCubeMap(const AssetPackage& package, size_t assetId) -> CubeMap;
+
+/** @brief Read a HullCollider asset from a package. */
+auto ImportHullCollider(const AssetPackage& package, size_t assetId) -> HullCollider;
+
+/** @brief Read a Mesh asset from a package. */
+auto ImportMesh(const AssetPackage& package, size_t assetId) -> Mesh;
+
+/** @brief Read a SkeletalAnimation asset from a package. */
+auto ImportSkeletalAnimation(const AssetPackage& package, size_t assetId) -> SkeletalAnimation;
+
+/** @brief Read a Texture asset from a package. */
+auto ImportTexture(const AssetPackage& package, size_t assetId) -> Texture;
+
+/** @brief Read an asset of whichever type is named by its header from a package. */
+auto ImportAny(const AssetPackage& package, size_t assetId) -> AnyAsset;
+
+/** @brief Read the header of an asset in a package. */
+auto ImportNcaHeader(const AssetPackage& package, size_t assetId) -> NcaHeader;
+
+/**
+ * @brief Read an AudioClip asset from an .nca file into an existing object.
+ * @note Existing buffers are reused and only grow when the new asset is larger. If
+ *       an exception is thrown, the contents of the object are unspecified.
+ */
+void ImportAudioClip(const std::filesystem::path& ncaPath, AudioClip& asset);
+
+/** @brief Read an AudioClip asset from a binary stream into an existing object. */
+void ImportAudioClip(std::istream& data, AudioClip& asset);
+
+/** @brief Read an AudioClip asset from a package into an existing object. */
+void ImportAudioClip(const AssetPackage& package, size_t assetId, AudioClip& asset);
+
+/** @brief Read a ConcaveCollider asset from an .nca file into an existing object. */
+void ImportConcaveCollider(const std::filesystem::path& ncaPath, ConcaveCollider& asset);
+
+/** @brief Read a ConcaveCollider asset from a binary stream into an existing object. */
+void ImportConcaveCollider(std::istream& data, ConcaveCollider& asset);
+
+/** @brief Read a ConcaveCollider asset from a package into an existing object. */
+void ImportConcaveCollider(const AssetPackage& package, size_t assetId, ConcaveCollider& asset);
+
+/** @brief Read a CubeMap asset from an .nca file into an existing object. */
+void ImportCubeMap(const std::filesystem::path& ncaPath, CubeMap& asset);
+
+/** @brief Read a CubeMap asset from a binary stream into an existing object. */
+void ImportCubeMap(std::istream& data, CubeMap& asset);
+
+/** @brief Read a CubeMap asset from a package into an existing object. */
+void ImportCubeMap(const AssetPackage& package, size_t assetId, CubeMap& asset);
+
+/** @brief Read a HullCollider asset from an .nca file into an existing object. */
+void ImportHullCollider(const std::filesystem::path& ncaPath, HullCollider& asset);
+
+/** @brief Read a HullCollider asset from a binary stream into an existing object. */
+void ImportHullCollider(std::istream& data, HullCollider& asset);
+
+/** @brief Read a HullCollider asset from a package into an existing object. */
+void ImportHullCollider(const AssetPackage& package, size_t assetId, HullCollider& asset);
+
+/** @brief Read a Mesh asset from an .nca file into an existing object. */
+void ImportMesh(const std::filesystem::path& ncaPath, Mesh& asset);
+
+/** @brief Read a Mesh asset from a binary stream into an existing object. */
+void ImportMesh(std::istream& data, Mesh& asset);
+
+/** @brief Read a Mesh asset from a package into an existing object. */
+void ImportMesh(const AssetPackage& package, size_t assetId, Mesh& asset);
+
+/** @brief Read a SkeletalAnimation asset from an .nca file into an existing object. */
+void ImportSkeletalAnimation(const std::filesystem::path& ncaPath, SkeletalAnimation& asset);
+
+/** @brief Read a SkeletalAnimation asset from a binary stream into an existing object. */
+void ImportSkeletalAnimation(std::istream& data, SkeletalAnimation& asset);
+
+/** @brief Read a SkeletalAnimation asset from a package into an existing object. */
+void ImportSkeletalAnimation(const AssetPackage& package, size_t assetId, SkeletalAnimation& asset);
+
+/** @brief Read a Texture asset from an .nca file into an existing object. */
+void ImportTexture(const std::filesystem::path& ncaPath, Texture& asset);
+
+/** @brief Read a Texture asset from a binary stream into an existing object. */
+void ImportTexture(std::istream& data, Texture& asset);
+
+/** @brief Read a Texture asset from a package into an existing object. */
+void ImportTexture(const AssetPackage& package, size_t assetId, Texture& asset);
+
+/**
+ * @brief Read an AudioClip asset from an .nca file, allocating from a memory resource.
+ * @note All containers in the returned asset, including nested ones, use the given resource.
+ */
+auto ImportAudioClip(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::AudioClip;
+
+/** @brief Read an AudioClip asset from a binary stream, allocating from a memory resource. */
+auto ImportAudioClip(std::istream& data, std::pmr::memory_resource* resource) -> pmr::AudioClip;
+
+/** @brief Read an AudioClip asset from a package, allocating from a memory resource. */
+auto ImportAudioClip(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::AudioClip;
+
+/** @brief Read a ConcaveCollider asset from an .nca file, allocating from a memory resource. */
+auto ImportConcaveCollider(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::ConcaveCollider;
+
+/** @brief Read a ConcaveCollider asset from a binary stream, allocating from a memory resource. */
+auto ImportConcaveCollider(std::istream& data, std::pmr::memory_resource* resource) -> pmr::ConcaveCollider;
+
+/** @brief Read a ConcaveCollider asset from a package, allocating from a memory resource. */
+auto ImportConcaveCollider(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::ConcaveCollider;
+
+/** @brief Read a CubeMap asset from an .nca file, allocating from a memory resource. */
+auto ImportCubeMap(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::CubeMap;
+
+/** @brief Read a CubeMap asset from a binary stream, allocating from a memory resource. */
+auto ImportCubeMap(std::istream& data, std::pmr::memory_resource* resource) -> pmr::CubeMap;
+
+/** @brief Read a CubeMap asset from a package, allocating from a memory resource. */
+auto ImportCubeMap(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::CubeMap;
+
+/** @brief Read a HullCollider asset from an .nca file, allocating from a memory resource. */
+auto ImportHullCollider(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::HullCollider;
+
+/** @brief Read a HullCollider asset from a binary stream, allocating from a memory resource. */
+auto ImportHullCollider(std::istream& data, std::pmr::memory_resource* resource) -> pmr::HullCollider;
+
+/** @brief Read a HullCollider asset from a package, allocating from a memory resource. */
+auto ImportHullCollider(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::HullCollider;
+
+/** @brief Read a Mesh asset from an .nca file, allocating from a memory resource. */
+auto ImportMesh(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::Mesh;
+
+/** @brief Read a Mesh asset from a binary stream, allocating from a memory resource. */
+auto ImportMesh(std::istream& data, std::pmr::memory_resource* resource) -> pmr::Mesh;
+
+/** @brief Read a Mesh asset from a package, allocating from a memory resource. */
+auto ImportMesh(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::Mesh;
+
+/** @brief Read a SkeletalAnimation asset from an .nca file, allocating from a memory resource. */
+auto ImportSkeletalAnimation(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::SkeletalAnimation;
+
+/** @brief Read a SkeletalAnimation asset from a binary stream, allocating from a memory resource. */
+auto ImportSkeletalAnimation(std::istream& data, std::pmr::memory_resource* resource) -> pmr::SkeletalAnimation;
+
+/** @brief Read a SkeletalAnimation asset from a package, allocating from a memory resource. */
+auto ImportSkeletalAnimation(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::SkeletalAnimation;
+
+/** @brief Read a Texture asset from an .nca file, allocating from a memory resource. */
+auto ImportTexture(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::Texture;
+
+/** @brief Read a Texture asset from a binary stream, allocating from a memory resource. */
+auto ImportTexture(std::istream& data, std::pmr::memory_resource* resource) -> pmr::Texture;
+
+/** @brief Read a Texture asset from a package, allocating from a memory resource. */
+auto ImportTexture(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::Texture;
+
+/**
+ * @brief Read a rectangular region of a Texture asset from an .nca file.
+ * @note Only the pixels inside the region are read; the rest of the pixel data is
+ *       skipped by seeking. The returned Texture has the region's width and height.
+ */
+auto ImportTextureRegion(const std::filesystem::path& ncaPath, const TextureRegion& region) -> Texture;
+
+/** @brief Read a rectangular region of a Texture asset from a seekable binary stream. */
+auto ImportTextureRegion(std::istream& data, const TextureRegion& region) -> Texture;
+
+/** @brief Read a rectangular region of a Texture asset from a package. */
+auto ImportTextureRegion(const AssetPackage& package, size_t assetId, const TextureRegion& region) -> Texture;
+
+/** @brief Read a range of full-width rows of a Texture asset from an .nca file. */
+auto ImportTextureRows(const std::filesystem::path& ncaPath, uint32_t firstRow, uint32_t rowCount) -> Texture;
+
+/** @brief Read a range of full-width rows of a Texture asset from a seekable binary stream. */
+auto ImportTextureRows(std::istream& data, uint32_t firstRow, uint32_t rowCount) -> Texture;
+
+/** @brief Read a range of full-width rows of a Texture asset from a package. */
+auto ImportTextureRows(const AssetPackage& package, size_t assetId, uint32_t firstRow, uint32_t rowCount) -> Texture;
+
+/**
+ * @brief Read a Mesh asset from an .nca file without its BonesData.
+ * @note The bones section is skipped by seeking, so it is never parsed. Use ImportMeshBones()
+ *       to load it later if needed.
+ */
+auto ImportMeshWithoutBones(const std::filesystem::path& ncaPath) -> Mesh;
+
+/** @brief Read a Mesh asset from a seekable binary stream without its BonesData. */
+auto ImportMeshWithoutBones(std::istream& data) -> Mesh;
+
+/** @brief Read a Mesh asset from a package without its BonesData. */
+auto ImportMeshWithoutBones(const AssetPackage& package, size_t assetId) -> Mesh;
+
+/** @brief Read only the BonesData of a Mesh asset from an .nca file, seeking past its vertices and indices. */
+auto ImportMeshBones(const std::filesystem::path& ncaPath) -> std::optional<BonesData>;
+
+/** @brief Read only the BonesData of a Mesh asset from a seekable binary stream. */
+auto ImportMeshBones(std::istream& data) -> std::optional<BonesData>;
+
+/** @brief Read only the BonesData of a Mesh asset from a package. */
+auto ImportMeshBones(const AssetPackage& package, size_t assetId) -> std::optional<BonesData>;
+
+/** @brief Read only the indices of a Mesh asset from an .nca file, seeking past its vertices. */
+auto ImportMeshIndices(const std::filesystem::path& ncaPath) -> std::vector<uint32_t>;
+
+/** @brief Read only the indices of a Mesh asset from a seekable binary stream. */
+auto ImportMeshIndices(std::istream& data) -> std::vector<uint32_t>;
+
+/** @brief Read only the indices of a Mesh asset from a package. */
+auto ImportMeshIndices(const AssetPackage& package, size_t assetId) -> std::vector<uint32_t>;
+
+/**
+ * @brief Convert only the vertices of a Mesh asset in an .nca file into caller provided streams.
+ * @param layout The attributes, formats, and strides to write.
+ * @param allocate Called once per stream in the layout with the bytes it needs, once the vertex
+ *        count is known. Returning a mapped GPU buffer writes vertices directly into it.
+ * @return The number of vertices written.
+ * @note Vertices are converted from the stored MeshVertex format a block at a time, so no
+ *       intermediate vertex list is built. Indices can be read with ImportMeshIndices().
+ */
+auto ImportMeshVertices(const std::filesystem::path& ncaPath, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> size_t;
+
+/** @brief Convert only the vertices of a Mesh asset from a seekable binary stream into caller provided streams. */
+auto ImportMeshVertices(std::istream& data, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> size_t;
+
+/** @brief Convert only the vertices of a Mesh asset from a package into caller provided streams. */
+auto ImportMeshVertices(const AssetPackage& package, size_t assetId, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> size_t;
+
+/**
+ * @brief Convert only the vertices of a Mesh asset in a mapped file into caller provided streams.
+ * @note Uncompressed vertices are converted straight from the mapping without being copied first.
+ */
+auto ImportMeshVertices(const MappedFile& file, const VertexLayout& layout, const VertexStreamAllocator& allocate, size_t offset = 0) -> size_t;
+
+/**
+ * @brief View an AudioClip asset in a mapped file without copying it.
+ * @param file The mapped .nca or package file. It must outlive the returned view.
+ * @param offset Byte offset of the asset's NcaHeader within the file. For packages,
+ *        use the offset from the asset's LutEntry.
+ */
+auto ImportAudioClipView(const MappedFile& file, size_t offset = 0) -> AudioClipView;
+
+/** @brief View a ConcaveCollider asset in a mapped file without copying it. */
+auto ImportConcaveColliderView(const MappedFile& file, size_t offset = 0) -> ConcaveColliderView;
+
+/** @brief View a CubeMap asset in a mapped file without copying it. */
+auto ImportCubeMapView(const MappedFile& file, size_t offset = 0) -> CubeMapView;
+
+/** @brief View a HullCollider asset in a mapped file without copying it. */
+auto ImportHullColliderView(const MappedFile& file, size_t offset = 0) -> HullColliderView;
+
+/** @brief View a Mesh asset in a mapped file without copying vertex or index data. */
+auto ImportMeshView(const MappedFile& file, size_t offset = 0) -> MeshView;
+
+/** @brief View a Texture asset in a mapped file without copying it. */
+auto ImportTextureView(const MappedFile& file, size_t offset = 0) -> TextureView;
 } // namespace nc::asset
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "AssetPackage.h"
+#include "AssetsFwd.h"
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <iosfwd>
+#include <limits>
+#include <memory>
+
+namespace nc::asset
+{
+class IncrementalImportState;
+
+/** @brief Limits the work done by one IncrementalImporter::Step(). */
+struct ImportBudget
+{
+    /** @brief The most stored asset bytes to read. Must be nonzero. */
+    size_t bytes = std::numeric_limits<size_t>::max();
+
+    /** @brief The time after which the step yields at its next read. */
+    std::chrono::microseconds time = std::chrono::microseconds::max();
+};
+
+/**
+ * @brief Imports an asset across many calls, each bounded by an ImportBudget.
+ *
+ * The asset is read by the same deserializer as the Import functions, running on a thread
+ * that only makes progress while Step() is waiting on it. Between steps the thread is parked,
+ * so at most one thread does the work at a time and each call returns within roughly its
+ * budget. Imports share a pool with one thread per hardware thread, and an unfinished import
+ * holds its pool thread, so imports started while the pool is full run on their own thread. Data is read in slices of up to 64 KiB, and the budget is checked before each
+ * slice, so a step may overrun its time by the cost of one slice and always reads at least one.
+ * Compressed blobs are read within the budget, but decompressed in the step that reads their
+ * final slice.
+ *
+ * Supported asset types are AudioClip, ConcaveCollider, CubeMap, HullCollider, Mesh,
+ * SkeletalAnimation, and Texture.
+ */
+template<class T>
+class IncrementalImporter
+{
+    public:
+        /** @brief Prepare to import an asset from an .nca file. Only the NcaHeader is read. */
+        explicit IncrementalImporter(const std::filesystem::path& ncaPath);
+
+        /**
+         * @brief Prepare to import an asset from a package.
+         * @note The package file is opened separately, so the package is not locked between steps.
+         */
+        IncrementalImporter(const AssetPackage& package, size_t assetId);
+
+        /** @brief Prepare to import an asset from a seekable binary stream positioned at its NcaHeader. */
+        explicit IncrementalImporter(std::unique_ptr<std::istream> data);
+
+        /** @brief Abandon an unfinished import. */
+        ~IncrementalImporter() noexcept;
+
+        IncrementalImporter(IncrementalImporter&&) noexcept;
+        IncrementalImporter& operator=(IncrementalImporter&&) noexcept;
+
+        /**
+         * @brief Continue the import within a budget.
+         * @return True once the asset has been fully imported.
+         * @note Rethrows any error raised by the import.
+         */
+        auto Step(const ImportBudget& budget = ImportBudget{}) -> bool;
+
+        /** @brief Complete any remaining work without a budget and take the asset. */
+        auto Finish() -> T;
+
+        /** @brief Check if the asset has been fully imported. */
+        auto IsComplete() const noexcept -> bool;
+
+        /** @brief Get the fraction of the stored asset that has been read, from 0 to 1. */
+        auto GetProgress() const noexcept -> float;
+
+    private:
+        std::unique_ptr<T> m_asset;
+        std::unique_ptr<IncrementalImportState> m_state;
+};
+} // namespace nc::asset
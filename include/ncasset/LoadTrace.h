@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace nc::asset
+{
+/**
+ * @brief Start recording the id of every asset looked up in an AssetPackage.
+ * @note Each id is recorded once, in first-lookup order, across all threads and packages.
+ *       Starting a trace discards any trace in progress.
+ */
+void BeginLoadTrace();
+
+/** @brief Stop recording and get the ids looked up since BeginLoadTrace(). */
+auto EndLoadTrace() -> std::vector<size_t>;
+
+/**
+ * @brief Write a load trace as text, one asset id per line.
+ * @note nc-convert accepts the file to lay out packages in first-load order.
+ */
+void WriteLoadTrace(const std::filesystem::path& tracePath, std::span<const size_t> assetIds);
+
+/** @brief Read a load trace written by WriteLoadTrace(). */
+auto ReadLoadTrace(const std::filesystem::path& tracePath) -> std::vector<size_t>;
+} // namespace nc::asset
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace nc::asset
+{
+/**
+ * @brief A read-only memory mapping of an entire file.
+ * @note Asset views created from a MappedFile point directly into the mapping
+ *       and are only valid for the lifetime of the MappedFile.
+ */
+class MappedFile
+{
+    public:
+        /** @brief Map the contents of a file. */
+        explicit MappedFile(const std::filesystem::path& path);
+        ~MappedFile() noexcept;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        /** @brief Get the mapped bytes. */
+        auto Data() const noexcept -> std::span<const std::byte>
+        {
+            return std::span<const std::byte>{m_data, m_size};
+        }
+
+        /** @brief Get the size of the mapping in bytes. */
+        auto Size() const noexcept -> size_t
+        {
+            return m_size;
+        }
+
+    private:
+        const std::byte* m_data = nullptr;
+        size_t m_size = 0;
+
+        void Unmap() noexcept;
+};
+} // namespace nc::asset
@@ -3,6 +3,7 @@
 #include "AssetType.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <iosfwd>
 #include <string_view>
 
@@ -14,6 +15,7 @@ struct MagicNumber
     static constexpr auto audioClip = std::string_view{"CLIP"};
     static constexpr auto concaveCollider = std::string_view{"CONC"};
     static constexpr auto cubeMap = std::string_view{"CUBE"};
+    static constexpr auto dictionary = std::string_view{"DICT"};
     static constexpr auto hullCollider = std::string_view{"HULL"};
     static constexpr auto mesh = std::string_view{"MESH"};
     static constexpr auto shader = std::string_view{"SHAD"};
@@ -21,6 +23,14 @@ struct MagicNumber
     static constexpr auto texture = std::string_view{"TEXT"};
 };
 
+/** @brief Identifiers for asset blob compression in .nca files. */
+struct CompressionAlgorithm
+{
+    static constexpr auto none = std::string_view{"NONE"};
+    static constexpr auto lz4 = std::string_view{"LZ4"};
+    static constexpr auto zstd = std::string_view{"ZSTD"};
+};
+
 /** @brief Common file header for all asset types. */
 struct NcaHeader
 {
@@ -33,16 +43,50 @@ struct NcaHeader
     /** @brief Asset type identifier. */
     char magicNumber[5] = "NONE";
 
-    /** @brief Compression type for the asset blob. */
+    /** @brief Compression type for the asset blob. One of the CompressionAlgorithm identifiers. */
     char compressionAlgorithm[5] = "NONE";
 
     /** @brief The Fnv1a hash of the asset's friendly name. */
     size_t assetId = 0;
 
-    /** @brief Size in bytes of the asset blob following this header. */
+    /** @brief Size in bytes of the asset blob following this header, as stored (after compression). */
     size_t size = 0;
 };
 
+/**
+ * @brief Byte offsets of the sections of a Mesh blob, measured from the start of the blob.
+ * @note The table follows the mesh extents, letting readers skip to the index buffer or
+ *       bones data without scanning the sections before them.
+ */
+struct MeshSectionTable
+{
+    /** @brief Offset of the table within the blob, following the extents and max extent. */
+    static constexpr auto blobOffset = size_t{16};
+
+    /** @brief Offset of the first byte following the table, where the earliest section may start. */
+    static constexpr auto endOffset = blobOffset + sizeof(uint64_t) * 4;
+
+    /** @brief Offset of the vertex count and vertex list. */
+    uint64_t vertices = endOffset;
+
+    /** @brief Offset of the index count and indices. */
+    uint64_t indices = endOffset;
+
+    /** @brief Offset of the bones data flag and BonesData. */
+    uint64_t bones = endOffset;
+
+    /** @brief Size of the blob, marking the end of the bones section. */
+    uint64_t end = endOffset;
+};
+
+/** @brief A header and asset pair returned from a deserialize operation. */
+template<class AssetType>
+struct DeserializedResult
+{
+    NcaHeader header;
+    AssetType asset;
+};
+
 /** @brief Get the AssetType for an NcaHeader. */
 auto GetAssetType(const NcaHeader& header) -> AssetType;
 
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace nc::asset
+{
+/** @brief Common file header for .ncp asset packages. */
+struct NcpHeader
+{
+    /** @brief Identifier for .ncp files. */
+    static constexpr auto packageMagicNumber = std::string_view{"NCPK"};
+
+    /** @brief The package format version produced and understood by this library. */
+    static constexpr auto currentVersion = std::string_view{"00.04.00"};
+
+    /**
+     * @brief Size of a serialized NcpHeader.
+     * @note Binary size does not include null terminators.
+     */
+    static constexpr auto binarySize = size_t{20};
+
+    /** @brief Package identifier. */
+    char magicNumber[5] = "NCPK";
+
+    /** @brief Package format version as 'XX.YY.ZZ'. */
+    char version[9] = "00.04.00";
+
+    /** @brief Number of entries in the look up table. */
+    size_t assetCount = 0;
+};
+
+/** @brief Look up table entry identifying an asset within a package. */
+struct LutEntry
+{
+    /** @brief Size of a serialized LutEntry. */
+    static constexpr auto binarySize = size_t{24};
+
+    /** @brief The asset id from the entry's NcaHeader. */
+    size_t assetId = 0;
+
+    /** @brief Offset in bytes from the start of the package to the entry's NcaHeader. */
+    size_t offset = 0;
+
+    /** @brief Time the entry was last written, in seconds since the Unix epoch. */
+    int64_t lastUpdated = 0;
+};
+
+/**
+ * @brief Get the number of perfect hash buckets stored after a package's look up table.
+ * @note Each bucket holds four ids on average and is stored as a u32 seed.
+ */
+auto GetLutBucketCount(size_t assetCount) -> size_t;
+
+/**
+ * @brief Get the look up table slot for an asset id from a package's perfect hash seeds.
+ * @note Ids not in the package also map to a slot, so the entry's id must be checked.
+ */
+auto GetLutSlot(size_t assetId, std::span<const uint32_t> seeds, size_t assetCount) -> size_t;
+
+/**
+ * @brief Build a minimal perfect hash over look up table entries.
+ * @param entries The entries to hash, which are reordered so each entry is in its slot.
+ * @return The seed for each bucket. Throws if the entries contain duplicate ids.
+ */
+auto BuildLutHash(std::span<LutEntry> entries) -> std::vector<uint32_t>;
+
+/** @brief Serialize an NcpHeader to a stream. */
+void Serialize(std::ostream& stream, const NcpHeader& header);
+
+/** @brief Deserialize an NcpHeader from a stream. */
+void Deserialize(std::istream& stream, NcpHeader& header);
+
+/** @brief Serialize a LutEntry to a stream. */
+void Serialize(std::ostream& stream, const LutEntry& entry);
+
+/** @brief Deserialize a LutEntry from a stream. */
+void Deserialize(std::istream& stream, LutEntry& entry);
+} // namespace nc::asset
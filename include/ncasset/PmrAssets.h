@@ -0,0 +1,156 @@
+#pragma once
+
+#include "Assets.h"
+
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Allocator-aware variants of the asset types in Assets.h. Every container in
+ * a pmr asset, including nested strings and bone data, is allocated from the
+ * memory resource the asset was constructed or imported with. Assets imported
+ * into a monotonic arena can be released all at once by releasing the arena.
+ */
+namespace nc::asset::pmr
+{
+struct AudioClip
+{
+    AudioClip() : AudioClip(std::pmr::get_default_resource()) {}
+
+    explicit AudioClip(std::pmr::memory_resource* resource)
+        : leftChannel{resource}, rightChannel{resource} {}
+
+    size_t samplesPerChannel = 0;
+    std::pmr::vector<double> leftChannel;
+    std::pmr::vector<double> rightChannel;
+};
+
+struct VertexSpaceToBoneSpace
+{
+    VertexSpaceToBoneSpace() : VertexSpaceToBoneSpace(std::pmr::get_default_resource()) {}
+
+    explicit VertexSpaceToBoneSpace(std::pmr::memory_resource* resource)
+        : boneName{resource} {}
+
+    std::pmr::string boneName;
+    DirectX::XMMATRIX transformationMatrix;
+};
+
+struct BoneSpaceToParentSpace
+{
+    BoneSpaceToParentSpace() : BoneSpaceToParentSpace(std::pmr::get_default_resource()) {}
+
+    explicit BoneSpaceToParentSpace(std::pmr::memory_resource* resource)
+        : boneName{resource} {}
+
+    std::pmr::string boneName;
+    DirectX::XMMATRIX transformationMatrix;
+    uint32_t numChildren = 0;
+    uint32_t indexOfFirstChild = 0;
+};
+
+struct BonesData
+{
+    BonesData() : BonesData(std::pmr::get_default_resource()) {}
+
+    explicit BonesData(std::pmr::memory_resource* resource)
+        : boneMapping{resource}, vertexSpaceToBoneSpace{resource}, boneSpaceToParentSpace{resource} {}
+
+    std::pmr::unordered_map<std::pmr::string, uint32_t> boneMapping;
+    std::pmr::vector<VertexSpaceToBoneSpace> vertexSpaceToBoneSpace;
+    std::pmr::vector<BoneSpaceToParentSpace> boneSpaceToParentSpace;
+};
+
+struct HullCollider
+{
+    HullCollider() : HullCollider(std::pmr::get_default_resource()) {}
+
+    explicit HullCollider(std::pmr::memory_resource* resource)
+        : vertices{resource} {}
+
+    Vector3 extents;
+    float maxExtent = 0.0f;
+    std::pmr::vector<Vector3> vertices;
+};
+
+struct ConcaveCollider
+{
+    ConcaveCollider() : ConcaveCollider(std::pmr::get_default_resource()) {}
+
+    explicit ConcaveCollider(std::pmr::memory_resource* resource)
+        : triangles{resource} {}
+
+    Vector3 extents;
+    float maxExtent = 0.0f;
+    std::pmr::vector<Triangle> triangles;
+};
+
+struct Mesh
+{
+    Mesh() : Mesh(std::pmr::get_default_resource()) {}
+
+    explicit Mesh(std::pmr::memory_resource* resource)
+        : vertices{resource}, indices{resource} {}
+
+    Vector3 extents;
+    float maxExtent = 0.0f;
+    std::pmr::vector<MeshVertex> vertices;
+    std::pmr::vector<uint32_t> indices;
+    std::optional<BonesData> bonesData;
+};
+
+struct SkeletalAnimationFrames
+{
+    SkeletalAnimationFrames() : SkeletalAnimationFrames(std::pmr::get_default_resource()) {}
+
+    explicit SkeletalAnimationFrames(std::pmr::memory_resource* resource)
+        : positionFrames{resource}, rotationFrames{resource}, scaleFrames{resource} {}
+
+    std::pmr::vector<PositionFrame> positionFrames;
+    std::pmr::vector<RotationFrame> rotationFrames;
+    std::pmr::vector<ScaleFrame> scaleFrames;
+};
+
+struct SkeletalAnimation
+{
+    SkeletalAnimation() : SkeletalAnimation(std::pmr::get_default_resource()) {}
+
+    explicit SkeletalAnimation(std::pmr::memory_resource* resource)
+        : name{resource}, framesPerBone{resource} {}
+
+    std::pmr::string name;
+    uint32_t durationInTicks = 0;
+    float ticksPerSecond = 0.0f;
+    std::pmr::unordered_map<std::pmr::string, SkeletalAnimationFrames> framesPerBone;
+};
+
+struct Texture
+{
+    static constexpr uint32_t numChannels = nc::asset::Texture::numChannels;
+
+    Texture() : Texture(std::pmr::get_default_resource()) {}
+
+    explicit Texture(std::pmr::memory_resource* resource)
+        : pixelData{resource} {}
+
+    uint32_t width = 0;
+    uint32_t height = 0;
+    std::pmr::vector<unsigned char> pixelData;
+};
+
+struct CubeMap
+{
+    static constexpr uint32_t numChannels = nc::asset::CubeMap::numChannels;
+
+    CubeMap() : CubeMap(std::pmr::get_default_resource()) {}
+
+    explicit CubeMap(std::pmr::memory_resource* resource)
+        : pixelData{resource} {}
+
+    uint32_t faceSideLength = 0;
+    std::pmr::vector<unsigned char> pixelData;
+};
+} // namespace nc::asset::pmr
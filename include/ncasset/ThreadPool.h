@@ -0,0 +1,43 @@
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace nc::asset
+{
+/** @brief A fixed-size pool of worker threads for running asset jobs. */
+class ThreadPool
+{
+    public:
+        /** @brief Start a pool. A thread count of zero uses one thread per hardware thread. */
+        explicit ThreadPool(size_t threadCount = 0);
+
+        /** @brief Finish all submitted jobs and join the workers. */
+        ~ThreadPool() noexcept;
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        /** @brief Queue a job to run on a worker thread. Jobs must not throw. */
+        void Submit(std::function<void()> job);
+
+        /** @brief Get the number of worker threads. */
+        auto GetThreadCount() const noexcept -> size_t
+        {
+            return m_workers.size();
+        }
+
+    private:
+        std::vector<std::thread> m_workers;
+        std::queue<std::function<void()>> m_jobs;
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        bool m_stopping = false;
+
+        void Run();
+};
+} // namespace nc::asset
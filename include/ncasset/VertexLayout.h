@@ -0,0 +1,104 @@
+#pragma once
+
+#include "Assets.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+namespace nc::asset
+{
+/** @brief A MeshVertex member that can be written to a vertex stream. */
+enum class VertexAttribute : uint8_t
+{
+    Position,
+    Normal,
+    Uv,
+    Tangent,
+    Bitangent,
+    BoneWeights,
+    BoneIds
+};
+
+/**
+ * @brief The encoding of an attribute within a vertex stream.
+ * @note Normalized formats clamp to their range and round to nearest. Components the attribute
+ *       does not have are written as zero. BoneIds must use a Uint format, and every other
+ *       attribute must use a Float, Snorm, or Unorm format.
+ */
+enum class VertexFormat : uint8_t
+{
+    Float32x2,
+    Float32x3,
+    Float32x4,
+    Float16x2,
+    Float16x4,
+    Snorm16x4,
+    Snorm8x4,
+    Unorm8x4,
+    Uint32x4,
+    Uint16x4,
+    Uint8x4
+};
+
+/** @brief Places one attribute at an offset within each vertex of a stream. */
+struct VertexElement
+{
+    VertexAttribute attribute;
+    VertexFormat format;
+    uint32_t stream = 0;
+    uint32_t offset = 0;
+};
+
+/**
+ * @brief Describes how vertices are written to one or more streams.
+ * @note Stream i holds a vertex every strides[i] bytes. An interleaved layout has a single
+ *       stream, while a split layout gives attributes their own streams.
+ */
+struct VertexLayout
+{
+    std::vector<VertexElement> elements;
+    std::vector<uint32_t> strides;
+};
+
+/** @brief An attribute and format for building a tightly packed layout. */
+struct VertexAttributeFormat
+{
+    VertexAttribute attribute;
+    VertexFormat format;
+};
+
+/**
+ * @brief Provides the destination for a vertex stream, given its index and required size in bytes.
+ * @note The returned span must be at least the requested size and outlive the import.
+ */
+using VertexStreamAllocator = std::function<std::span<std::byte>(size_t stream, size_t size)>;
+
+/** @brief Get the size in bytes of one attribute written in a format. */
+auto GetVertexFormatSize(VertexFormat format) noexcept -> uint32_t;
+
+/** @brief Build a layout with every attribute packed, in order, into a single stream. */
+auto MakeInterleavedLayout(const std::vector<VertexAttributeFormat>& attributes) -> VertexLayout;
+
+/** @brief Build a layout with each attribute packed into its own stream, in order. */
+auto MakeSplitLayout(const std::vector<VertexAttributeFormat>& attributes) -> VertexLayout;
+
+/** @brief Throw if a layout has elements outside their stream, overlapping elements, or unsupported formats. */
+void ValidateVertexLayout(const VertexLayout& layout);
+
+/** @brief Get the number of bytes a stream needs to hold a number of vertices. */
+auto GetVertexStreamSize(const VertexLayout& layout, size_t stream, size_t vertexCount) -> size_t;
+
+/**
+ * @brief Convert vertices into the streams described by a layout.
+ * @param firstVertex The index in each stream at which to write the first vertex.
+ * @note On x86, conversions to float, half, and normalized formats run four components at a time
+ *       with SSE2. The layout is validated, and each stream must have room for every vertex written.
+ */
+void ConvertVertices(std::span<const MeshVertex> vertices,
+                     const VertexLayout& layout,
+                     std::span<const std::span<std::byte>> streams,
+                     size_t firstVertex = 0);
+} // namespace nc::asset
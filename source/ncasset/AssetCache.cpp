@@ -0,0 +1,244 @@
+#include "AssetCache.h"
+#include "Deserialize.h"
+#include "ncasset/Assets.h"
+
+#include "ncutility/BinarySerialization.h"
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <fstream>
+#include <string_view>
+#include <utility>
+
+namespace
+{
+/** An imported asset, the bytes it is charged, and its header. */
+template<class T>
+struct LoadedAsset
+{
+    std::shared_ptr<const T> asset;
+    size_t size;
+    nc::asset::NcaHeader header;
+};
+
+/** Get the uncompressed size of the blob following a header, leaving the stream where it was. */
+auto GetUncompressedSize(std::istream& stream, const nc::asset::NcaHeader& header) -> size_t
+{
+    if (std::string_view{header.compressionAlgorithm} == nc::asset::CompressionAlgorithm::none)
+    {
+        return header.size;
+    }
+
+    // Compressed blobs begin with their chunk table, led by the uncompressed size.
+    const auto start = stream.tellg();
+    auto size = uint64_t{};
+    nc::serialize::Deserialize(stream, size);
+    stream.seekg(start);
+    return static_cast<size_t>(size);
+}
+
+/** Import an asset from a stream positioned at its NcaHeader. */
+template<class T>
+auto Load(std::istream& stream) -> LoadedAsset<T>
+{
+    const auto start = stream.tellg();
+    const auto header = nc::asset::DeserializeHeader(stream);
+    if (!stream)
+    {
+        throw nc::NcError("Unexpected end of asset data");
+    }
+
+    const auto size = ::GetUncompressedSize(stream, header);
+    stream.seekg(start);
+
+    auto asset = std::make_shared<T>();
+    nc::asset::DeserializeAsset(stream, *asset);
+    return LoadedAsset<T>{std::move(asset), size, header};
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+AssetCache::AssetCache(size_t byteBudget)
+    : m_byteBudget{byteBudget}
+{
+}
+
+template<class T>
+auto AssetCache::Get(const AssetPackage& package, size_t assetId) -> AssetHandle<T>
+{
+    return std::static_pointer_cast<const T>(Acquire(assetId, typeid(T), [&package, assetId]()
+    {
+        auto loaded = package.Read(assetId, [](std::istream& stream) { return ::Load<T>(stream); });
+        package.ValidateHeader(assetId, loaded.header);
+
+        return Entry{assetId, typeid(T), std::move(loaded.asset), loaded.size};
+    }));
+}
+
+template<class T>
+auto AssetCache::Get(const std::filesystem::path& ncaPath) -> AssetHandle<T>
+{
+    auto file = OpenNca(ncaPath);
+    const auto assetId = DeserializeHeader(file).assetId;
+    if (!file)
+    {
+        throw NcError("Unexpected end of asset data: ", ncaPath.string());
+    }
+
+    return std::static_pointer_cast<const T>(Acquire(assetId, typeid(T), [&file, assetId]()
+    {
+        file.seekg(0);
+        auto loaded = ::Load<T>(file);
+        return Entry{assetId, typeid(T), std::move(loaded.asset), loaded.size};
+    }));
+}
+
+auto AssetCache::Contains(size_t assetId) const -> bool
+{
+    auto lock = std::lock_guard{m_mutex};
+    return m_lookup.contains(assetId);
+}
+
+auto AssetCache::Erase(size_t assetId) -> bool
+{
+    auto lock = std::lock_guard{m_mutex};
+    const auto pos = m_lookup.find(assetId);
+    if (pos == m_lookup.end())
+    {
+        return false;
+    }
+
+    m_stats.bytes -= pos->second->size;
+    m_entries.erase(pos->second);
+    m_lookup.erase(pos);
+    return true;
+}
+
+void AssetCache::Clear()
+{
+    auto lock = std::lock_guard{m_mutex};
+    m_entries.clear();
+    m_lookup.clear();
+    m_stats.bytes = 0;
+}
+
+void AssetCache::SetByteBudget(size_t byteBudget)
+{
+    auto lock = std::lock_guard{m_mutex};
+    m_byteBudget = byteBudget;
+    EvictToBudget();
+}
+
+auto AssetCache::GetByteBudget() const -> size_t
+{
+    auto lock = std::lock_guard{m_mutex};
+    return m_byteBudget;
+}
+
+auto AssetCache::GetStats() const -> AssetCacheStats
+{
+    auto lock = std::lock_guard{m_mutex};
+    auto stats = m_stats;
+    stats.entries = m_entries.size();
+    return stats;
+}
+
+auto AssetCache::Acquire(size_t assetId, std::type_index type, const std::function<Entry()>& load) -> std::shared_ptr<const void>
+{
+    const auto checkType = [assetId, type](const Entry& entry)
+    {
+        if (entry.type != type)
+        {
+            throw NcError(fmt::format("Asset '{}' is cached as a different asset type", assetId));
+        }
+
+        return entry.asset;
+    };
+
+    auto lock = std::unique_lock{m_mutex};
+    if (const auto pos = m_lookup.find(assetId); pos != m_lookup.end())
+    {
+        ++m_stats.hits;
+        m_entries.splice(m_entries.begin(), m_entries, pos->second);
+        return checkType(*pos->second);
+    }
+
+    if (const auto pos = m_loading.find(assetId); pos != m_loading.end())
+    {
+        ++m_stats.hits;
+        auto loading = pos->second;
+        lock.unlock();
+        return checkType(loading.get());
+    }
+
+    ++m_stats.misses;
+    auto promise = std::promise<Entry>{};
+    m_loading.emplace(assetId, promise.get_future().share());
+    lock.unlock();
+
+    auto entry = Entry{assetId, type, nullptr, 0};
+    try
+    {
+        entry = load();
+    }
+    catch (...)
+    {
+        lock.lock();
+        m_loading.erase(assetId);
+        lock.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+
+    lock.lock();
+    m_loading.erase(assetId);
+    Insert(entry);
+    lock.unlock();
+    promise.set_value(entry);
+    return entry.asset;
+}
+
+void AssetCache::Insert(Entry entry)
+{
+    // Assets larger than the whole budget are returned without being cached.
+    if (entry.size > m_byteBudget)
+    {
+        ++m_stats.evictions;
+        return;
+    }
+
+    m_stats.bytes += entry.size;
+    m_entries.push_front(std::move(entry));
+    m_lookup.emplace(m_entries.front().assetId, m_entries.begin());
+    EvictToBudget();
+}
+
+void AssetCache::EvictToBudget()
+{
+    while (m_stats.bytes > m_byteBudget)
+    {
+        const auto& oldest = m_entries.back();
+        m_stats.bytes -= oldest.size;
+        m_lookup.erase(oldest.assetId);
+        m_entries.pop_back();
+        ++m_stats.evictions;
+    }
+}
+
+template auto AssetCache::Get<AudioClip>(const AssetPackage&, size_t) -> AssetHandle<AudioClip>;
+template auto AssetCache::Get<ConcaveCollider>(const AssetPackage&, size_t) -> AssetHandle<ConcaveCollider>;
+template auto AssetCache::Get<CubeMap>(const AssetPackage&, size_t) -> AssetHandle<CubeMap>;
+template auto AssetCache::Get<HullCollider>(const AssetPackage&, size_t) -> AssetHandle<HullCollider>;
+template auto AssetCache::Get<Mesh>(const AssetPackage&, size_t) -> AssetHandle<Mesh>;
+template auto AssetCache::Get<SkeletalAnimation>(const AssetPackage&, size_t) -> AssetHandle<SkeletalAnimation>;
+template auto AssetCache::Get<Texture>(const AssetPackage&, size_t) -> AssetHandle<Texture>;
+
+template auto AssetCache::Get<AudioClip>(const std::filesystem::path&) -> AssetHandle<AudioClip>;
+template auto AssetCache::Get<ConcaveCollider>(const std::filesystem::path&) -> AssetHandle<ConcaveCollider>;
+template auto AssetCache::Get<CubeMap>(const std::filesystem::path&) -> AssetHandle<CubeMap>;
+template auto AssetCache::Get<HullCollider>(const std::filesystem::path&) -> AssetHandle<HullCollider>;
+template auto AssetCache::Get<Mesh>(const std::filesystem::path&) -> AssetHandle<Mesh>;
+template auto AssetCache::Get<SkeletalAnimation>(const std::filesystem::path&) -> AssetHandle<SkeletalAnimation>;
+template auto AssetCache::Get<Texture>(const std::filesystem::path&) -> AssetHandle<Texture>;
+} // namespace nc::asset
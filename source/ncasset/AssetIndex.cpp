@@ -0,0 +1,225 @@
+#include "AssetIndex.h"
+#include "Import.h"
+#include "ThreadPool.h"
+
+#include "ncutility/BinarySerialization.h"
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <latch>
+#include <mutex>
+
+namespace
+{
+constexpr auto indexMagicNumber = std::string_view{"NCIX"};
+constexpr auto indexVersion = uint32_t{1};
+
+// Files are handed to workers in chunks to keep queueing overhead low for large trees.
+constexpr auto filesPerJob = size_t{256};
+
+auto GetLastWriteTime(const std::filesystem::directory_entry& file) -> int64_t
+{
+    return static_cast<int64_t>(file.last_write_time().time_since_epoch().count());
+}
+
+/** Stat a file and reuse its previous entry if unchanged, otherwise read its header. Returns true if read. */
+auto UpdateEntry(const std::filesystem::path& root,
+                 const std::filesystem::directory_entry& file,
+                 const nc::asset::AssetIndexEntry* previous,
+                 nc::asset::AssetIndexEntry& out) -> bool
+{
+    out.path = file.path().lexically_relative(root);
+    out.fileSize = static_cast<uint64_t>(file.file_size());
+    out.lastWriteTime = ::GetLastWriteTime(file);
+    if (previous && previous->fileSize == out.fileSize && previous->lastWriteTime == out.lastWriteTime)
+    {
+        out.header = previous->header;
+        return false;
+    }
+
+    out.header = nc::asset::ImportNcaHeader(file.path());
+    return true;
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+AssetIndex::AssetIndex(std::filesystem::path root)
+    : m_root{std::move(root)}
+{
+}
+
+auto AssetIndex::Load(const std::filesystem::path& indexPath) -> bool
+{
+    m_entries.clear();
+    m_lookup.clear();
+
+    auto file = std::ifstream{indexPath, std::ios::binary};
+    if (!file.is_open())
+    {
+        return false;
+    }
+
+    char magic[4] = {};
+    auto version = uint32_t{};
+    auto count = uint64_t{};
+    file.read(magic, 4);
+    nc::serialize::Deserialize(file, version);
+    nc::serialize::Deserialize(file, count);
+    if (!file || std::string_view{magic, 4} != indexMagicNumber || version != indexVersion)
+    {
+        return false;
+    }
+
+    auto entries = std::vector<AssetIndexEntry>{};
+    auto pathString = std::string{};
+    for (auto i = uint64_t{0}; i < count; ++i)
+    {
+        auto& entry = entries.emplace_back();
+        nc::serialize::Deserialize(file, pathString);
+        Deserialize(file, entry.header);
+        nc::serialize::Deserialize(file, entry.fileSize);
+        nc::serialize::Deserialize(file, entry.lastWriteTime);
+        if (!file)
+        {
+            return false;
+        }
+
+        entry.path = std::filesystem::path{pathString};
+    }
+
+    m_entries = std::move(entries);
+    RebuildLookup();
+    return true;
+}
+
+void AssetIndex::Save(const std::filesystem::path& indexPath) const
+{
+    auto file = std::ofstream{indexPath, std::ios::binary | std::ios::trunc};
+    if (!file.is_open())
+    {
+        throw NcError("Could not open index file: ", indexPath.string());
+    }
+
+    file.write(indexMagicNumber.data(), 4);
+    nc::serialize::Serialize(file, indexVersion);
+    nc::serialize::Serialize(file, static_cast<uint64_t>(m_entries.size()));
+    for (const auto& entry : m_entries)
+    {
+        nc::serialize::Serialize(file, entry.path.generic_string());
+        Serialize(file, entry.header);
+        nc::serialize::Serialize(file, entry.fileSize);
+        nc::serialize::Serialize(file, entry.lastWriteTime);
+    }
+
+    if (!file)
+    {
+        throw NcError("Failed writing index file: ", indexPath.string());
+    }
+}
+
+auto AssetIndex::Refresh(ThreadPool& pool) -> size_t
+{
+    if (!std::filesystem::is_directory(m_root))
+    {
+        throw NcError("Asset index root is not a directory: ", m_root.string());
+    }
+
+    auto files = std::vector<std::filesystem::directory_entry>{};
+    for (const auto& file : std::filesystem::recursive_directory_iterator{m_root})
+    {
+        if (file.is_regular_file() && file.path().extension() == ".nca")
+        {
+            files.push_back(file);
+        }
+    }
+
+    auto previous = std::unordered_map<std::string, const AssetIndexEntry*>{};
+    previous.reserve(m_entries.size());
+    for (const auto& entry : m_entries)
+    {
+        previous.emplace(entry.path.generic_string(), &entry);
+    }
+
+    auto updated = std::vector<AssetIndexEntry>(files.size());
+    auto readCount = std::atomic<size_t>{0};
+    auto errorMutex = std::mutex{};
+    auto error = std::exception_ptr{};
+    const auto jobCount = (files.size() + filesPerJob - 1) / filesPerJob;
+    auto done = std::latch{static_cast<std::ptrdiff_t>(jobCount)};
+    for (auto job = size_t{0}; job < jobCount; ++job)
+    {
+        pool.Submit([&, job]()
+        {
+            const auto end = std::min(files.size(), (job + 1) * filesPerJob);
+            for (auto i = job * filesPerJob; i < end; ++i)
+            {
+                try
+                {
+                    const auto relative = files[i].path().lexically_relative(m_root).generic_string();
+                    const auto pos = previous.find(relative);
+                    const auto* old = pos == previous.cend() ? nullptr : pos->second;
+                    if (::UpdateEntry(m_root, files[i], old, updated[i]))
+                    {
+                        ++readCount;
+                    }
+                }
+                catch (...)
+                {
+                    auto lock = std::lock_guard{errorMutex};
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+            }
+
+            done.count_down();
+        });
+    }
+
+    done.wait();
+    if (error)
+    {
+        std::rethrow_exception(error);
+    }
+
+    std::ranges::sort(updated, {}, [](const AssetIndexEntry& entry) { return entry.path.generic_string(); });
+    m_entries = std::move(updated);
+    RebuildLookup();
+    return readCount.load();
+}
+
+auto AssetIndex::Find(size_t assetId) const -> const AssetIndexEntry*
+{
+    const auto pos = m_lookup.find(assetId);
+    return pos == m_lookup.cend() ? nullptr : &m_entries[pos->second];
+}
+
+auto AssetIndex::GetPath(size_t assetId) const -> std::filesystem::path
+{
+    const auto entry = Find(assetId);
+    if (!entry)
+    {
+        throw NcError(fmt::format("Asset '{}' is not in the index for: {}", assetId, m_root.string()));
+    }
+
+    return m_root / entry->path;
+}
+
+void AssetIndex::RebuildLookup()
+{
+    m_lookup.clear();
+    m_lookup.reserve(m_entries.size());
+    for (auto i = size_t{0}; i < m_entries.size(); ++i)
+    {
+        // Entries are sorted, so duplicate ids consistently resolve to the first path.
+        m_lookup.emplace(m_entries[i].header.assetId, i);
+    }
+}
+} // namespace nc::asset
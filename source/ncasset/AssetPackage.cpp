@@ -0,0 +1,164 @@
+#include "AssetPackage.h"
+#include "Decompress.h"
+#include "Dictionary.h"
+#include "LoadTraceRecorder.h"
+#include "NcaHeader.h"
+
+#include "ncutility/BinarySerialization.h"
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <type_traits>
+
+namespace
+{
+static_assert(sizeof(nc::asset::LutEntry) == nc::asset::LutEntry::binarySize);
+static_assert(std::is_trivially_copyable_v<nc::asset::LutEntry>);
+
+void ValidateHeader(const nc::asset::NcpHeader& header, const std::filesystem::path& path, uintmax_t fileSize)
+{
+    if (std::string_view{header.magicNumber} != nc::asset::NcpHeader::packageMagicNumber)
+    {
+        throw nc::NcError("Not an asset package: ", path.string());
+    }
+
+    if (std::string_view{header.version} != nc::asset::NcpHeader::currentVersion)
+    {
+        throw nc::NcError(fmt::format(
+            "Unsupported package version '{}' expected '{}': {}",
+            header.version, nc::asset::NcpHeader::currentVersion, path.string()
+        ));
+    }
+
+    const auto maxEntries = (fileSize - nc::asset::NcpHeader::binarySize) / nc::asset::LutEntry::binarySize;
+    const auto tableSize = nc::asset::NcpHeader::binarySize
+                         + header.assetCount * nc::asset::LutEntry::binarySize
+                         + nc::asset::GetLutBucketCount(header.assetCount) * sizeof(uint32_t);
+    if (header.assetCount > maxEntries || tableSize > fileSize)
+    {
+        throw nc::NcError("Package look up table exceeds file size: ", path.string());
+    }
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+AssetPackage::AssetPackage(const std::filesystem::path& ncpPath)
+    : m_path{ncpPath}
+{
+    if (!std::filesystem::is_regular_file(m_path))
+    {
+        throw NcError("File does not exist: ", m_path.string());
+    }
+
+    const auto fileSize = std::filesystem::file_size(m_path);
+    if (fileSize < NcpHeader::binarySize)
+    {
+        throw NcError("Not an asset package: ", m_path.string());
+    }
+
+    m_file.open(m_path, std::ios::binary);
+    if (!m_file.is_open())
+    {
+        throw NcError("Could not open file: ", m_path.string());
+    }
+
+    nc::serialize::Deserialize(m_file, m_header);
+    ::ValidateHeader(m_header, m_path, fileSize);
+
+    // Entries and hash seeds are stored without padding, so each can be read in one pass.
+    m_entries.resize(m_header.assetCount);
+    m_seeds.resize(GetLutBucketCount(m_header.assetCount));
+    m_file.read(reinterpret_cast<char*>(m_entries.data()), static_cast<std::streamsize>(m_entries.size() * sizeof(LutEntry)));
+    m_file.read(reinterpret_cast<char*>(m_seeds.data()), static_cast<std::streamsize>(m_seeds.size() * sizeof(uint32_t)));
+    if (!m_file)
+    {
+        throw NcError("Failed reading package look up table: ", m_path.string());
+    }
+
+    // An entry outside its hash slot could never be found, and also catches duplicate ids.
+    for (auto i = size_t{0}; i < m_entries.size(); ++i)
+    {
+        const auto& entry = m_entries[i];
+        if (entry.offset >= fileSize)
+        {
+            throw NcError(fmt::format("Asset '{}' offset is past the end of package: {}", entry.assetId, m_path.string()));
+        }
+
+        if (GetLutSlot(entry.assetId, m_seeds, m_entries.size()) != i)
+        {
+            throw NcError(fmt::format("Asset '{}' is not in its look up table slot: {}", entry.assetId, m_path.string()));
+        }
+    }
+
+    // Without zstd support, dictionary entries are left unread and only zstd assets fail to import.
+    if (IsSupportedCompression(CompressionAlgorithm::zstd))
+    {
+        for (const auto& entry : m_entries)
+        {
+            if (IsDictionaryAssetId(entry.assetId))
+            {
+                RegisterDictionary(SeekTo(entry));
+            }
+        }
+    }
+}
+
+auto AssetPackage::Contains(size_t assetId) const -> bool
+{
+    return Find(assetId) != nullptr;
+}
+
+auto AssetPackage::GetEntry(size_t assetId) const -> const LutEntry&
+{
+    const auto* entry = Find(assetId);
+    if (!entry)
+    {
+        throw NcError(fmt::format("Asset '{}' not found in package: {}", assetId, m_path.string()));
+    }
+
+    RecordLoad(assetId);
+    return *entry;
+}
+
+void AssetPackage::ValidateHeader(size_t assetId, const NcaHeader& header) const
+{
+    if (assetId == header.assetId)
+    {
+        return;
+    }
+
+    const auto* entry = Find(assetId);
+    const auto* headerEntry = Find(header.assetId);
+    if (!entry || !headerEntry || entry->offset != headerEntry->offset)
+    {
+        throw NcError(fmt::format(
+            "Asset id mismatch in package actual: '{}' expected: '{}'",
+            header.assetId, assetId
+        ));
+    }
+}
+
+auto AssetPackage::Find(size_t assetId) const noexcept -> const LutEntry*
+{
+    if (m_entries.empty())
+    {
+        return nullptr;
+    }
+
+    const auto& entry = m_entries[GetLutSlot(assetId, m_seeds, m_entries.size())];
+    return entry.assetId == assetId ? &entry : nullptr;
+}
+
+auto AssetPackage::SeekTo(const LutEntry& entry) const -> std::istream&
+{
+    m_file.clear();
+    m_file.seekg(static_cast<std::streamoff>(entry.offset));
+    if (!m_file)
+    {
+        throw NcError(fmt::format("Failed seeking to asset '{}' in package: {}", entry.assetId, m_path.string()));
+    }
+
+    return m_file;
+}
+} // namespace nc::asset
@@ -0,0 +1,493 @@
+#include "AssetWatcher.h"
+#include "AssetPackage.h"
+#include "Deserialize.h"
+
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <fstream>
+#include <optional>
+#include <utility>
+
+#if defined(__linux__) && __has_include(<sys/inotify.h>)
+#define NC_ASSET_INOTIFY
+#endif
+
+#ifdef NC_ASSET_INOTIFY
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+constexpr auto ncaExtension = std::string_view{".nca"};
+
+struct FileStatus
+{
+    uint64_t size;
+    int64_t lastWriteTime;
+};
+
+auto GetFileStatus(const std::filesystem::path& path) -> std::optional<FileStatus>
+{
+    auto ec = std::error_code{};
+    if (!std::filesystem::is_regular_file(path, ec))
+    {
+        return std::nullopt;
+    }
+
+    const auto size = std::filesystem::file_size(path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    const auto lastWriteTime = std::filesystem::last_write_time(path, ec);
+    if (ec)
+    {
+        return std::nullopt;
+    }
+
+    return FileStatus{static_cast<uint64_t>(size), static_cast<int64_t>(lastWriteTime.time_since_epoch().count())};
+}
+
+/** Read an .nca file's header, or nullopt if the file is unreadable or not yet fully written. */
+auto ReadHeader(const std::filesystem::path& path, uint64_t fileSize) -> std::optional<nc::asset::NcaHeader>
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    if (!file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    const auto header = nc::asset::DeserializeHeader(file);
+    if (!file || nc::asset::NcaHeader::binarySize + header.size != fileSize)
+    {
+        return std::nullopt;
+    }
+
+    return header;
+}
+
+auto Normalize(const std::filesystem::path& path) -> std::filesystem::path
+{
+    return std::filesystem::absolute(path).lexically_normal();
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+#ifdef NC_ASSET_INOTIFY
+/**
+ * Watches directories for files being written, moved, or deleted. Directories that could not be
+ * watched, or whose watch was lost, are kept until Rewatch() succeeds, and are polled until then.
+ */
+class AssetWatcher::Inotify
+{
+    public:
+        /** Create a non-blocking inotify instance, or null if inotify is unavailable. */
+        static auto Create() -> std::unique_ptr<Inotify>
+        {
+            const auto fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+            if (fd < 0)
+            {
+                return nullptr;
+            }
+
+            return std::unique_ptr<Inotify>{new Inotify{fd}};
+        }
+
+        ~Inotify() noexcept
+        {
+            ::close(m_fd);
+        }
+
+        /** Watch a directory, or leave it to be polled if the watch can't be added, such as when the watch limit is reached. */
+        void Watch(const std::filesystem::path& directory)
+        {
+            if (!TryWatch(directory) && std::find(m_unwatched.cbegin(), m_unwatched.cend(), directory) == m_unwatched.cend())
+            {
+                m_unwatched.push_back(directory);
+            }
+        }
+
+        /** Retry watching directories that are being polled. */
+        void Rewatch()
+        {
+            std::erase_if(m_unwatched, [this](const std::filesystem::path& directory) { return TryWatch(directory); });
+        }
+
+        auto HasUnwatched() const noexcept -> bool
+        {
+            return !m_unwatched.empty();
+        }
+
+        /**
+         * Drain pending events, returning the paths they name, or nullopt if everything must be rescanned
+         * because the kernel dropped events or a watched directory was deleted or moved.
+         */
+        auto ReadChanges() -> std::optional<std::vector<std::filesystem::path>>
+        {
+            alignas(inotify_event) auto buffer = std::array<char, 16 * 1024>{};
+            auto changed = std::vector<std::filesystem::path>{};
+            auto needsScan = false;
+            while (true)
+            {
+                const auto count = ::read(m_fd, buffer.data(), buffer.size());
+                if (count < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+
+                if (count <= 0)
+                {
+                    break;
+                }
+
+                for (auto offset = size_t{0}; offset < static_cast<size_t>(count);)
+                {
+                    auto event = inotify_event{};
+                    std::memcpy(&event, buffer.data() + offset, sizeof(inotify_event));
+                    const auto* name = buffer.data() + offset + sizeof(inotify_event);
+                    offset += sizeof(inotify_event) + event.len;
+                    const auto pos = m_directories.find(event.wd);
+                    if (event.mask & IN_Q_OVERFLOW)
+                    {
+                        needsScan = true;
+                    }
+                    else if (pos != m_directories.end() && (event.mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED)))
+                    {
+                        // A moved directory keeps its watch, which would report its new contents under the old path.
+                        if (event.mask & IN_MOVE_SELF)
+                        {
+                            ::inotify_rm_watch(m_fd, event.wd);
+                        }
+
+                        m_unwatched.push_back(pos->second);
+                        m_directories.erase(pos);
+                        needsScan = true;
+                    }
+                    else if (pos != m_directories.end() && event.len != 0)
+                    {
+                        changed.push_back(pos->second / name);
+                    }
+                }
+            }
+
+            if (needsScan)
+            {
+                return std::nullopt;
+            }
+
+            return changed;
+        }
+
+    private:
+        int m_fd;
+        std::unordered_map<int, std::filesystem::path> m_directories;
+        std::vector<std::filesystem::path> m_unwatched;
+
+        explicit Inotify(int fd)
+            : m_fd{fd}
+        {
+        }
+
+        auto TryWatch(const std::filesystem::path& directory) -> bool
+        {
+            constexpr auto mask = IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+            const auto wd = ::inotify_add_watch(m_fd, directory.c_str(), mask);
+            if (wd < 0)
+            {
+                return false;
+            }
+
+            m_directories.insert_or_assign(wd, directory);
+            return true;
+        }
+};
+#else
+class AssetWatcher::Inotify
+{
+    public:
+        void Watch(const std::filesystem::path&)
+        {
+        }
+
+        void Rewatch()
+        {
+        }
+
+        auto HasUnwatched() const noexcept -> bool
+        {
+            return false;
+        }
+
+        auto ReadChanges() -> std::optional<std::vector<std::filesystem::path>>
+        {
+            return std::vector<std::filesystem::path>{};
+        }
+};
+#endif
+
+AssetWatcher::AssetWatcher(AssetWatchMode mode, std::chrono::milliseconds pollInterval)
+    : m_pollInterval{pollInterval},
+      m_lastScan{std::chrono::steady_clock::now()}
+{
+#ifdef NC_ASSET_INOTIFY
+    if (mode == AssetWatchMode::Automatic)
+    {
+        m_inotify = Inotify::Create();
+    }
+#else
+    (void)mode;
+#endif
+}
+
+AssetWatcher::~AssetWatcher() noexcept = default;
+
+void AssetWatcher::WatchDirectory(const std::filesystem::path& directory)
+{
+    if (!std::filesystem::is_directory(directory))
+    {
+        throw NcError("Directory does not exist: ", directory.string());
+    }
+
+    const auto normalized = ::Normalize(directory);
+    if (std::find(m_directories.cbegin(), m_directories.cend(), normalized) != m_directories.cend())
+    {
+        return;
+    }
+
+    // The watch is added before the initial scan, so files written in between are not missed.
+    if (m_inotify)
+    {
+        m_inotify->Watch(normalized);
+    }
+
+    m_directories.push_back(normalized);
+    ScanDirectory(normalized, [](const AssetChange&) {});
+}
+
+void AssetWatcher::WatchPackage(const std::filesystem::path& ncpPath)
+{
+    auto normalized = ::Normalize(ncpPath);
+    if (std::any_of(m_packages.cbegin(), m_packages.cend(), [&normalized](const auto& package) { return package.path == normalized; }))
+    {
+        return;
+    }
+
+    // Packages are replaced by renaming over them, so their directory is watched rather than the file.
+    const auto directory = normalized.parent_path();
+    if (!std::filesystem::is_directory(directory))
+    {
+        throw NcError("Directory does not exist: ", directory.string());
+    }
+
+    if (m_inotify)
+    {
+        m_inotify->Watch(directory);
+    }
+
+    auto& package = m_packages.emplace_back();
+    package.path = std::move(normalized);
+    RefreshPackage(package, [](const AssetChange&) {});
+}
+
+auto AssetWatcher::Poll(const AssetChangeCallback& onChange) -> size_t
+{
+    auto count = size_t{0};
+    const auto publish = [&count, &onChange](const AssetChange& change)
+    {
+        ++count;
+        onChange(change);
+    };
+
+    if (!m_inotify)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        if (now - m_lastScan >= m_pollInterval)
+        {
+            m_lastScan = now;
+            Scan(publish);
+        }
+
+        return count;
+    }
+
+    // Watches are restored before rescanning, so files written in between are not missed. Directories
+    // without a watch are rescanned along with everything else once per poll interval.
+    auto changed = m_inotify->ReadChanges();
+    const auto now = std::chrono::steady_clock::now();
+    if (!changed || (m_inotify->HasUnwatched() && now - m_lastScan >= m_pollInterval))
+    {
+        m_lastScan = now;
+        m_inotify->Rewatch();
+        Scan(publish);
+        return count;
+    }
+
+    // A file is often written and then renamed, so each path is only refreshed once per poll.
+    std::sort(changed->begin(), changed->end());
+    changed->erase(std::unique(changed->begin(), changed->end()), changed->end());
+    for (const auto& path : changed.value())
+    {
+        const auto package = std::find_if(m_packages.begin(), m_packages.end(), [&path](const auto& watched) { return watched.path == path; });
+        if (package != m_packages.end())
+        {
+            RefreshPackage(*package, publish);
+        }
+        else if (path.extension() == ncaExtension
+              && std::find(m_directories.cbegin(), m_directories.cend(), path.parent_path()) != m_directories.cend())
+        {
+            RefreshFile(path, publish);
+        }
+    }
+
+    return count;
+}
+
+auto AssetWatcher::IsUsingInotify() const noexcept -> bool
+{
+    return m_inotify != nullptr;
+}
+
+void AssetWatcher::Scan(const AssetChangeCallback& onChange)
+{
+    for (const auto& directory : m_directories)
+    {
+        ScanDirectory(directory, onChange);
+    }
+
+    for (auto& package : m_packages)
+    {
+        RefreshPackage(package, onChange);
+    }
+}
+
+void AssetWatcher::ScanDirectory(const std::filesystem::path& directory, const AssetChangeCallback& onChange)
+{
+    auto paths = std::vector<std::filesystem::path>{};
+    for (const auto& [path, file] : m_files)
+    {
+        if (std::filesystem::path{path}.parent_path() == directory)
+        {
+            paths.emplace_back(path);
+        }
+    }
+
+    auto ec = std::error_code{};
+    for (const auto& entry : std::filesystem::directory_iterator{directory, ec})
+    {
+        if (entry.path().extension() == ncaExtension && !m_files.contains(entry.path().string()))
+        {
+            paths.push_back(entry.path());
+        }
+    }
+
+    for (const auto& path : paths)
+    {
+        RefreshFile(path, onChange);
+    }
+}
+
+void AssetWatcher::RefreshFile(const std::filesystem::path& path, const AssetChangeCallback& onChange)
+{
+    const auto pos = m_files.find(path.string());
+    const auto status = ::GetFileStatus(path);
+    if (!status)
+    {
+        if (pos != m_files.end())
+        {
+            const auto assetId = pos->second.assetId;
+            m_files.erase(pos);
+            onChange(AssetChange{assetId, AssetChangeType::Removed, path});
+        }
+
+        return;
+    }
+
+    if (pos != m_files.end() && pos->second.fileSize == status->size && pos->second.lastWriteTime == status->lastWriteTime)
+    {
+        return;
+    }
+
+    const auto header = ::ReadHeader(path, status->size);
+    if (!header)
+    {
+        return;
+    }
+
+    const auto file = WatchedFile{header->assetId, status->size, status->lastWriteTime};
+    if (pos == m_files.end())
+    {
+        m_files.emplace(path.string(), file);
+        onChange(AssetChange{file.assetId, AssetChangeType::Added, path});
+        return;
+    }
+
+    const auto previousId = std::exchange(pos->second, file).assetId;
+    if (previousId == file.assetId)
+    {
+        onChange(AssetChange{file.assetId, AssetChangeType::Modified, path});
+        return;
+    }
+
+    onChange(AssetChange{previousId, AssetChangeType::Removed, path});
+    onChange(AssetChange{file.assetId, AssetChangeType::Added, path});
+}
+
+void AssetWatcher::RefreshPackage(WatchedPackage& package, const AssetChangeCallback& onChange)
+{
+    const auto status = ::GetFileStatus(package.path).value_or(FileStatus{0, 0});
+    if (status.size == package.fileSize && status.lastWriteTime == package.lastWriteTime)
+    {
+        return;
+    }
+
+    auto entries = std::unordered_map<size_t, int64_t>{};
+    if (status.size != 0)
+    {
+        // A package that fails to open is still being written, and is retried on a later poll.
+        try
+        {
+            const auto opened = AssetPackage{package.path};
+            for (const auto& entry : opened.GetEntries())
+            {
+                entries.emplace(entry.assetId, entry.lastUpdated);
+            }
+        }
+        catch (const std::exception&)
+        {
+            return;
+        }
+    }
+
+    for (const auto& [assetId, lastUpdated] : entries)
+    {
+        const auto previous = package.entries.find(assetId);
+        if (previous == package.entries.end())
+        {
+            onChange(AssetChange{assetId, AssetChangeType::Added, package.path});
+        }
+        else if (previous->second != lastUpdated)
+        {
+            onChange(AssetChange{assetId, AssetChangeType::Modified, package.path});
+        }
+    }
+
+    for (const auto& [assetId, lastUpdated] : package.entries)
+    {
+        if (!entries.contains(assetId))
+        {
+            onChange(AssetChange{assetId, AssetChangeType::Removed, package.path});
+        }
+    }
+
+    package.fileSize = status.size;
+    package.lastWriteTime = status.lastWriteTime;
+    package.entries = std::move(entries);
+}
+} // namespace nc::asset
@@ -0,0 +1,174 @@
+#include "BatchImport.h"
+#include "AssetPackage.h"
+#include "BulkReader.h"
+#include "Deserialize.h"
+#include "Import.h"
+#include "ThreadPool.h"
+
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <fstream>
+#include <memory>
+#include <span>
+
+namespace
+{
+/** Copy an asset's bytes out of the package so decoding does not hold the package lock. */
+auto ReadPackagedNca(const nc::asset::AssetPackage& package, size_t assetId) -> std::vector<std::byte>
+{
+    const auto& entry = package.GetEntry(assetId);
+    return package.Read(assetId, [&](std::istream& stream)
+    {
+        const auto header = nc::asset::ImportNcaHeader(stream);
+        package.ValidateHeader(assetId, header);
+
+        auto bytes = std::vector<std::byte>(nc::asset::NcaHeader::binarySize + header.size);
+        stream.seekg(static_cast<std::streamoff>(entry.offset));
+        if (!stream.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+        {
+            throw nc::NcError(fmt::format("Failed reading asset '{}' from package", assetId));
+        }
+
+        return bytes;
+    });
+}
+
+auto ImportRequested(const nc::asset::ImportRequest& request, const nc::asset::AssetPackage* package) -> nc::asset::AnyAsset
+{
+    if (const auto* path = std::get_if<std::filesystem::path>(&request.source))
+    {
+        auto file = nc::asset::OpenNca(*path);
+        return nc::asset::DeserializeAny(file, request.type).asset;
+    }
+
+    if (!package)
+    {
+        throw nc::NcError("Batch import by asset id requires a package");
+    }
+
+    const auto bytes = ::ReadPackagedNca(*package, std::get<size_t>(request.source));
+    auto view = std::span<const std::byte>{bytes};
+    return nc::asset::DeserializeAny(view, request.type).asset;
+}
+
+void ImportInto(size_t requestIndex,
+                const nc::asset::ImportRequest& request,
+                const nc::asset::AssetPackage* package,
+                const nc::asset::ImportCallback& callback)
+{
+    auto result = nc::asset::ImportResult{requestIndex, std::nullopt, nullptr};
+    try
+    {
+        result.asset = ::ImportRequested(request, package);
+    }
+    catch (...)
+    {
+        result.error = std::current_exception();
+    }
+
+    callback(std::move(result));
+}
+
+auto GetDefaultPool() -> nc::asset::ThreadPool&
+{
+    static auto pool = nc::asset::ThreadPool{};
+    return pool;
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+auto ImportBatch(std::span<const ImportRequest> requests,
+                 ThreadPool& pool,
+                 const AssetPackage* package) -> std::vector<std::future<AnyAsset>>
+{
+    auto futures = std::vector<std::future<AnyAsset>>{};
+    futures.reserve(requests.size());
+    for (const auto& request : requests)
+    {
+        auto task = std::make_shared<std::packaged_task<AnyAsset()>>([request, package]()
+        {
+            return ::ImportRequested(request, package);
+        });
+
+        futures.push_back(task->get_future());
+        pool.Submit([task = std::move(task)]() { (*task)(); });
+    }
+
+    return futures;
+}
+
+auto ImportBatch(std::span<const ImportRequest> requests,
+                 const AssetPackage* package) -> std::vector<std::future<AnyAsset>>
+{
+    return ImportBatch(requests, ::GetDefaultPool(), package);
+}
+
+void ImportBatch(std::span<const ImportRequest> requests,
+                 ThreadPool& pool,
+                 ImportCallback onComplete,
+                 const AssetPackage* package)
+{
+    auto callback = std::make_shared<ImportCallback>(std::move(onComplete));
+    for (auto i = size_t{0}; i < requests.size(); ++i)
+    {
+        pool.Submit([i, request = requests[i], package, callback]()
+        {
+            ::ImportInto(i, request, package, *callback);
+        });
+    }
+}
+
+void ImportBatch(std::span<const ImportRequest> requests,
+                 BulkReader& reader,
+                 ThreadPool& pool,
+                 ImportCallback onComplete,
+                 const AssetPackage* package)
+{
+    auto callback = std::make_shared<ImportCallback>(std::move(onComplete));
+    auto paths = std::vector<std::filesystem::path>{};
+    auto pathRequests = std::vector<size_t>{};
+    for (auto i = size_t{0}; i < requests.size(); ++i)
+    {
+        if (const auto* path = std::get_if<std::filesystem::path>(&requests[i].source))
+        {
+            paths.push_back(*path);
+            pathRequests.push_back(i);
+            continue;
+        }
+
+        pool.Submit([i, request = requests[i], package, callback]()
+        {
+            ::ImportInto(i, request, package, *callback);
+        });
+    }
+
+    reader.Read(paths, [&](BulkReadResult&& read)
+    {
+        const auto requestIndex = pathRequests[read.pathIndex];
+        if (read.error)
+        {
+            (*callback)(ImportResult{requestIndex, std::nullopt, read.error});
+            return;
+        }
+
+        auto bytes = std::make_shared<std::vector<std::byte>>(std::move(read.bytes));
+        pool.Submit([requestIndex, type = requests[requestIndex].type, bytes, callback]()
+        {
+            auto result = ImportResult{requestIndex, std::nullopt, nullptr};
+            try
+            {
+                auto view = std::span<const std::byte>{*bytes};
+                result.asset = DeserializeAny(view, type).asset;
+            }
+            catch (...)
+            {
+                result.error = std::current_exception();
+            }
+
+            (*callback)(std::move(result));
+        });
+    });
+}
+} // namespace nc::asset
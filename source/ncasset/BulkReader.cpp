@@ -0,0 +1,547 @@
+#include "BulkReader.h"
+#include "ThreadPool.h"
+
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+#define NC_ASSET_IO_URING
+#endif
+
+#ifdef WIN32
+#include <fstream>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#ifdef NC_ASSET_IO_URING
+#include <array>
+#include <atomic>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+namespace
+{
+constexpr auto maxBlockingThreads = 32u;
+
+auto OpenFailed(const std::filesystem::path& path) -> std::exception_ptr
+{
+    return std::make_exception_ptr(nc::NcError("Could not open file: ", path.string()));
+}
+
+auto ReadFailed(const std::filesystem::path& path) -> std::exception_ptr
+{
+    return std::make_exception_ptr(nc::NcError("Failed reading file: ", path.string()));
+}
+
+/** Read a whole file with blocking calls. */
+auto ReadFile(const std::filesystem::path& path) -> std::vector<std::byte>
+{
+#ifdef WIN32
+    auto file = std::ifstream{path, std::ios::binary | std::ios::ate};
+    if (!file.is_open())
+    {
+        std::rethrow_exception(::OpenFailed(path));
+    }
+
+    auto bytes = std::vector<std::byte>(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(bytes.data()), static_cast<std::streamsize>(bytes.size())))
+    {
+        std::rethrow_exception(::ReadFailed(path));
+    }
+
+    return bytes;
+#else
+    const auto fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        std::rethrow_exception(::OpenFailed(path));
+    }
+
+    auto bytes = std::vector<std::byte>{};
+    struct stat status{};
+    auto succeeded = ::fstat(fd, &status) == 0;
+    if (succeeded)
+    {
+        bytes.resize(static_cast<size_t>(status.st_size));
+        for (auto done = size_t{0}; succeeded && done < bytes.size();)
+        {
+            const auto count = ::pread(fd, bytes.data() + done, bytes.size() - done, static_cast<off_t>(done));
+            if (count < 0 && errno == EINTR)
+            {
+                continue;
+            }
+
+            succeeded = count > 0;
+            done += succeeded ? static_cast<size_t>(count) : 0;
+        }
+    }
+
+    ::close(fd);
+    if (!succeeded)
+    {
+        std::rethrow_exception(::ReadFailed(path));
+    }
+
+    return bytes;
+#endif
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+#ifdef NC_ASSET_IO_URING
+/** A minimal io_uring over raw syscalls, to avoid depending on liburing. */
+class BulkReader::Ring
+{
+    public:
+        /** Create a ring with room for entries operations, or null if io_uring or a needed opcode is unavailable. */
+        static auto Create(unsigned entries) -> std::unique_ptr<Ring>
+        {
+            auto params = io_uring_params{};
+            const auto fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+            if (fd < 0)
+            {
+                return nullptr;
+            }
+
+            auto ring = std::unique_ptr<Ring>{new Ring{fd, params}};
+            if (!ring->m_sqes || !ring->SupportsOperations())
+            {
+                return nullptr;
+            }
+
+            return ring;
+        }
+
+        ~Ring() noexcept
+        {
+            if (m_sqes)
+            {
+                ::munmap(m_sqes, m_sqesSize);
+            }
+
+            if (m_cqRing && m_cqRing != m_sqRing)
+            {
+                ::munmap(m_cqRing, m_cqRingSize);
+            }
+
+            if (m_sqRing)
+            {
+                ::munmap(m_sqRing, m_sqRingSize);
+            }
+
+            ::close(m_fd);
+        }
+
+        Ring(const Ring&) = delete;
+        Ring& operator=(const Ring&) = delete;
+
+        auto GetCapacity() const noexcept -> unsigned
+        {
+            return m_sqEntries;
+        }
+
+        /** Queue an operation. Callers keep in-flight operations within capacity, so there is always room. */
+        void Push(const io_uring_sqe& sqe)
+        {
+            const auto tail = *m_sqTail;
+            const auto index = tail & m_sqMask;
+            m_sqes[index] = sqe;
+            m_sqArray[index] = index;
+            std::atomic_ref{*m_sqTail}.store(tail + 1, std::memory_order_release);
+            ++m_unsubmitted;
+        }
+
+        /** Submit queued operations and wait for at least one completion. */
+        void SubmitAndWait()
+        {
+            while (true)
+            {
+                const auto submitted = ::syscall(__NR_io_uring_enter, m_fd, m_unsubmitted, 1u, IORING_ENTER_GETEVENTS, nullptr, 0);
+                if (submitted >= 0)
+                {
+                    m_unsubmitted -= static_cast<unsigned>(submitted);
+                    return;
+                }
+
+                if (errno != EINTR && errno != EAGAIN && errno != EBUSY)
+                {
+                    throw NcError(fmt::format("io_uring_enter failed: {}", std::strerror(errno)));
+                }
+            }
+        }
+
+        /** Invoke a handler with the user data and result of each available completion. */
+        template<class Handler>
+        void Drain(Handler&& handler)
+        {
+            auto head = *m_cqHead;
+            const auto tail = std::atomic_ref{*m_cqTail}.load(std::memory_order_acquire);
+            for (; head != tail; ++head)
+            {
+                const auto& cqe = m_cqes[head & m_cqMask];
+                const auto userData = cqe.user_data;
+                const auto result = cqe.res;
+                std::atomic_ref{*m_cqHead}.store(head + 1, std::memory_order_release);
+                handler(userData, result);
+            }
+        }
+
+    private:
+        int m_fd;
+        void* m_sqRing = nullptr;
+        void* m_cqRing = nullptr;
+        io_uring_sqe* m_sqes = nullptr;
+        size_t m_sqRingSize = 0;
+        size_t m_cqRingSize = 0;
+        size_t m_sqesSize = 0;
+        unsigned* m_sqTail = nullptr;
+        unsigned* m_sqArray = nullptr;
+        unsigned m_sqMask = 0;
+        unsigned m_sqEntries = 0;
+        unsigned* m_cqHead = nullptr;
+        unsigned* m_cqTail = nullptr;
+        io_uring_cqe* m_cqes = nullptr;
+        unsigned m_cqMask = 0;
+        unsigned m_unsubmitted = 0;
+
+        Ring(int fd, const io_uring_params& params)
+            : m_fd{fd},
+              m_sqRingSize{params.sq_off.array + params.sq_entries * sizeof(unsigned)},
+              m_cqRingSize{params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe)},
+              m_sqesSize{params.sq_entries * sizeof(io_uring_sqe)}
+        {
+            const auto singleMap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+            if (singleMap)
+            {
+                m_sqRingSize = m_cqRingSize = std::max(m_sqRingSize, m_cqRingSize);
+            }
+
+            m_sqRing = Map(m_sqRingSize, IORING_OFF_SQ_RING);
+            m_cqRing = singleMap ? m_sqRing : Map(m_cqRingSize, IORING_OFF_CQ_RING);
+            if (!m_sqRing || !m_cqRing)
+            {
+                return;
+            }
+
+            auto* sq = static_cast<std::byte*>(m_sqRing);
+            auto* cq = static_cast<std::byte*>(m_cqRing);
+            m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+            m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+            m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+            m_sqEntries = params.sq_entries;
+            m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+            m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+            m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+            m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+            m_sqes = static_cast<io_uring_sqe*>(Map(m_sqesSize, IORING_OFF_SQES));
+        }
+
+        auto Map(size_t size, uint64_t offset) const -> void*
+        {
+            auto* data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, static_cast<off_t>(offset));
+            return data == MAP_FAILED ? nullptr : data;
+        }
+
+        /** Opcodes are probed, as kernels before 5.6 can create a ring without supporting file operations. */
+        auto SupportsOperations() const -> bool
+        {
+            constexpr auto probedOps = 256u;
+            auto buffer = std::vector<std::byte>(sizeof(io_uring_probe) + probedOps * sizeof(io_uring_probe_op));
+            auto* probe = reinterpret_cast<io_uring_probe*>(buffer.data());
+            if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PROBE, probe, probedOps) < 0)
+            {
+                return false;
+            }
+
+            constexpr auto required = std::array<unsigned, 4>{IORING_OP_OPENAT, IORING_OP_STATX, IORING_OP_READ, IORING_OP_CLOSE};
+            return std::all_of(required.cbegin(), required.cend(), [probe](unsigned op)
+            {
+                return op < probe->ops_len && (probe->ops[op].flags & IO_URING_OP_SUPPORTED) != 0;
+            });
+        }
+};
+#else
+class BulkReader::Ring
+{
+};
+#endif
+
+BulkReader::BulkReader(unsigned queueDepth, BulkReadMode mode)
+    : m_queueDepth{std::max(queueDepth, 1u)}
+{
+#ifdef NC_ASSET_IO_URING
+    if (mode == BulkReadMode::Automatic)
+    {
+        m_ring = Ring::Create(m_queueDepth);
+    }
+#else
+    (void)mode;
+#endif
+
+    if (!m_ring)
+    {
+        m_pool = std::make_unique<ThreadPool>(std::min(m_queueDepth, maxBlockingThreads));
+    }
+}
+
+BulkReader::~BulkReader() noexcept = default;
+
+void BulkReader::Read(std::span<const std::filesystem::path> paths, const BulkReadCallback& onRead)
+{
+    if (m_ring)
+    {
+        ReadWithRing(paths, onRead);
+    }
+    else
+    {
+        ReadWithPool(paths, onRead);
+    }
+}
+
+auto BulkReader::IsUsingIoUring() const noexcept -> bool
+{
+    return m_ring != nullptr;
+}
+
+void BulkReader::ReadWithRing([[maybe_unused]] std::span<const std::filesystem::path> paths,
+                              [[maybe_unused]] const BulkReadCallback& onRead)
+{
+#ifdef NC_ASSET_IO_URING
+    // Each file is opened, sized, read in one or more requests, then closed. The low bits of
+    // an operation's user data identify the step, and the rest the file.
+    enum Step : uint64_t { Open, Stat, ReadBytes, Close };
+    constexpr auto stepBits = 2u;
+
+    struct FileState
+    {
+        int fd = -1;
+        size_t done = 0;
+        std::vector<std::byte> bytes;
+        struct statx status{};
+    };
+
+    auto files = std::vector<FileState>(paths.size());
+    auto nextFile = size_t{0};
+    auto delivered = size_t{0};
+    auto inFlight = 0u;
+    const auto capacity = m_ring->GetCapacity();
+
+    const auto push = [this, &inFlight](uint8_t opcode, size_t file, Step step, const auto& prepare)
+    {
+        auto sqe = io_uring_sqe{};
+        sqe.opcode = opcode;
+        sqe.user_data = (uint64_t{file} << stepBits) | step;
+        prepare(sqe);
+        m_ring->Push(sqe);
+        ++inFlight;
+    };
+
+    const auto pushRead = [&](size_t file)
+    {
+        auto& state = files[file];
+        push(IORING_OP_READ, file, ReadBytes, [&state](io_uring_sqe& sqe)
+        {
+            sqe.fd = state.fd;
+            sqe.addr = reinterpret_cast<uint64_t>(state.bytes.data() + state.done);
+            sqe.len = static_cast<uint32_t>(std::min<size_t>(state.bytes.size() - state.done, 1u << 30));
+            sqe.off = state.done;
+        });
+    };
+
+    const auto finish = [&](size_t file, std::exception_ptr error)
+    {
+        auto& state = files[file];
+        if (state.fd >= 0)
+        {
+            push(IORING_OP_CLOSE, file, Close, [&state](io_uring_sqe& sqe) { sqe.fd = state.fd; });
+            state.fd = -1;
+        }
+
+        auto bytes = error ? std::vector<std::byte>{} : std::move(state.bytes);
+        state.bytes = std::vector<std::byte>{};
+        ++delivered;
+        onRead(BulkReadResult{file, std::move(bytes), error});
+    };
+
+    // A file's close is pushed while handling its last completion, which freed a slot.
+    try
+    {
+        while (delivered < paths.size() || inFlight != 0)
+        {
+            for (; nextFile < paths.size() && inFlight < capacity; ++nextFile)
+            {
+                push(IORING_OP_OPENAT, nextFile, Open, [&paths, nextFile](io_uring_sqe& sqe)
+                {
+                    sqe.fd = AT_FDCWD;
+                    sqe.addr = reinterpret_cast<uint64_t>(paths[nextFile].c_str());
+                    sqe.open_flags = O_RDONLY | O_CLOEXEC;
+                });
+            }
+
+            m_ring->SubmitAndWait();
+            m_ring->Drain([&](uint64_t userData, int result)
+            {
+                --inFlight;
+                const auto file = static_cast<size_t>(userData >> stepBits);
+                auto& state = files[file];
+                switch (static_cast<Step>(userData & ((1u << stepBits) - 1)))
+                {
+                    case Open:
+                    {
+                        if (result < 0)
+                        {
+                            finish(file, ::OpenFailed(paths[file]));
+                            return;
+                        }
+
+                        state.fd = result;
+                        push(IORING_OP_STATX, file, Stat, [&state](io_uring_sqe& sqe)
+                        {
+                            sqe.fd = state.fd;
+                            sqe.addr = reinterpret_cast<uint64_t>("");
+                            sqe.len = STATX_SIZE;
+                            sqe.off = reinterpret_cast<uint64_t>(&state.status);
+                            sqe.statx_flags = AT_EMPTY_PATH;
+                        });
+
+                        return;
+                    }
+                    case Stat:
+                    {
+                        if (result < 0 || (state.status.stx_mask & STATX_SIZE) == 0)
+                        {
+                            finish(file, ::ReadFailed(paths[file]));
+                            return;
+                        }
+
+                        state.bytes.resize(static_cast<size_t>(state.status.stx_size));
+                        if (state.bytes.empty())
+                        {
+                            finish(file, nullptr);
+                            return;
+                        }
+
+                        pushRead(file);
+                        return;
+                    }
+                    case ReadBytes:
+                    {
+                        if (result <= 0)
+                        {
+                            finish(file, ::ReadFailed(paths[file]));
+                            return;
+                        }
+
+                        state.done += static_cast<size_t>(result);
+                        if (state.done < state.bytes.size())
+                        {
+                            pushRead(file);
+                            return;
+                        }
+
+                        finish(file, nullptr);
+                        return;
+                    }
+                    case Close:
+                    {
+                        return;
+                    }
+                }
+            });
+        }
+    }
+    catch (...)
+    {
+        // Completions write into the file states, so they must all arrive before the states are freed.
+        const auto settled = [&]()
+        {
+            try
+            {
+                while (inFlight != 0)
+                {
+                    m_ring->SubmitAndWait();
+                    m_ring->Drain([&](uint64_t userData, int result)
+                    {
+                        --inFlight;
+                        if ((userData & ((1u << stepBits) - 1)) == Open && result >= 0)
+                        {
+                            ::close(result);
+                        }
+                    });
+                }
+
+                return true;
+            }
+            catch (...)
+            {
+                return false;
+            }
+        }();
+
+        // The ring holds its own reference to a file, so this is safe even while its read is in flight.
+        for (const auto& state : files)
+        {
+            if (state.fd >= 0)
+            {
+                ::close(state.fd);
+            }
+        }
+
+        if (!settled)
+        {
+            // The kernel may still write into the buffers, so they are leaked, and later reads use the pool.
+            static_cast<void>(new std::vector<FileState>{std::move(files)});
+            m_ring.reset();
+            m_pool = std::make_unique<ThreadPool>(std::min(m_queueDepth, maxBlockingThreads));
+        }
+
+        throw;
+    }
+#endif
+}
+
+void BulkReader::ReadWithPool(std::span<const std::filesystem::path> paths, const BulkReadCallback& onRead)
+{
+    auto mutex = std::mutex{};
+    auto finished = std::condition_variable{};
+    auto remaining = paths.size();
+    for (auto i = size_t{0}; i < paths.size(); ++i)
+    {
+        m_pool->Submit([&, i]()
+        {
+            auto result = BulkReadResult{i, {}, nullptr};
+            try
+            {
+                result.bytes = ::ReadFile(paths[i]);
+            }
+            catch (...)
+            {
+                result.error = std::current_exception();
+            }
+
+            onRead(std::move(result));
+            auto lock = std::lock_guard{mutex};
+            if (--remaining == 0)
+            {
+                finished.notify_all();
+            }
+        });
+    }
+
+    auto lock = std::unique_lock{mutex};
+    finished.wait(lock, [&remaining]() { return remaining == 0; });
+}
+} // namespace nc::asset
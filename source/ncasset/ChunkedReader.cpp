@@ -0,0 +1,230 @@
+#include "ChunkedReader.h"
+#include "ThreadPool.h"
+
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace
+{
+// Chunk table: u64 uncompressed size, u32 chunk size, u32 chunk count, u32 compressed size per chunk.
+constexpr auto tableHeaderSize = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+
+template<class T>
+auto ReadValue(std::span<const std::byte> bytes, size_t offset) -> T
+{
+    auto value = T{};
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+auto GetDecodePool() -> nc::asset::ThreadPool&
+{
+    static auto pool = nc::asset::ThreadPool{};
+    return pool;
+}
+
+/**
+ * Chunks shared between the reading thread and pool workers. The reading thread claims
+ * chunks too, so it never waits on a chunk no thread has started, even if the pool is busy.
+ */
+struct DecodeBatch
+{
+    std::atomic<size_t> next;
+    size_t last;
+    std::atomic<size_t> unfinished;
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::exception_ptr error;
+};
+
+template<class Decode>
+void DecodeClaimedChunks(DecodeBatch& batch, const Decode& decode)
+{
+    for (auto chunk = batch.next++; chunk < batch.last; chunk = batch.next++)
+    {
+        try
+        {
+            decode(chunk);
+        }
+        catch (...)
+        {
+            auto lock = std::lock_guard{batch.mutex};
+            if (!batch.error)
+            {
+                batch.error = std::current_exception();
+            }
+        }
+
+        if (batch.unfinished.fetch_sub(1) == 1)
+        {
+            auto lock = std::lock_guard{batch.mutex};
+            batch.finished.notify_all();
+        }
+    }
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+ChunkedReader::ChunkedReader(std::span<const std::byte> blob, std::string_view algorithm)
+{
+    const auto codec = GetCodec(algorithm);
+    if (blob.size() < tableHeaderSize)
+    {
+        throw NcError("Compressed blob is missing its chunk table");
+    }
+
+    const auto size = ::ReadValue<uint64_t>(blob, 0);
+    const auto chunkSize = ::ReadValue<uint32_t>(blob, sizeof(uint64_t));
+    const auto chunkCount = ::ReadValue<uint32_t>(blob, sizeof(uint64_t) + sizeof(uint32_t));
+    const auto expectedCount = chunkSize == 0 ? uint64_t{0} : (size + chunkSize - 1) / chunkSize;
+    if ((chunkSize == 0 && size != 0) || chunkCount != expectedCount)
+    {
+        throw NcError(fmt::format(
+            "Invalid chunk table: '{}' chunks of '{}' bytes for a '{}' byte blob",
+            chunkCount, chunkSize, size
+        ));
+    }
+
+    const auto tableSize = tableHeaderSize + size_t{chunkCount} * sizeof(uint32_t);
+    if (tableSize > blob.size())
+    {
+        throw NcError("Compressed blob chunk table exceeds blob size");
+    }
+
+    m_data = blob.subspan(tableSize);
+    m_decode = codec.decode;
+    m_size = static_cast<size_t>(size);
+    m_chunkSize = chunkSize;
+    m_offsets.reserve(size_t{chunkCount} + 1);
+    m_offsets.push_back(0);
+    for (auto chunk = size_t{0}; chunk < chunkCount; ++chunk)
+    {
+        const auto compressedSize = size_t{::ReadValue<uint32_t>(blob, tableHeaderSize + chunk * sizeof(uint32_t))};
+        if (GetUncompressedChunkSize(chunk) > (compressedSize + 1) * codec.maxExpansionRatio)
+        {
+            throw NcError(fmt::format("Implausible size for compressed chunk '{}'", chunk));
+        }
+
+        m_offsets.push_back(m_offsets.back() + compressedSize);
+    }
+
+    if (m_offsets.back() != m_data.size())
+    {
+        throw NcError(fmt::format(
+            "Compressed chunks total '{}' bytes, expected '{}'",
+            m_offsets.back(), m_data.size()
+        ));
+    }
+}
+
+void ChunkedReader::ReadBytes(void* out, size_t count)
+{
+    if (count > Remaining())
+    {
+        throw NcError("Read past end of asset data");
+    }
+
+    auto* dst = static_cast<std::byte*>(out);
+    while (count != 0)
+    {
+        const auto chunk = m_position / m_chunkSize;
+        const auto offset = m_position % m_chunkSize;
+
+        // Whole chunks skip the cache, and are spread across threads when there are several.
+        if (offset == 0 && chunk != m_cachedChunk && count >= GetUncompressedChunkSize(chunk))
+        {
+            auto last = chunk + 1;
+            auto bytes = GetUncompressedChunkSize(chunk);
+            while (last < GetChunkCount() && count - bytes >= GetUncompressedChunkSize(last))
+            {
+                bytes += GetUncompressedChunkSize(last);
+                ++last;
+            }
+
+            DecodeChunks(chunk, last, dst);
+            dst += bytes;
+            count -= bytes;
+            m_position += bytes;
+            continue;
+        }
+
+        if (chunk != m_cachedChunk)
+        {
+            m_cache.resize(GetUncompressedChunkSize(chunk));
+            m_cachedChunk = noChunk;
+            DecodeChunk(chunk, m_cache.data());
+            m_cachedChunk = chunk;
+        }
+
+        const auto available = std::min(count, m_cache.size() - offset);
+        std::memcpy(dst, m_cache.data() + offset, available);
+        dst += available;
+        count -= available;
+        m_position += available;
+    }
+}
+
+void ChunkedReader::Skip(size_t count)
+{
+    if (count > Remaining())
+    {
+        throw NcError("Read past end of asset data");
+    }
+
+    m_position += count;
+}
+
+auto ChunkedReader::GetUncompressedChunkSize(size_t chunk) const noexcept -> size_t
+{
+    return std::min(m_chunkSize, m_size - chunk * m_chunkSize);
+}
+
+void ChunkedReader::DecodeChunk(size_t chunk, std::byte* out) const
+{
+    const auto compressed = m_data.subspan(m_offsets[chunk], m_offsets[chunk + 1] - m_offsets[chunk]);
+    m_decode(compressed, std::span<std::byte>{out, GetUncompressedChunkSize(chunk)});
+}
+
+void ChunkedReader::DecodeChunks(size_t first, size_t last, std::byte* out) const
+{
+    if (last - first == 1)
+    {
+        DecodeChunk(first, out);
+        return;
+    }
+
+    auto batch = std::make_shared<DecodeBatch>();
+    batch->next = first;
+    batch->last = last;
+    batch->unfinished = last - first;
+    const auto decode = [this, first, out](size_t chunk)
+    {
+        DecodeChunk(chunk, out + (chunk - first) * m_chunkSize);
+    };
+
+    // Workers that start after every chunk is claimed return without touching the reader.
+    auto& pool = ::GetDecodePool();
+    const auto helpers = std::min(pool.GetThreadCount(), last - first - 1);
+    for (auto i = size_t{0}; i < helpers; ++i)
+    {
+        pool.Submit([batch, decode]() { ::DecodeClaimedChunks(*batch, decode); });
+    }
+
+    ::DecodeClaimedChunks(*batch, decode);
+    auto lock = std::unique_lock{batch->mutex};
+    batch->finished.wait(lock, [&batch]() { return batch->unfinished == 0; });
+    if (batch->error)
+    {
+        std::rethrow_exception(batch->error);
+    }
+}
+} // namespace nc::asset
@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Decompress.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace nc::asset
+{
+/**
+ * @brief Forward cursor over the decompressed contents of a chunked, compressed blob.
+ *
+ * Chunks are decompressed on demand. Skipped chunks are never decompressed, and reads
+ * covering whole chunks decompress them in parallel directly into the destination.
+ * Partially read chunks are decompressed into an internal buffer and reused by
+ * subsequent reads.
+ */
+class ChunkedReader
+{
+    public:
+        /**
+         * @brief Read the chunk table of a compressed blob.
+         * @param blob The asset blob following an NcaHeader. Must outlive the reader.
+         * @param algorithm The NcaHeader compression algorithm.
+         */
+        ChunkedReader(std::span<const std::byte> blob, std::string_view algorithm);
+
+        /** @brief Copy a trivially copyable value from the current position. */
+        template<class T>
+            requires std::is_trivially_copyable_v<T>
+        void Read(T& out)
+        {
+            ReadBytes(&out, sizeof(T));
+        }
+
+        /** @brief Copy a number of decompressed bytes from the current position. */
+        void ReadBytes(void* out, size_t count);
+
+        /** @brief Advance the cursor without decompressing. */
+        void Skip(size_t count);
+
+        /** @brief Get the number of decompressed bytes consumed so far. */
+        auto Position() const noexcept -> size_t
+        {
+            return m_position;
+        }
+
+        /** @brief Get the number of unread decompressed bytes. */
+        auto Remaining() const noexcept -> size_t
+        {
+            return m_size - m_position;
+        }
+
+        /** @brief Get the number of chunks in the blob. */
+        auto GetChunkCount() const noexcept -> size_t
+        {
+            return m_offsets.size() - 1;
+        }
+
+    private:
+        static constexpr auto noChunk = SIZE_MAX;
+
+        std::span<const std::byte> m_data;
+        std::vector<size_t> m_offsets; // start of each chunk in m_data, plus the end of the last
+        ChunkDecoder m_decode = nullptr;
+        size_t m_size = 0;
+        size_t m_chunkSize = 0;
+        size_t m_position = 0;
+        std::vector<std::byte> m_cache;
+        size_t m_cachedChunk = noChunk;
+
+        auto GetUncompressedChunkSize(size_t chunk) const noexcept -> size_t;
+        void DecodeChunk(size_t chunk, std::byte* out) const;
+        void DecodeChunks(size_t first, size_t last, std::byte* out) const;
+};
+} // namespace nc::asset
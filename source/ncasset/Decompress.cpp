@@ -0,0 +1,335 @@
+#include "Decompress.h"
+#include "ChunkedReader.h"
+#include "ncasset/Dictionary.h"
+#include "ncasset/NcaHeader.h"
+
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+
+#ifdef NC_TOOLS_ZSTD
+#include "zstd.h"
+
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#endif
+
+namespace
+{
+constexpr auto minMatchLength = size_t{4};
+
+// An LZ4 sequence can expand at most this much, which bounds the allocation for a chunk.
+constexpr auto maxExpansionRatio = uint64_t{255};
+
+// Dictionary entries in a package use this in the high 32 bits of their asset id and the zstd dictionary id in the low 32.
+constexpr auto dictionaryAssetIdTag = size_t{0x4E43'4443'0000'0000}; // 'NCDC'
+constexpr auto dictionaryAssetIdTagMask = size_t{0xFFFF'FFFF'0000'0000};
+
+auto ReadLength(const std::byte*& in, const std::byte* inEnd, size_t length) -> size_t
+{
+    if (length != 15)
+    {
+        return length;
+    }
+
+    auto next = std::byte{};
+    do
+    {
+        if (in == inEnd)
+        {
+            throw nc::NcError("Truncated LZ4 block");
+        }
+
+        next = *in++;
+        length += std::to_integer<size_t>(next);
+    } while (next == std::byte{255});
+
+    return length;
+}
+
+/** Copy a match that may overlap its destination. Matches at least 8 bytes back are copied a word at a time. */
+void CopyMatch(std::byte* out, size_t offset, size_t length, const std::byte* outEnd)
+{
+    const auto* match = out - offset;
+    if (offset >= 8 && static_cast<size_t>(outEnd - out) >= length + 8)
+    {
+        const auto* end = out + length;
+        do
+        {
+            std::memcpy(out, match, 8);
+            out += 8;
+            match += 8;
+        } while (out < end);
+
+        return;
+    }
+
+    for (auto i = size_t{0}; i < length; ++i)
+    {
+        out[i] = match[i];
+    }
+}
+
+#ifdef NC_TOOLS_ZSTD
+// A zstd RLE block of 4 bytes can expand to a full 128KB block.
+constexpr auto maxZstdExpansionRatio = uint64_t{32768};
+
+struct DecompressionContextDeleter
+{
+    void operator()(ZSTD_DCtx* context) const noexcept
+    {
+        ZSTD_freeDCtx(context);
+    }
+};
+
+struct DictionaryDeleter
+{
+    void operator()(ZSTD_DDict* dictionary) const noexcept
+    {
+        ZSTD_freeDDict(dictionary);
+    }
+};
+
+/** Digested dictionaries by id. Registration is rare, so lookups take a shared lock. */
+struct DictionaryRegistry
+{
+    std::shared_mutex mutex;
+    std::unordered_map<uint32_t, std::unique_ptr<ZSTD_DDict, DictionaryDeleter>> dictionaries;
+};
+
+auto GetDictionaryRegistry() -> DictionaryRegistry&
+{
+    static auto registry = DictionaryRegistry{};
+    return registry;
+}
+
+/** Each thread keeps one context for its imports, avoiding an allocation per blob. */
+auto GetDecompressionContext() -> ZSTD_DCtx*
+{
+    thread_local auto context = std::unique_ptr<ZSTD_DCtx, DecompressionContextDeleter>{ZSTD_createDCtx()};
+    if (!context)
+    {
+        throw nc::NcError("Failed to create zstd decompression context");
+    }
+
+    return context.get();
+}
+
+void ZstdDecompress(std::span<const std::byte> compressed, std::span<std::byte> out)
+{
+    auto* context = ::GetDecompressionContext();
+    auto result = size_t{};
+    if (const auto dictionaryId = ZSTD_getDictID_fromFrame(compressed.data(), compressed.size()); dictionaryId != 0)
+    {
+        auto& registry = ::GetDictionaryRegistry();
+        auto lock = std::shared_lock{registry.mutex};
+        const auto pos = registry.dictionaries.find(dictionaryId);
+        if (pos == registry.dictionaries.cend())
+        {
+            throw nc::NcError(fmt::format("Blob requires zstd dictionary '{}', which is not registered", dictionaryId));
+        }
+
+        result = ZSTD_decompress_usingDDict(context, out.data(), out.size(), compressed.data(), compressed.size(), pos->second.get());
+    }
+    else
+    {
+        result = ZSTD_decompressDCtx(context, out.data(), out.size(), compressed.data(), compressed.size());
+    }
+
+    if (ZSTD_isError(result))
+    {
+        throw nc::NcError(fmt::format("zstd decompression failed: {}", ZSTD_getErrorName(result)));
+    }
+
+    if (result != out.size())
+    {
+        throw nc::NcError(fmt::format("zstd frame decoded to '{}' bytes, expected '{}'", result, out.size()));
+    }
+}
+#endif
+} // anonymous namespace
+
+namespace nc::asset
+{
+auto IsSupportedCompression(std::string_view algorithm) -> bool
+{
+#ifdef NC_TOOLS_ZSTD
+    if (algorithm == CompressionAlgorithm::zstd)
+    {
+        return true;
+    }
+#endif
+
+    return algorithm == CompressionAlgorithm::none || algorithm == CompressionAlgorithm::lz4;
+}
+
+auto GetDictionaryAssetId(uint32_t dictionaryId) -> size_t
+{
+    return dictionaryAssetIdTag | size_t{dictionaryId};
+}
+
+auto IsDictionaryAssetId(size_t assetId) -> bool
+{
+    return (assetId & dictionaryAssetIdTagMask) == dictionaryAssetIdTag;
+}
+
+auto RegisterDictionary(std::span<const std::byte> dictionary) -> uint32_t
+{
+#ifdef NC_TOOLS_ZSTD
+    const auto dictionaryId = ZSTD_getDictID_fromDict(dictionary.data(), dictionary.size());
+    if (dictionaryId == 0)
+    {
+        throw NcError("Not a trained zstd dictionary");
+    }
+
+    auto& registry = ::GetDictionaryRegistry();
+    auto lock = std::unique_lock{registry.mutex};
+    if (registry.dictionaries.contains(dictionaryId))
+    {
+        return dictionaryId;
+    }
+
+    auto digested = std::unique_ptr<ZSTD_DDict, ::DictionaryDeleter>{ZSTD_createDDict(dictionary.data(), dictionary.size())};
+    if (!digested)
+    {
+        throw NcError(fmt::format("Failed to load zstd dictionary '{}'", dictionaryId));
+    }
+
+    registry.dictionaries.emplace(dictionaryId, std::move(digested));
+    return dictionaryId;
+#else
+    static_cast<void>(dictionary);
+    throw NcError("NcAsset was built without zstd support");
+#endif
+}
+
+void RegisterDictionaries(const std::filesystem::path& ncdPath)
+{
+    auto file = std::ifstream{ncdPath, std::ios::binary};
+    if (!file.is_open())
+    {
+        throw NcError("Failure opening file: ", ncdPath.string());
+    }
+
+    while (file.peek() != std::ifstream::traits_type::eof())
+    {
+        RegisterDictionary(file);
+    }
+}
+
+void RegisterDictionary(std::istream& stream)
+{
+    auto header = NcaHeader{};
+    Deserialize(stream, header);
+    if (!stream || std::string_view{header.magicNumber} != MagicNumber::dictionary)
+    {
+        throw NcError("Expected a zstd dictionary record");
+    }
+
+    auto dictionary = std::vector<std::byte>(header.size);
+    stream.read(reinterpret_cast<char*>(dictionary.data()), static_cast<std::streamsize>(dictionary.size()));
+    if (!stream)
+    {
+        throw NcError(fmt::format("Truncated zstd dictionary record '{}'", header.assetId));
+    }
+
+    RegisterDictionary(dictionary);
+}
+
+void Lz4Decompress(std::span<const std::byte> compressed, std::span<std::byte> out)
+{
+    const auto* in = compressed.data();
+    const auto* inEnd = in + compressed.size();
+    auto* dst = out.data();
+    auto* const dstBegin = dst;
+    auto* const dstEnd = dst + out.size();
+
+    while (in < inEnd)
+    {
+        const auto token = std::to_integer<size_t>(*in++);
+        const auto literalLength = ::ReadLength(in, inEnd, token >> 4);
+        if (literalLength > static_cast<size_t>(inEnd - in) || literalLength > static_cast<size_t>(dstEnd - dst))
+        {
+            throw NcError("LZ4 literal run exceeds block bounds");
+        }
+
+        // Short literal runs are copied with a fixed size when there is room, which avoids a variable length copy.
+        if (literalLength <= 16 && inEnd - in >= 16 && dstEnd - dst >= 16)
+        {
+            std::memcpy(dst, in, 16);
+        }
+        else
+        {
+            std::memcpy(dst, in, literalLength);
+        }
+
+        in += literalLength;
+        dst += literalLength;
+
+        // The final sequence has literals only.
+        if (in == inEnd)
+        {
+            break;
+        }
+
+        if (inEnd - in < 2)
+        {
+            throw NcError("Truncated LZ4 block");
+        }
+
+        const auto offset = std::to_integer<size_t>(in[0]) | (std::to_integer<size_t>(in[1]) << 8);
+        in += 2;
+        if (offset == 0 || offset > static_cast<size_t>(dst - dstBegin))
+        {
+            throw NcError("Invalid LZ4 match offset");
+        }
+
+        const auto matchLength = ::ReadLength(in, inEnd, token & 15) + minMatchLength;
+        if (matchLength > static_cast<size_t>(dstEnd - dst))
+        {
+            throw NcError("LZ4 match exceeds block bounds");
+        }
+
+        ::CopyMatch(dst, offset, matchLength, dstEnd);
+        dst += matchLength;
+    }
+
+    if (dst != dstEnd)
+    {
+        throw NcError(fmt::format(
+            "LZ4 block decoded to '{}' bytes, expected '{}'",
+            dst - dstBegin, out.size()
+        ));
+    }
+}
+
+auto GetCodec(std::string_view algorithm) -> Codec
+{
+    if (algorithm == CompressionAlgorithm::lz4)
+    {
+        return Codec{&Lz4Decompress, maxExpansionRatio};
+    }
+#ifdef NC_TOOLS_ZSTD
+    else if (algorithm == CompressionAlgorithm::zstd)
+    {
+        return Codec{&::ZstdDecompress, maxZstdExpansionRatio};
+    }
+#endif
+
+    throw NcError(fmt::format("Unsupported compression algorithm: '{}'", algorithm));
+}
+
+auto DecompressBlob(std::span<const std::byte> blob, std::string_view algorithm) -> std::vector<std::byte>
+{
+    auto reader = ChunkedReader{blob, algorithm};
+    auto out = std::vector<std::byte>(reader.Remaining());
+    reader.ReadBytes(out.data(), out.size());
+    return out;
+}
+} // namespace nc::asset
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace nc::asset
+{
+/** @brief Decodes a compressed chunk into a buffer of exactly its uncompressed size. */
+using ChunkDecoder = void(*)(std::span<const std::byte> compressed, std::span<std::byte> out);
+
+/** @brief The chunk decoder for a compression algorithm. */
+struct Codec
+{
+    ChunkDecoder decode;
+
+    /** @brief The most a chunk can expand, used to reject implausible sizes before allocating. */
+    uint64_t maxExpansionRatio;
+};
+
+/** @brief Check if an NcaHeader compression algorithm can be decoded. */
+auto IsSupportedCompression(std::string_view algorithm) -> bool;
+
+/** @brief Get the codec for a compression algorithm. Throws if the algorithm is not supported. */
+auto GetCodec(std::string_view algorithm) -> Codec;
+
+/**
+ * @brief Decode an LZ4 block into a buffer of exactly the uncompressed size.
+ * @note Throws if the block is malformed or does not fill the output buffer.
+ */
+void Lz4Decompress(std::span<const std::byte> compressed, std::span<std::byte> out);
+
+/** @brief Read a dictionary record (a DICT NcaHeader and the raw dictionary) and register it. */
+void RegisterDictionary(std::istream& stream);
+
+/**
+ * @brief Decode an entire compressed asset blob.
+ * @param blob The asset blob following an NcaHeader: a chunk table and the compressed chunks.
+ * @note zstd blobs compressed with a dictionary require it to be registered first.
+ * @param algorithm The NcaHeader compression algorithm.
+ */
+auto DecompressBlob(std::span<const std::byte> blob, std::string_view algorithm) -> std::vector<std::byte>;
+} // namespace nc::asset
@@ -1,15 +1,36 @@
 #include "Deserialize.h"
+#include "ChunkedReader.h"
+#include "SpanReader.h"
 #include "ncasset/Assets.h"
+#include "ncasset/AssetViews.h"
+#include "ncasset/PmrAssets.h"
 
 #include "ncutility/BinarySerialization.h"
 #include "ncutility/NcError.h"
 #include "fmt/format.h"
 
+#include <algorithm>
+#include <fstream>
 #include <istream>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <type_traits>
 #include <vector>
 
 namespace
 {
+void ValidateCompression(const nc::asset::NcaHeader& header)
+{
+    if (!nc::asset::IsSupportedCompression(header.compressionAlgorithm))
+    {
+        throw nc::NcError(fmt::format(
+            "Unsupported compression algorithm: '{}'",
+            header.compressionAlgorithm
+        ));
+    }
+}
+
 void ValidateHeader(const nc::asset::NcaHeader& header, std::string_view expectedMagicNumber)
 {
     if (std::string_view{header.magicNumber} != expectedMagicNumber)
@@ -20,28 +41,734 @@ void ValidateHeader(const nc::asset::NcaHeader& header, std::string_view expecte
         );
     }
 
-    if (std::string_view{header.compressionAlgorithm} != "NONE")
+    ::ValidateCompression(header);
+}
+
+void ReadBytes(std::istream& stream, void* out, size_t count)
+{
+    stream.read(static_cast<char*>(out), static_cast<std::streamsize>(count));
+}
+
+void ReadBytes(nc::asset::SpanReader& reader, void* out, size_t count)
+{
+    reader.ReadBytes(out, count);
+}
+
+void ReadBytes(nc::asset::ChunkedReader& reader, void* out, size_t count)
+{
+    reader.ReadBytes(out, count);
+}
+
+void SkipBytes(std::istream& stream, size_t count)
+{
+    if (count != 0)
+    {
+        stream.seekg(static_cast<std::streamoff>(count), std::ios::cur);
+    }
+}
+
+void SkipBytes(nc::asset::SpanReader& reader, size_t count)
+{
+    reader.Skip(count);
+}
+
+void SkipBytes(nc::asset::ChunkedReader& reader, size_t count)
+{
+    reader.Skip(count);
+}
+
+/** Get a source's position, for measuring how many bytes a variable length read consumed. */
+auto Tell(std::istream& stream) -> uint64_t
+{
+    return static_cast<uint64_t>(stream.tellg());
+}
+
+auto Tell(nc::asset::SpanReader& reader) -> uint64_t
+{
+    return reader.Position();
+}
+
+auto Tell(nc::asset::ChunkedReader& reader) -> uint64_t
+{
+    return reader.Position();
+}
+
+/** Streams are checked once a read completes, while spans are checked before every read. */
+void CheckSucceeded(std::istream& stream)
+{
+    if (!stream)
+    {
+        throw nc::NcError("Unexpected end of asset data");
+    }
+}
+
+void CheckSucceeded(nc::asset::SpanReader&)
+{
+}
+
+void CheckSucceeded(nc::asset::ChunkedReader&)
+{
+}
+
+/** Reject element counts that cannot fit in the remaining data before allocating for them. */
+void CheckAvailable(std::istream&, size_t, size_t)
+{
+}
+
+template<class Reader>
+void CheckAvailable(Reader& reader, size_t count, size_t elementSize)
+{
+    if (count > reader.Remaining() / elementSize)
+    {
+        throw nc::NcError("Read past end of asset data");
+    }
+}
+
+template<class Source, class T>
+    requires std::is_trivially_copyable_v<T>
+void Read(Source& source, T& out)
+{
+    ::ReadBytes(source, &out, sizeof(T));
+}
+
+template<class Source>
+auto ReadCount(Source& source, size_t minElementSize) -> size_t
+{
+    auto count = size_t{};
+    ::Read(source, count);
+    ::CheckSucceeded(source);
+    ::CheckAvailable(source, count, minElementSize);
+    return count;
+}
+
+/** The element count of an array and the size of everything preceding its first element. */
+struct ArrayPrefix
+{
+    size_t count;
+    size_t size;
+};
+
+/**
+ * Read an array's element count and skip the padding recorded before its data, leaving the
+ * source at the first element. Readers follow the recorded padding, so any alignment can be read.
+ */
+template<class Source>
+auto ReadArrayPrefix(Source& source, size_t elementSize) -> ArrayPrefix
+{
+    auto count = uint64_t{};
+    auto padding = uint32_t{};
+    ::Read(source, count);
+    ::Read(source, padding);
+    ::CheckSucceeded(source);
+    ::SkipBytes(source, padding);
+    ::CheckAvailable(source, count, elementSize);
+    return ArrayPrefix{count, sizeof(count) + sizeof(padding) + padding};
+}
+
+void ValidateAssetType(const nc::asset::NcaHeader& header, nc::asset::AssetType expectedType)
+{
+    if (nc::asset::GetAssetType(header) != expectedType)
     {
         throw nc::NcError(fmt::format(
-            "Unsupported compression algorithm: '{}'",
+            "Asset type mismatch actual: '{}' expected: '{}'",
+            header.magicNumber, static_cast<int>(expectedType)
+        ));
+    }
+}
+
+auto ReadHeader(std::istream& stream, std::string_view magicNumber) -> nc::asset::NcaHeader
+{
+    const auto header = nc::asset::DeserializeHeader(stream);
+    ::CheckSucceeded(stream);
+    ::ValidateHeader(header, magicNumber);
+    return header;
+}
+
+auto ReadHeader(nc::asset::SpanReader& reader) -> nc::asset::NcaHeader
+{
+    auto header = nc::asset::NcaHeader{};
+    reader.ReadBytes(header.magicNumber, 4);
+    reader.ReadBytes(header.compressionAlgorithm, 4);
+    reader.Read(header.assetId);
+    reader.Read(header.size);
+    return header;
+}
+
+auto ReadHeader(nc::asset::SpanReader& reader, std::string_view magicNumber) -> nc::asset::NcaHeader
+{
+    const auto header = ::ReadHeader(reader);
+    ::ValidateHeader(header, magicNumber);
+    if (header.size > reader.Remaining())
+    {
+        throw nc::NcError(fmt::format(
+            "Asset blob size '{}' exceeds available data '{}'",
+            header.size, reader.Remaining()
+        ));
+    }
+
+    return header;
+}
+
+/** Views reference blob data in place, so they cannot be made over compressed assets. */
+auto ReadViewHeader(nc::asset::SpanReader& reader, std::string_view magicNumber) -> nc::asset::NcaHeader
+{
+    const auto header = ::ReadHeader(reader, magicNumber);
+    if (std::string_view{header.compressionAlgorithm} != nc::asset::CompressionAlgorithm::none)
+    {
+        throw nc::NcError(fmt::format(
+            "Cannot create a view over a compressed asset: '{}'",
             header.compressionAlgorithm
         ));
     }
+
+    return header;
+}
+
+auto ReadStored(std::istream& stream, const nc::asset::NcaHeader& header) -> std::vector<std::byte>
+{
+    auto stored = std::vector<std::byte>(header.size);
+    ::ReadBytes(stream, stored.data(), stored.size());
+    ::CheckSucceeded(stream);
+    return stored;
+}
+
+/**
+ * Read a blob directly from its source, or through a ChunkedReader if it is compressed. Compressed
+ * blobs are loaded whole, but only the chunks the reader touches are decompressed.
+ */
+template<class Source, class BlobReader>
+void ReadBlob(Source& source, const nc::asset::NcaHeader& header, BlobReader readBlob)
+{
+    if (std::string_view{header.compressionAlgorithm} == nc::asset::CompressionAlgorithm::none)
+    {
+        readBlob(source);
+        ::CheckSucceeded(source);
+        return;
+    }
+
+    if constexpr (std::is_same_v<Source, nc::asset::SpanReader>)
+    {
+        auto reader = nc::asset::ChunkedReader{source.template View<std::byte>(header.size), header.compressionAlgorithm};
+        readBlob(reader);
+    }
+    else
+    {
+        const auto stored = ::ReadStored(source, header);
+        auto reader = nc::asset::ChunkedReader{stored, header.compressionAlgorithm};
+        readBlob(reader);
+    }
 }
 
 template<class T>
-auto DeserializeImpl(std::istream& stream, std::string_view magicNumber) -> nc::asset::DeserializedResult<T>
+auto ReadArrayView(nc::asset::SpanReader& reader) -> std::span<const T>
+{
+    return reader.View<T>(::ReadArrayPrefix(reader, sizeof(T)).count);
+}
+
+/** Construct a value using the owning container's memory resource if the value is allocator-aware. */
+template<class T, class Owner>
+auto MakeFor(const Owner& owner) -> T
+{
+    if constexpr (std::is_constructible_v<T, std::pmr::memory_resource*>)
+    {
+        return T(owner.get_allocator().resource());
+    }
+    else
+    {
+        return T{};
+    }
+}
+
+template<class Source, class String>
+void ReadString(Source& source, String& out)
+{
+    out.resize(::ReadCount(source, 1));
+    ::ReadBytes(source, out.data(), out.size());
+}
+
+/** Read an array of trivially copyable elements, returning the number of bytes consumed. */
+template<class Source, class Vector>
+    requires std::is_trivially_copyable_v<typename Vector::value_type>
+auto ReadVector(Source& source, Vector& out) -> size_t
+{
+    using Element = typename Vector::value_type;
+    const auto prefix = ::ReadArrayPrefix(source, sizeof(Element));
+    out.resize(prefix.count);
+    ::ReadBytes(source, out.data(), out.size() * sizeof(Element));
+    return prefix.size + out.size() * sizeof(Element);
+}
+
+template<class Source, class Vector, class ElementReader>
+void ReadVector(Source& source, Vector& out, ElementReader readElement)
+{
+    using Element = typename Vector::value_type;
+    const auto count = ::ReadCount(source, 1);
+    if constexpr (std::is_constructible_v<Element, std::pmr::memory_resource*>)
+    {
+        // Default constructed elements would use the default resource, so build each from ours.
+        out.clear();
+        out.reserve(count);
+        for (auto i = size_t{0}; i < count; ++i)
+        {
+            auto element = ::MakeFor<Element>(out);
+            readElement(source, element);
+            out.push_back(std::move(element));
+        }
+    }
+    else
+    {
+        // Read in place so existing elements keep their own capacity.
+        out.resize(count);
+        for (auto& element : out)
+        {
+            readElement(source, element);
+        }
+    }
+}
+
+/** Nodes whose keys are read again are moved across and read in place, so their values keep their capacity. */
+template<class Source, class Map, class ValueReader>
+void ReadMap(Source& source, Map& out, ValueReader readValue)
+{
+    const auto count = ::ReadCount(source, 1);
+    auto previous = std::move(out);
+    out.clear();
+    out.reserve(count);
+    auto key = ::MakeFor<typename Map::key_type>(out);
+    for (auto i = size_t{0}; i < count; ++i)
+    {
+        ::ReadString(source, key);
+        if (auto node = previous.extract(key))
+        {
+            readValue(source, node.mapped());
+            out.insert(std::move(node));
+            continue;
+        }
+
+        auto value = ::MakeFor<typename Map::mapped_type>(out);
+        readValue(source, value);
+        out.emplace(key, std::move(value));
+    }
+}
+
+template<class Source, class Bone>
+void ReadVertexSpaceToBoneSpace(Source& source, Bone& out)
+{
+    ::ReadString(source, out.boneName);
+    ::Read(source, out.transformationMatrix);
+}
+
+template<class Source, class Bone>
+void ReadBoneSpaceToParentSpace(Source& source, Bone& out)
+{
+    ::ReadString(source, out.boneName);
+    ::Read(source, out.transformationMatrix);
+    ::Read(source, out.numChildren);
+    ::Read(source, out.indexOfFirstChild);
+}
+
+template<class Source, class Mesh>
+void ReadBonesData(Source& source, Mesh& mesh)
+{
+    auto hasValue = false;
+    ::Read(source, hasValue);
+    if (!hasValue)
+    {
+        mesh.bonesData.reset();
+        return;
+    }
+
+    using BonesData = typename decltype(mesh.bonesData)::value_type;
+    auto& bonesData = mesh.bonesData ? *mesh.bonesData : mesh.bonesData.emplace(::MakeFor<BonesData>(mesh.vertices));
+    ::ReadMap(source, bonesData.boneMapping, [](auto& in, uint32_t& index) { ::Read(in, index); });
+    ::ReadVector(source, bonesData.vertexSpaceToBoneSpace, [](auto& in, auto& bone) { ::ReadVertexSpaceToBoneSpace(in, bone); });
+    ::ReadVector(source, bonesData.boneSpaceToParentSpace, [](auto& in, auto& bone) { ::ReadBoneSpaceToParentSpace(in, bone); });
+}
+
+/** Read a mesh's bones section, returning the number of bytes consumed. */
+template<class Source, class Mesh>
+auto ReadMeshBonesSection(Source& source, Mesh& mesh) -> uint64_t
+{
+    const auto start = ::Tell(source);
+    ::ReadBonesData(source, mesh);
+    ::CheckSucceeded(source);
+    return ::Tell(source) - start;
+}
+
+template<class Source, class Frames>
+void ReadSkeletalAnimationFrames(Source& source, Frames& out)
+{
+    ::ReadVector(source, out.positionFrames);
+    ::ReadVector(source, out.rotationFrames);
+    ::ReadVector(source, out.scaleFrames);
+}
+
+template<class Source, class T>
+void ReadAudioClip(Source& source, T& out)
+{
+    ::Read(source, out.samplesPerChannel);
+    ::ReadVector(source, out.leftChannel);
+    ::ReadVector(source, out.rightChannel);
+}
+
+template<class Source, class T>
+void ReadConcaveCollider(Source& source, T& out)
+{
+    ::Read(source, out.extents);
+    ::Read(source, out.maxExtent);
+    ::ReadVector(source, out.triangles);
+}
+
+template<class Source, class T>
+void ReadCubeMap(Source& source, T& out)
+{
+    ::Read(source, out.faceSideLength);
+    ::ReadVector(source, out.pixelData);
+}
+
+template<class Source, class T>
+void ReadHullCollider(Source& source, T& out)
+{
+    ::Read(source, out.extents);
+    ::Read(source, out.maxExtent);
+    ::ReadVector(source, out.vertices);
+}
+
+/** Read a mesh's extents and section table, returning the table. */
+template<class Source, class T>
+auto ReadMeshPreamble(Source& source, T& out) -> nc::asset::MeshSectionTable
+{
+    auto sections = nc::asset::MeshSectionTable{};
+    ::Read(source, out.extents);
+    ::Read(source, out.maxExtent);
+    ::Read(source, sections);
+    ::CheckSucceeded(source);
+    if (sections.vertices < nc::asset::MeshSectionTable::endOffset ||
+        sections.indices < sections.vertices ||
+        sections.bones < sections.indices ||
+        sections.end < sections.bones)
+    {
+        throw nc::NcError(fmt::format(
+            "Invalid mesh section table vertices: '{}' indices: '{}' bones: '{}' end: '{}'",
+            sections.vertices, sections.indices, sections.bones, sections.end
+        ));
+    }
+
+    return sections;
+}
+
+/** Skip forward to a section, tracking the position within the blob. Sections are only ever approached from before. */
+template<class Source>
+void SeekMeshSection(Source& source, uint64_t& position, uint64_t sectionOffset)
+{
+    if (sectionOffset < position)
+    {
+        throw nc::NcError(fmt::format(
+            "Mesh section at '{}' overlaps the preceding section ending at '{}'",
+            sectionOffset, position
+        ));
+    }
+
+    ::SkipBytes(source, static_cast<size_t>(sectionOffset - position));
+    position = sectionOffset;
+}
+
+/** Read a mesh, optionally skipping its bones section. The source is left at the end of the blob either way. */
+template<class Source, class T>
+void ReadMesh(Source& source, T& out, bool readBones = true)
+{
+    const auto sections = ::ReadMeshPreamble(source, out);
+    auto position = uint64_t{nc::asset::MeshSectionTable::endOffset};
+    ::SeekMeshSection(source, position, sections.vertices);
+    position += ::ReadVector(source, out.vertices);
+    ::SeekMeshSection(source, position, sections.indices);
+    position += ::ReadVector(source, out.indices);
+    ::SeekMeshSection(source, position, sections.bones);
+    if (readBones)
+    {
+        position += ::ReadMeshBonesSection(source, out);
+    }
+    else
+    {
+        out.bonesData.reset();
+    }
+
+    ::SeekMeshSection(source, position, sections.end);
+}
+
+template<class Source>
+void ReadMeshIndices(Source& source, std::vector<uint32_t>& out)
+{
+    auto extents = nc::asset::Mesh{};
+    const auto sections = ::ReadMeshPreamble(source, extents);
+    auto position = uint64_t{nc::asset::MeshSectionTable::endOffset};
+    ::SeekMeshSection(source, position, sections.indices);
+    position += ::ReadVector(source, out);
+    ::SeekMeshSection(source, position, sections.end);
+}
+
+template<class Source>
+void ReadMeshVertexBlocks(Source& source, size_t count, const nc::asset::VertexLayout& layout, std::span<const std::span<std::byte>> streams)
+{
+    constexpr auto blockSize = size_t{256};
+    auto block = std::vector<nc::asset::MeshVertex>(std::min(count, blockSize));
+    for (auto converted = size_t{0}; converted < count; converted += block.size())
+    {
+        block.resize(std::min(count - converted, blockSize));
+        ::ReadBytes(source, block.data(), block.size() * sizeof(nc::asset::MeshVertex));
+        ::CheckSucceeded(source);
+        nc::asset::ConvertVertices(block, layout, streams, converted);
+    }
+}
+
+/** Convert a mesh's vertices into caller allocated streams, returning the vertex count. */
+template<class Source>
+auto ReadMeshVertices(Source& source, const nc::asset::VertexLayout& layout, const nc::asset::VertexStreamAllocator& allocate) -> size_t
+{
+    nc::asset::ValidateVertexLayout(layout);
+    auto mesh = nc::asset::Mesh{};
+    const auto sections = ::ReadMeshPreamble(source, mesh);
+    auto position = uint64_t{nc::asset::MeshSectionTable::endOffset};
+    ::SeekMeshSection(source, position, sections.vertices);
+    const auto prefix = ::ReadArrayPrefix(source, sizeof(nc::asset::MeshVertex));
+    position += prefix.size + prefix.count * sizeof(nc::asset::MeshVertex);
+
+    auto streams = std::vector<std::span<std::byte>>{};
+    streams.reserve(layout.strides.size());
+    for (auto i = size_t{0}; i < layout.strides.size(); ++i)
+    {
+        streams.push_back(allocate(i, nc::asset::GetVertexStreamSize(layout, i, prefix.count)));
+    }
+
+    if constexpr (std::is_same_v<Source, nc::asset::SpanReader>)
+    {
+        const auto bytes = source.template View<std::byte>(prefix.count * sizeof(nc::asset::MeshVertex));
+        if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(nc::asset::MeshVertex) == 0)
+        {
+            const auto vertices = std::span<const nc::asset::MeshVertex>{reinterpret_cast<const nc::asset::MeshVertex*>(bytes.data()), prefix.count};
+            nc::asset::ConvertVertices(vertices, layout, streams);
+        }
+        else
+        {
+            auto reader = nc::asset::SpanReader{bytes};
+            ::ReadMeshVertexBlocks(reader, prefix.count, layout, streams);
+        }
+    }
+    else
+    {
+        ::ReadMeshVertexBlocks(source, prefix.count, layout, streams);
+    }
+
+    ::SeekMeshSection(source, position, sections.end);
+    return prefix.count;
+}
+
+template<class Source>
+void ReadMeshBones(Source& source, std::optional<nc::asset::BonesData>& out)
+{
+    auto mesh = nc::asset::Mesh{};
+    const auto sections = ::ReadMeshPreamble(source, mesh);
+    auto position = uint64_t{nc::asset::MeshSectionTable::endOffset};
+    ::SeekMeshSection(source, position, sections.bones);
+    position += ::ReadMeshBonesSection(source, mesh);
+    ::SeekMeshSection(source, position, sections.end);
+    out = std::move(mesh.bonesData);
+}
+
+template<class Source, class T>
+void ReadSkeletalAnimation(Source& source, T& out)
+{
+    ::ReadString(source, out.name);
+    ::Read(source, out.durationInTicks);
+    ::Read(source, out.ticksPerSecond);
+    ::ReadMap(source, out.framesPerBone, [](auto& in, auto& frames) { ::ReadSkeletalAnimationFrames(in, frames); });
+}
+
+template<class Source, class T>
+void ReadTexture(Source& source, T& out)
+{
+    ::Read(source, out.width);
+    ::Read(source, out.height);
+    ::ReadVector(source, out.pixelData);
+}
+
+/** Read texture dimensions, leaving the source positioned at the first pixel. */
+template<class Source>
+auto ReadTextureExtent(Source& source) -> nc::asset::TextureRegion
+{
+    auto extent = nc::asset::TextureRegion{0u, 0u, 0u, 0u};
+    ::Read(source, extent.width);
+    ::Read(source, extent.height);
+    const auto pixelCount = ::ReadArrayPrefix(source, 1).count;
+    if (pixelCount != size_t{extent.width} * extent.height * nc::asset::Texture::numChannels)
+    {
+        throw nc::NcError(fmt::format(
+            "Texture pixel count '{}' does not match dimensions {}x{}",
+            pixelCount, extent.width, extent.height
+        ));
+    }
+
+    return extent;
+}
+
+/**
+ * Read a sub-rectangle of texture pixels, skipping over data outside of it. Whole rows
+ * are read with a single call, and the source is left at the end of the blob.
+ */
+template<class Source>
+void ReadTextureRegion(Source& source, const nc::asset::TextureRegion& extent, const nc::asset::TextureRegion& region, nc::asset::Texture& out)
+{
+    if (uint64_t{region.x} + region.width > extent.width || uint64_t{region.y} + region.height > extent.height)
+    {
+        throw nc::NcError(fmt::format(
+            "Texture region ({}, {}, {}x{}) is outside of texture bounds {}x{}",
+            region.x, region.y, region.width, region.height, extent.width, extent.height
+        ));
+    }
+
+    constexpr auto pixelSize = size_t{nc::asset::Texture::numChannels};
+    const auto sourceRowSize = size_t{extent.width} * pixelSize;
+    const auto regionRowSize = size_t{region.width} * pixelSize;
+    out.width = region.width;
+    out.height = region.height;
+    out.pixelData.resize(regionRowSize * region.height);
+
+    auto position = size_t{0};
+    if (!out.pixelData.empty())
+    {
+        position = size_t{region.y} * sourceRowSize + size_t{region.x} * pixelSize;
+        ::SkipBytes(source, position);
+        if (regionRowSize == sourceRowSize)
+        {
+            ::ReadBytes(source, out.pixelData.data(), out.pixelData.size());
+            position += out.pixelData.size();
+        }
+        else
+        {
+            for (auto row = size_t{0}; row < region.height; ++row)
+            {
+                if (row != 0)
+                {
+                    ::SkipBytes(source, sourceRowSize - regionRowSize);
+                    position += sourceRowSize - regionRowSize;
+                }
+
+                ::ReadBytes(source, out.pixelData.data() + row * regionRowSize, regionRowSize);
+                position += regionRowSize;
+            }
+        }
+    }
+
+    ::SkipBytes(source, sourceRowSize * extent.height - position);
+    ::CheckSucceeded(source);
+}
+
+template<class Source>
+auto DeserializeTextureRegion(Source& source, const nc::asset::TextureRegion& region) -> nc::asset::DeserializedResult<nc::asset::Texture>
+{
+    auto result = nc::asset::DeserializedResult<nc::asset::Texture>{};
+    result.header = ::ReadHeader(source, nc::asset::MagicNumber::texture);
+    ::ReadBlob(source, result.header, [&](auto& blob)
+    {
+        const auto extent = ::ReadTextureExtent(blob);
+        ::ReadTextureRegion(blob, extent, region, result.asset);
+    });
+
+    return result;
+}
+
+template<class Source>
+auto DeserializeTextureRows(Source& source, uint32_t firstRow, uint32_t rowCount) -> nc::asset::DeserializedResult<nc::asset::Texture>
+{
+    auto result = nc::asset::DeserializedResult<nc::asset::Texture>{};
+    result.header = ::ReadHeader(source, nc::asset::MagicNumber::texture);
+    ::ReadBlob(source, result.header, [&](auto& blob)
+    {
+        const auto extent = ::ReadTextureExtent(blob);
+        ::ReadTextureRegion(blob, extent, nc::asset::TextureRegion{0u, firstRow, extent.width, rowCount}, result.asset);
+    });
+
+    return result;
+}
+
+template<class Source, class T, class PartReader>
+auto DeserializeMeshPart(Source& source, PartReader readPart) -> nc::asset::DeserializedResult<T>
 {
     auto result = nc::asset::DeserializedResult<T>{};
-    result.header = nc::asset::DeserializeHeader(stream);
-    ::ValidateHeader(result.header, magicNumber);
-    nc::serialize::Deserialize(stream, result.asset);
+    result.header = ::ReadHeader(source, nc::asset::MagicNumber::mesh);
+    ::ReadBlob(source, result.header, [&](auto& blob) { readPart(blob, result.asset); });
+    return result;
+}
+
+template<class Source, class T, class AssetReader>
+auto DeserializeInto(Source& source, std::string_view magicNumber, T& asset, AssetReader readAsset) -> nc::asset::NcaHeader
+{
+    const auto header = ::ReadHeader(source, magicNumber);
+    ::ReadBlob(source, header, [&](auto& blob) { readAsset(blob, asset); });
+    return header;
+}
+
+/** Read the blob of whichever asset type the header names. Shaders and fonts cannot be imported. */
+template<class Source>
+auto ReadAnyAsset(Source& source, const nc::asset::NcaHeader& header) -> nc::asset::AnyAsset
+{
+    const auto read = [&](auto asset, auto readAsset) -> nc::asset::AnyAsset
+    {
+        ::ReadBlob(source, header, [&](auto& blob) { readAsset(blob, asset); });
+        return asset;
+    };
+
+    switch (nc::asset::GetAssetType(header))
+    {
+        case nc::asset::AssetType::AudioClip:
+            return read(nc::asset::AudioClip{}, [](auto& in, auto& out) { ::ReadAudioClip(in, out); });
+        case nc::asset::AssetType::ConcaveCollider:
+            return read(nc::asset::ConcaveCollider{}, [](auto& in, auto& out) { ::ReadConcaveCollider(in, out); });
+        case nc::asset::AssetType::CubeMap:
+            return read(nc::asset::CubeMap{}, [](auto& in, auto& out) { ::ReadCubeMap(in, out); });
+        case nc::asset::AssetType::HullCollider:
+            return read(nc::asset::HullCollider{}, [](auto& in, auto& out) { ::ReadHullCollider(in, out); });
+        case nc::asset::AssetType::Mesh:
+            return read(nc::asset::Mesh{}, [](auto& in, auto& out) { ::ReadMesh(in, out); });
+        case nc::asset::AssetType::SkeletalAnimation:
+            return read(nc::asset::SkeletalAnimation{}, [](auto& in, auto& out) { ::ReadSkeletalAnimation(in, out); });
+        case nc::asset::AssetType::Texture:
+            return read(nc::asset::Texture{}, [](auto& in, auto& out) { ::ReadTexture(in, out); });
+        case nc::asset::AssetType::Shader:
+        case nc::asset::AssetType::Font:
+            break;
+    }
+
+    throw nc::NcError("Cannot import asset with magic number: ", header.magicNumber);
+}
+
+template<class Source, class T, class AssetReader>
+auto DeserializeNew(Source& source, std::string_view magicNumber, T asset, AssetReader readAsset) -> nc::asset::DeserializedResult<T>
+{
+    auto result = nc::asset::DeserializedResult<T>{nc::asset::NcaHeader{}, std::move(asset)};
+    result.header = ::DeserializeInto(source, magicNumber, result.asset, readAsset);
     return result;
 }
 } // anonymous namespace
 
 namespace nc::asset
 {
+auto OpenNca(const std::filesystem::path& ncaPath) -> std::ifstream
+{
+    if (!std::filesystem::is_regular_file(ncaPath))
+    {
+        throw nc::NcError("File does not exist: ", ncaPath.string());
+    }
+
+    auto file = std::ifstream{ncaPath, std::ios::binary};
+    if (!file.is_open())
+    {
+        throw nc::NcError("Could not open file: ", ncaPath.string());
+    }
+
+    return file;
+}
+
 auto DeserializeHeader(std::istream& stream) -> NcaHeader
 {
     auto header = nc::asset::NcaHeader{};
@@ -49,38 +776,466 @@ auto DeserializeHeader(std::istream& stream) -> NcaHeader
     return header;
 }
 
+auto DeserializeHeader(std::span<const std::byte> bytes) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::ReadHeader(reader);
+}
+
+auto DeserializeAny(std::istream& stream) -> DeserializedResult<AnyAsset>
+{
+    const auto header = DeserializeHeader(stream);
+    ::CheckSucceeded(stream);
+    ::ValidateCompression(header);
+    return DeserializedResult<AnyAsset>{header, ::ReadAnyAsset(stream, header)};
+}
+
+auto DeserializeAny(std::istream& stream, AssetType expectedType) -> DeserializedResult<AnyAsset>
+{
+    const auto header = DeserializeHeader(stream);
+    ::CheckSucceeded(stream);
+    ::ValidateAssetType(header, expectedType);
+    ::ValidateCompression(header);
+    return DeserializedResult<AnyAsset>{header, ::ReadAnyAsset(stream, header)};
+}
+
 auto DeserializeAudioClip(std::istream& stream) -> DeserializedResult<AudioClip>
 {
-    return DeserializeImpl<AudioClip>(stream, MagicNumber::audioClip);
+    auto result = DeserializedResult<AudioClip>{};
+    result.header = DeserializeAudioClip(stream, result.asset);
+    return result;
 }
 
 auto DeserializeConcaveCollider(std::istream& stream) -> DeserializedResult<ConcaveCollider>
 {
-    return DeserializeImpl<ConcaveCollider>(stream, MagicNumber::concaveCollider);
+    auto result = DeserializedResult<ConcaveCollider>{};
+    result.header = DeserializeConcaveCollider(stream, result.asset);
+    return result;
 }
 
 auto DeserializeCubeMap(std::istream& stream) -> DeserializedResult<CubeMap>
 {
-    return DeserializeImpl<CubeMap>(stream, MagicNumber::cubeMap);
+    auto result = DeserializedResult<CubeMap>{};
+    result.header = DeserializeCubeMap(stream, result.asset);
+    return result;
 }
 
 auto DeserializeHullCollider(std::istream& stream) -> DeserializedResult<HullCollider>
 {
-    return DeserializeImpl<HullCollider>(stream, MagicNumber::hullCollider);
+    auto result = DeserializedResult<HullCollider>{};
+    result.header = DeserializeHullCollider(stream, result.asset);
+    return result;
 }
 
 auto DeserializeMesh(std::istream& stream) -> DeserializedResult<Mesh>
 {
-    return DeserializeImpl<Mesh>(stream, MagicNumber::mesh);
+    auto result = DeserializedResult<Mesh>{};
+    result.header = DeserializeMesh(stream, result.asset);
+    return result;
 }
 
 auto DeserializeSkeletalAnimation(std::istream& stream) -> DeserializedResult<SkeletalAnimation>
 {
-    return DeserializeImpl<SkeletalAnimation>(stream, MagicNumber::skeletalAnimation);
+    auto result = DeserializedResult<SkeletalAnimation>{};
+    result.header = DeserializeSkeletalAnimation(stream, result.asset);
+    return result;
 }
 
 auto DeserializeTexture(std::istream& stream) -> DeserializedResult<Texture>
 {
-    return DeserializeImpl<Texture>(stream, MagicNumber::texture);
+    auto result = DeserializedResult<Texture>{};
+    result.header = DeserializeTexture(stream, result.asset);
+    return result;
+}
+
+auto DeserializeAudioClip(std::istream& stream, AudioClip& asset) -> NcaHeader
+{
+    return ::DeserializeInto(stream, MagicNumber::audioClip, asset, [](auto& in, auto& out) { ::ReadAudioClip(in, out); });
+}
+
+auto DeserializeConcaveCollider(std::istream& stream, ConcaveCollider& asset) -> NcaHeader
+{
+    return ::DeserializeInto(stream, MagicNumber::concaveCollider, asset, [](auto& in, auto& out) { ::ReadConcaveCollider(in, out); });
+}
+
+auto DeserializeCubeMap(std::istream& stream, CubeMap& asset) -> NcaHeader
+{
+    return ::DeserializeInto(stream, MagicNumber::cubeMap, asset, [](auto& in, auto& out) { ::ReadCubeMap(in, out); });
+}
+
+auto DeserializeHullCollider(std::istream& stream, HullCollider& asset) -> NcaHeader
+{
+    return ::DeserializeInto(stream, MagicNumber::hullCollider, asset, [](auto& in, auto& out) { ::ReadHullCollider(in, out); });
+}
+
+auto DeserializeMesh(std::istream& stream, Mesh& asset) -> NcaHeader
+{
+    return ::DeserializeInto(stream, MagicNumber::mesh, asset, [](auto& in, auto& out) { ::ReadMesh(in, out); });
+}
+
+auto DeserializeSkeletalAnimation(std::istream& stream, SkeletalAnimation& asset) -> NcaHeader
+{
+    return ::DeserializeInto(stream, MagicNumber::skeletalAnimation, asset, [](auto& in, auto& out) { ::ReadSkeletalAnimation(in, out); });
+}
+
+auto DeserializeTexture(std::istream& stream, Texture& asset) -> NcaHeader
+{
+    return ::DeserializeInto(stream, MagicNumber::texture, asset, [](auto& in, auto& out) { ::ReadTexture(in, out); });
+}
+
+auto DeserializeAsset(std::istream& stream, AudioClip& asset) -> NcaHeader
+{
+    return DeserializeAudioClip(stream, asset);
+}
+
+auto DeserializeAsset(std::istream& stream, ConcaveCollider& asset) -> NcaHeader
+{
+    return DeserializeConcaveCollider(stream, asset);
+}
+
+auto DeserializeAsset(std::istream& stream, CubeMap& asset) -> NcaHeader
+{
+    return DeserializeCubeMap(stream, asset);
+}
+
+auto DeserializeAsset(std::istream& stream, HullCollider& asset) -> NcaHeader
+{
+    return DeserializeHullCollider(stream, asset);
+}
+
+auto DeserializeAsset(std::istream& stream, Mesh& asset) -> NcaHeader
+{
+    return DeserializeMesh(stream, asset);
+}
+
+auto DeserializeAsset(std::istream& stream, SkeletalAnimation& asset) -> NcaHeader
+{
+    return DeserializeSkeletalAnimation(stream, asset);
+}
+
+auto DeserializeAsset(std::istream& stream, Texture& asset) -> NcaHeader
+{
+    return DeserializeTexture(stream, asset);
+}
+
+auto DeserializeAudioClip(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::AudioClip>
+{
+    return ::DeserializeNew(stream, MagicNumber::audioClip, pmr::AudioClip{resource}, [](auto& in, auto& out) { ::ReadAudioClip(in, out); });
+}
+
+auto DeserializeConcaveCollider(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::ConcaveCollider>
+{
+    return ::DeserializeNew(stream, MagicNumber::concaveCollider, pmr::ConcaveCollider{resource}, [](auto& in, auto& out) { ::ReadConcaveCollider(in, out); });
+}
+
+auto DeserializeCubeMap(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::CubeMap>
+{
+    return ::DeserializeNew(stream, MagicNumber::cubeMap, pmr::CubeMap{resource}, [](auto& in, auto& out) { ::ReadCubeMap(in, out); });
+}
+
+auto DeserializeHullCollider(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::HullCollider>
+{
+    return ::DeserializeNew(stream, MagicNumber::hullCollider, pmr::HullCollider{resource}, [](auto& in, auto& out) { ::ReadHullCollider(in, out); });
+}
+
+auto DeserializeMesh(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Mesh>
+{
+    return ::DeserializeNew(stream, MagicNumber::mesh, pmr::Mesh{resource}, [](auto& in, auto& out) { ::ReadMesh(in, out); });
+}
+
+auto DeserializeSkeletalAnimation(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::SkeletalAnimation>
+{
+    return ::DeserializeNew(stream, MagicNumber::skeletalAnimation, pmr::SkeletalAnimation{resource}, [](auto& in, auto& out) { ::ReadSkeletalAnimation(in, out); });
+}
+
+auto DeserializeTexture(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Texture>
+{
+    return ::DeserializeNew(stream, MagicNumber::texture, pmr::Texture{resource}, [](auto& in, auto& out) { ::ReadTexture(in, out); });
+}
+
+auto DeserializeAny(std::span<const std::byte> bytes) -> DeserializedResult<AnyAsset>
+{
+    auto reader = SpanReader{bytes};
+    const auto header = ::ReadHeader(reader, DeserializeHeader(bytes).magicNumber);
+    return DeserializedResult<AnyAsset>{header, ::ReadAnyAsset(reader, header)};
+}
+
+auto DeserializeAny(std::span<const std::byte> bytes, AssetType expectedType) -> DeserializedResult<AnyAsset>
+{
+    auto reader = SpanReader{bytes};
+    const auto header = ::ReadHeader(reader, DeserializeHeader(bytes).magicNumber);
+    ::ValidateAssetType(header, expectedType);
+    return DeserializedResult<AnyAsset>{header, ::ReadAnyAsset(reader, header)};
+}
+
+auto DeserializeAudioClip(std::span<const std::byte> bytes) -> DeserializedResult<AudioClip>
+{
+    auto result = DeserializedResult<AudioClip>{};
+    result.header = DeserializeAudioClip(bytes, result.asset);
+    return result;
+}
+
+auto DeserializeConcaveCollider(std::span<const std::byte> bytes) -> DeserializedResult<ConcaveCollider>
+{
+    auto result = DeserializedResult<ConcaveCollider>{};
+    result.header = DeserializeConcaveCollider(bytes, result.asset);
+    return result;
+}
+
+auto DeserializeCubeMap(std::span<const std::byte> bytes) -> DeserializedResult<CubeMap>
+{
+    auto result = DeserializedResult<CubeMap>{};
+    result.header = DeserializeCubeMap(bytes, result.asset);
+    return result;
+}
+
+auto DeserializeHullCollider(std::span<const std::byte> bytes) -> DeserializedResult<HullCollider>
+{
+    auto result = DeserializedResult<HullCollider>{};
+    result.header = DeserializeHullCollider(bytes, result.asset);
+    return result;
+}
+
+auto DeserializeMesh(std::span<const std::byte> bytes) -> DeserializedResult<Mesh>
+{
+    auto result = DeserializedResult<Mesh>{};
+    result.header = DeserializeMesh(bytes, result.asset);
+    return result;
+}
+
+auto DeserializeSkeletalAnimation(std::span<const std::byte> bytes) -> DeserializedResult<SkeletalAnimation>
+{
+    auto result = DeserializedResult<SkeletalAnimation>{};
+    result.header = DeserializeSkeletalAnimation(bytes, result.asset);
+    return result;
+}
+
+auto DeserializeTexture(std::span<const std::byte> bytes) -> DeserializedResult<Texture>
+{
+    auto result = DeserializedResult<Texture>{};
+    result.header = DeserializeTexture(bytes, result.asset);
+    return result;
+}
+
+auto DeserializeAudioClip(std::span<const std::byte> bytes, AudioClip& asset) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeInto(reader, MagicNumber::audioClip, asset, [](auto& in, auto& out) { ::ReadAudioClip(in, out); });
+}
+
+auto DeserializeConcaveCollider(std::span<const std::byte> bytes, ConcaveCollider& asset) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeInto(reader, MagicNumber::concaveCollider, asset, [](auto& in, auto& out) { ::ReadConcaveCollider(in, out); });
+}
+
+auto DeserializeCubeMap(std::span<const std::byte> bytes, CubeMap& asset) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeInto(reader, MagicNumber::cubeMap, asset, [](auto& in, auto& out) { ::ReadCubeMap(in, out); });
+}
+
+auto DeserializeHullCollider(std::span<const std::byte> bytes, HullCollider& asset) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeInto(reader, MagicNumber::hullCollider, asset, [](auto& in, auto& out) { ::ReadHullCollider(in, out); });
+}
+
+auto DeserializeMesh(std::span<const std::byte> bytes, Mesh& asset) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeInto(reader, MagicNumber::mesh, asset, [](auto& in, auto& out) { ::ReadMesh(in, out); });
+}
+
+auto DeserializeSkeletalAnimation(std::span<const std::byte> bytes, SkeletalAnimation& asset) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeInto(reader, MagicNumber::skeletalAnimation, asset, [](auto& in, auto& out) { ::ReadSkeletalAnimation(in, out); });
+}
+
+auto DeserializeTexture(std::span<const std::byte> bytes, Texture& asset) -> NcaHeader
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeInto(reader, MagicNumber::texture, asset, [](auto& in, auto& out) { ::ReadTexture(in, out); });
+}
+
+auto DeserializeAudioClip(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::AudioClip>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeNew(reader, MagicNumber::audioClip, pmr::AudioClip{resource}, [](auto& in, auto& out) { ::ReadAudioClip(in, out); });
+}
+
+auto DeserializeConcaveCollider(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::ConcaveCollider>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeNew(reader, MagicNumber::concaveCollider, pmr::ConcaveCollider{resource}, [](auto& in, auto& out) { ::ReadConcaveCollider(in, out); });
+}
+
+auto DeserializeCubeMap(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::CubeMap>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeNew(reader, MagicNumber::cubeMap, pmr::CubeMap{resource}, [](auto& in, auto& out) { ::ReadCubeMap(in, out); });
+}
+
+auto DeserializeHullCollider(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::HullCollider>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeNew(reader, MagicNumber::hullCollider, pmr::HullCollider{resource}, [](auto& in, auto& out) { ::ReadHullCollider(in, out); });
+}
+
+auto DeserializeMesh(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Mesh>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeNew(reader, MagicNumber::mesh, pmr::Mesh{resource}, [](auto& in, auto& out) { ::ReadMesh(in, out); });
+}
+
+auto DeserializeSkeletalAnimation(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::SkeletalAnimation>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeNew(reader, MagicNumber::skeletalAnimation, pmr::SkeletalAnimation{resource}, [](auto& in, auto& out) { ::ReadSkeletalAnimation(in, out); });
+}
+
+auto DeserializeTexture(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Texture>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeNew(reader, MagicNumber::texture, pmr::Texture{resource}, [](auto& in, auto& out) { ::ReadTexture(in, out); });
+}
+
+auto DeserializeTextureRegion(std::istream& stream, const TextureRegion& region) -> DeserializedResult<Texture>
+{
+    return ::DeserializeTextureRegion(stream, region);
+}
+
+auto DeserializeTextureRegion(std::span<const std::byte> bytes, const TextureRegion& region) -> DeserializedResult<Texture>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeTextureRegion(reader, region);
+}
+
+auto DeserializeTextureRows(std::istream& stream, uint32_t firstRow, uint32_t rowCount) -> DeserializedResult<Texture>
+{
+    return ::DeserializeTextureRows(stream, firstRow, rowCount);
+}
+
+auto DeserializeTextureRows(std::span<const std::byte> bytes, uint32_t firstRow, uint32_t rowCount) -> DeserializedResult<Texture>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeTextureRows(reader, firstRow, rowCount);
+}
+
+auto DeserializeMeshWithoutBones(std::istream& stream) -> DeserializedResult<Mesh>
+{
+    return ::DeserializeMeshPart<std::istream, Mesh>(stream, [](auto& in, auto& out) { ::ReadMesh(in, out, false); });
+}
+
+auto DeserializeMeshWithoutBones(std::span<const std::byte> bytes) -> DeserializedResult<Mesh>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeMeshPart<SpanReader, Mesh>(reader, [](auto& in, auto& out) { ::ReadMesh(in, out, false); });
+}
+
+auto DeserializeMeshIndices(std::istream& stream) -> DeserializedResult<std::vector<uint32_t>>
+{
+    return ::DeserializeMeshPart<std::istream, std::vector<uint32_t>>(stream, [](auto& in, auto& out) { ::ReadMeshIndices(in, out); });
+}
+
+auto DeserializeMeshIndices(std::span<const std::byte> bytes) -> DeserializedResult<std::vector<uint32_t>>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeMeshPart<SpanReader, std::vector<uint32_t>>(reader, [](auto& in, auto& out) { ::ReadMeshIndices(in, out); });
+}
+
+auto DeserializeMeshBones(std::istream& stream) -> DeserializedResult<std::optional<BonesData>>
+{
+    return ::DeserializeMeshPart<std::istream, std::optional<BonesData>>(stream, [](auto& in, auto& out) { ::ReadMeshBones(in, out); });
+}
+
+auto DeserializeMeshBones(std::span<const std::byte> bytes) -> DeserializedResult<std::optional<BonesData>>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeMeshPart<SpanReader, std::optional<BonesData>>(reader, [](auto& in, auto& out) { ::ReadMeshBones(in, out); });
+}
+
+auto DeserializeMeshVertices(std::istream& stream, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> DeserializedResult<size_t>
+{
+    return ::DeserializeMeshPart<std::istream, size_t>(stream, [&](auto& in, auto& out) { out = ::ReadMeshVertices(in, layout, allocate); });
+}
+
+auto DeserializeMeshVertices(std::span<const std::byte> bytes, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> DeserializedResult<size_t>
+{
+    auto reader = SpanReader{bytes};
+    return ::DeserializeMeshPart<SpanReader, size_t>(reader, [&](auto& in, auto& out) { out = ::ReadMeshVertices(in, layout, allocate); });
+}
+
+auto DeserializeAudioClipView(std::span<const std::byte> bytes) -> DeserializedResult<AudioClipView>
+{
+    auto reader = SpanReader{bytes};
+    auto result = DeserializedResult<AudioClipView>{};
+    result.header = ::ReadViewHeader(reader, MagicNumber::audioClip);
+    reader.Read(result.asset.samplesPerChannel);
+    result.asset.leftChannel = ::ReadArrayView<double>(reader);
+    result.asset.rightChannel = ::ReadArrayView<double>(reader);
+    return result;
+}
+
+auto DeserializeConcaveColliderView(std::span<const std::byte> bytes) -> DeserializedResult<ConcaveColliderView>
+{
+    auto reader = SpanReader{bytes};
+    auto result = DeserializedResult<ConcaveColliderView>{};
+    result.header = ::ReadViewHeader(reader, MagicNumber::concaveCollider);
+    reader.Read(result.asset.extents);
+    reader.Read(result.asset.maxExtent);
+    result.asset.triangles = ::ReadArrayView<Triangle>(reader);
+    return result;
+}
+
+auto DeserializeCubeMapView(std::span<const std::byte> bytes) -> DeserializedResult<CubeMapView>
+{
+    auto reader = SpanReader{bytes};
+    auto result = DeserializedResult<CubeMapView>{};
+    result.header = ::ReadViewHeader(reader, MagicNumber::cubeMap);
+    reader.Read(result.asset.faceSideLength);
+    result.asset.pixelData = ::ReadArrayView<unsigned char>(reader);
+    return result;
+}
+
+auto DeserializeHullColliderView(std::span<const std::byte> bytes) -> DeserializedResult<HullColliderView>
+{
+    auto reader = SpanReader{bytes};
+    auto result = DeserializedResult<HullColliderView>{};
+    result.header = ::ReadViewHeader(reader, MagicNumber::hullCollider);
+    reader.Read(result.asset.extents);
+    reader.Read(result.asset.maxExtent);
+    result.asset.vertices = ::ReadArrayView<Vector3>(reader);
+    return result;
+}
+
+auto DeserializeMeshView(std::span<const std::byte> bytes) -> DeserializedResult<MeshView>
+{
+    auto reader = SpanReader{bytes};
+    auto result = DeserializedResult<MeshView>{};
+    result.header = ::ReadViewHeader(reader, MagicNumber::mesh);
+    const auto sections = ::ReadMeshPreamble(reader, result.asset);
+    auto position = uint64_t{MeshSectionTable::endOffset};
+    ::SeekMeshSection(reader, position, sections.vertices);
+    result.asset.vertices = ::ReadArrayView<MeshVertex>(reader);
+    position = reader.Position() - NcaHeader::binarySize;
+    ::SeekMeshSection(reader, position, sections.indices);
+    result.asset.indices = ::ReadArrayView<uint32_t>(reader);
+    position = reader.Position() - NcaHeader::binarySize;
+    ::SeekMeshSection(reader, position, sections.bones);
+    ::ReadBonesData(reader, result.asset);
+    return result;
+}
+
+auto DeserializeTextureView(std::span<const std::byte> bytes) -> DeserializedResult<TextureView>
+{
+    auto reader = SpanReader{bytes};
+    auto result = DeserializedResult<TextureView>{};
+    result.header = ::ReadViewHeader(reader, MagicNumber::texture);
+    reader.Read(result.asset.width);
+    reader.Read(result.asset.height);
+    result.asset.pixelData = ::ReadArrayView<unsigned char>(reader);
+    return result;
 }
 } // namespace nc::asset
@@ -1,24 +1,44 @@
 #pragma once
 
 #include "ncasset/NcaHeader.h"
+#include "ncasset/Assets.h"
 #include "ncasset/AssetsFwd.h"
 #include "ncasset/AssetType.h"
+#include "ncasset/VertexLayout.h"
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <iosfwd>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace nc::asset
 {
-/** @brief A header and asset pair returned from a deserialize operation. */
-template<class AssetType>
-struct DeserializedResult
-{
-    NcaHeader header;
-    AssetType asset;
-};
+struct AudioClipView;
+struct ConcaveColliderView;
+struct CubeMapView;
+struct HullColliderView;
+struct MeshView;
+struct TextureView;
+
+/** @brief Open an .nca file for binary reading. Throws if the file does not exist or cannot be opened. */
+auto OpenNca(const std::filesystem::path& ncaPath) -> std::ifstream;
 
 /** @brief Read an NcaHeader from a binary stream. */
 auto DeserializeHeader(std::istream& stream) -> NcaHeader;
 
+/**
+ * @brief Construct an asset of whichever type its header names from data in a binary stream.
+ * @note The header is only read once. Throws for shaders, fonts, and unknown magic numbers.
+ */
+auto DeserializeAny(std::istream& stream) -> DeserializedResult<AnyAsset>;
+
+/** @brief Construct an asset from data in a binary stream, throwing before the blob is read if its header names another type. */
+auto DeserializeAny(std::istream& stream, AssetType expectedType) -> DeserializedResult<AnyAsset>;
+
 /** @brief Construct an AudioClip from data in a binary stream. */
 auto DeserializeAudioClip(std::istream& stream) -> DeserializedResult<AudioClip>;
 
@@ -39,4 +59,192 @@ auto DeserializeSkeletalAnimation(std::istream& stream) -> DeserializedResult<Sk
 
 /** @brief Construct a Texture from data in a binary stream. */
 auto DeserializeTexture(std::istream& stream) -> DeserializedResult<Texture>;
+
+/** @brief Read an AudioClip from a binary stream into an existing object, reusing its capacity. */
+auto DeserializeAudioClip(std::istream& stream, AudioClip& asset) -> NcaHeader;
+
+/** @brief Read a ConcaveCollider from a binary stream into an existing object, reusing its capacity. */
+auto DeserializeConcaveCollider(std::istream& stream, ConcaveCollider& asset) -> NcaHeader;
+
+/** @brief Read a CubeMap from a binary stream into an existing object, reusing its capacity. */
+auto DeserializeCubeMap(std::istream& stream, CubeMap& asset) -> NcaHeader;
+
+/** @brief Read a HullCollider from a binary stream into an existing object, reusing its capacity. */
+auto DeserializeHullCollider(std::istream& stream, HullCollider& asset) -> NcaHeader;
+
+/** @brief Read a Mesh from a binary stream into an existing object, reusing its capacity. */
+auto DeserializeMesh(std::istream& stream, Mesh& asset) -> NcaHeader;
+
+/** @brief Read a SkeletalAnimation from a binary stream into an existing object, reusing its capacity. */
+auto DeserializeSkeletalAnimation(std::istream& stream, SkeletalAnimation& asset) -> NcaHeader;
+
+/** @brief Read a Texture from a binary stream into an existing object, reusing its capacity. */
+auto DeserializeTexture(std::istream& stream, Texture& asset) -> NcaHeader;
+
+/** @brief Read any supported asset from a binary stream into an existing object, choosing the reader by type. */
+auto DeserializeAsset(std::istream& stream, AudioClip& asset) -> NcaHeader;
+auto DeserializeAsset(std::istream& stream, ConcaveCollider& asset) -> NcaHeader;
+auto DeserializeAsset(std::istream& stream, CubeMap& asset) -> NcaHeader;
+auto DeserializeAsset(std::istream& stream, HullCollider& asset) -> NcaHeader;
+auto DeserializeAsset(std::istream& stream, Mesh& asset) -> NcaHeader;
+auto DeserializeAsset(std::istream& stream, SkeletalAnimation& asset) -> NcaHeader;
+auto DeserializeAsset(std::istream& stream, Texture& asset) -> NcaHeader;
+
+/** @brief Construct an AudioClip from data in a binary stream, allocating from a memory resource. */
+auto DeserializeAudioClip(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::AudioClip>;
+
+/** @brief Construct a ConcaveCollider from data in a binary stream, allocating from a memory resource. */
+auto DeserializeConcaveCollider(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::ConcaveCollider>;
+
+/** @brief Construct a CubeMap from data in a binary stream, allocating from a memory resource. */
+auto DeserializeCubeMap(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::CubeMap>;
+
+/** @brief Construct a HullCollider from data in a binary stream, allocating from a memory resource. */
+auto DeserializeHullCollider(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::HullCollider>;
+
+/** @brief Construct a Mesh from data in a binary stream, allocating from a memory resource. */
+auto DeserializeMesh(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Mesh>;
+
+/** @brief Construct a SkeletalAnimation from data in a binary stream, allocating from a memory resource. */
+auto DeserializeSkeletalAnimation(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::SkeletalAnimation>;
+
+/** @brief Construct a Texture from data in a binary stream, allocating from a memory resource. */
+auto DeserializeTexture(std::istream& stream, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Texture>;
+
+/** @brief Read an NcaHeader from the start of a range of bytes. */
+auto DeserializeHeader(std::span<const std::byte> bytes) -> NcaHeader;
+
+/** @brief Construct an asset of whichever type its header names from data in memory. */
+auto DeserializeAny(std::span<const std::byte> bytes) -> DeserializedResult<AnyAsset>;
+
+/** @brief Construct an asset from data in memory, throwing before the blob is read if its header names another type. */
+auto DeserializeAny(std::span<const std::byte> bytes, AssetType expectedType) -> DeserializedResult<AnyAsset>;
+
+/** @brief Construct an AudioClip from data in memory. */
+auto DeserializeAudioClip(std::span<const std::byte> bytes) -> DeserializedResult<AudioClip>;
+
+/** @brief Construct a ConcaveCollider from data in memory. */
+auto DeserializeConcaveCollider(std::span<const std::byte> bytes) -> DeserializedResult<ConcaveCollider>;
+
+/** @brief Construct a CubeMap from data in memory. */
+auto DeserializeCubeMap(std::span<const std::byte> bytes) -> DeserializedResult<CubeMap>;
+
+/** @brief Construct a HullCollider from data in memory. */
+auto DeserializeHullCollider(std::span<const std::byte> bytes) -> DeserializedResult<HullCollider>;
+
+/** @brief Construct a Mesh from data in memory. */
+auto DeserializeMesh(std::span<const std::byte> bytes) -> DeserializedResult<Mesh>;
+
+/** @brief Construct a SkeletalAnimation from data in memory. */
+auto DeserializeSkeletalAnimation(std::span<const std::byte> bytes) -> DeserializedResult<SkeletalAnimation>;
+
+/** @brief Construct a Texture from data in memory. */
+auto DeserializeTexture(std::span<const std::byte> bytes) -> DeserializedResult<Texture>;
+
+/** @brief Read an AudioClip from data in memory into an existing object, reusing its capacity. */
+auto DeserializeAudioClip(std::span<const std::byte> bytes, AudioClip& asset) -> NcaHeader;
+
+/** @brief Read a ConcaveCollider from data in memory into an existing object, reusing its capacity. */
+auto DeserializeConcaveCollider(std::span<const std::byte> bytes, ConcaveCollider& asset) -> NcaHeader;
+
+/** @brief Read a CubeMap from data in memory into an existing object, reusing its capacity. */
+auto DeserializeCubeMap(std::span<const std::byte> bytes, CubeMap& asset) -> NcaHeader;
+
+/** @brief Read a HullCollider from data in memory into an existing object, reusing its capacity. */
+auto DeserializeHullCollider(std::span<const std::byte> bytes, HullCollider& asset) -> NcaHeader;
+
+/** @brief Read a Mesh from data in memory into an existing object, reusing its capacity. */
+auto DeserializeMesh(std::span<const std::byte> bytes, Mesh& asset) -> NcaHeader;
+
+/** @brief Read a SkeletalAnimation from data in memory into an existing object, reusing its capacity. */
+auto DeserializeSkeletalAnimation(std::span<const std::byte> bytes, SkeletalAnimation& asset) -> NcaHeader;
+
+/** @brief Read a Texture from data in memory into an existing object, reusing its capacity. */
+auto DeserializeTexture(std::span<const std::byte> bytes, Texture& asset) -> NcaHeader;
+
+/** @brief Construct an AudioClip from data in memory, allocating from a memory resource. */
+auto DeserializeAudioClip(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::AudioClip>;
+
+/** @brief Construct a ConcaveCollider from data in memory, allocating from a memory resource. */
+auto DeserializeConcaveCollider(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::ConcaveCollider>;
+
+/** @brief Construct a CubeMap from data in memory, allocating from a memory resource. */
+auto DeserializeCubeMap(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::CubeMap>;
+
+/** @brief Construct a HullCollider from data in memory, allocating from a memory resource. */
+auto DeserializeHullCollider(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::HullCollider>;
+
+/** @brief Construct a Mesh from data in memory, allocating from a memory resource. */
+auto DeserializeMesh(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Mesh>;
+
+/** @brief Construct a SkeletalAnimation from data in memory, allocating from a memory resource. */
+auto DeserializeSkeletalAnimation(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::SkeletalAnimation>;
+
+/** @brief Construct a Texture from data in memory, allocating from a memory resource. */
+auto DeserializeTexture(std::span<const std::byte> bytes, std::pmr::memory_resource* resource) -> DeserializedResult<pmr::Texture>;
+
+/**
+ * @brief Read a region of a Texture from a binary stream, seeking past pixels outside of it.
+ * @note The returned Texture has the region's dimensions. Throws if the region exceeds the texture bounds.
+ */
+auto DeserializeTextureRegion(std::istream& stream, const TextureRegion& region) -> DeserializedResult<Texture>;
+
+/** @brief Read a region of a Texture from data in memory. */
+auto DeserializeTextureRegion(std::span<const std::byte> bytes, const TextureRegion& region) -> DeserializedResult<Texture>;
+
+/** @brief Read a range of full-width rows of a Texture from a binary stream. */
+auto DeserializeTextureRows(std::istream& stream, uint32_t firstRow, uint32_t rowCount) -> DeserializedResult<Texture>;
+
+/** @brief Read a range of full-width rows of a Texture from data in memory. */
+auto DeserializeTextureRows(std::span<const std::byte> bytes, uint32_t firstRow, uint32_t rowCount) -> DeserializedResult<Texture>;
+
+/**
+ * @brief Read a Mesh from a binary stream, skipping over its bones section.
+ * @note The returned Mesh has no BonesData, regardless of whether the asset has any.
+ */
+auto DeserializeMeshWithoutBones(std::istream& stream) -> DeserializedResult<Mesh>;
+
+/** @brief Read a Mesh from data in memory, skipping over its bones section. */
+auto DeserializeMeshWithoutBones(std::span<const std::byte> bytes) -> DeserializedResult<Mesh>;
+
+/** @brief Read only the indices of a Mesh from a binary stream, seeking directly to them. */
+auto DeserializeMeshIndices(std::istream& stream) -> DeserializedResult<std::vector<uint32_t>>;
+
+/** @brief Read only the indices of a Mesh from data in memory. */
+auto DeserializeMeshIndices(std::span<const std::byte> bytes) -> DeserializedResult<std::vector<uint32_t>>;
+
+/** @brief Read only the BonesData of a Mesh from a binary stream, seeking directly to it. */
+auto DeserializeMeshBones(std::istream& stream) -> DeserializedResult<std::optional<BonesData>>;
+
+/** @brief Read only the BonesData of a Mesh from data in memory. */
+auto DeserializeMeshBones(std::span<const std::byte> bytes) -> DeserializedResult<std::optional<BonesData>>;
+
+/**
+ * @brief Convert only the vertices of a Mesh from a binary stream into the streams described by a layout.
+ * @note The allocator is asked for each stream once the vertex count is known. Vertices are read and
+ *       converted a block at a time, so the full MeshVertex list is never held in memory. The result
+ *       is the number of vertices written.
+ */
+auto DeserializeMeshVertices(std::istream& stream, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> DeserializedResult<size_t>;
+
+/** @brief Convert only the vertices of a Mesh from data in memory, converting uncompressed vertices in place. */
+auto DeserializeMeshVertices(std::span<const std::byte> bytes, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> DeserializedResult<size_t>;
+
+/** @brief Construct an AudioClipView over an asset in memory. */
+auto DeserializeAudioClipView(std::span<const std::byte> bytes) -> DeserializedResult<AudioClipView>;
+
+/** @brief Construct a ConcaveColliderView over an asset in memory. */
+auto DeserializeConcaveColliderView(std::span<const std::byte> bytes) -> DeserializedResult<ConcaveColliderView>;
+
+/** @brief Construct a CubeMapView over an asset in memory. */
+auto DeserializeCubeMapView(std::span<const std::byte> bytes) -> DeserializedResult<CubeMapView>;
+
+/** @brief Construct a HullColliderView over an asset in memory. */
+auto DeserializeHullColliderView(std::span<const std::byte> bytes) -> DeserializedResult<HullColliderView>;
+
+/** @brief Construct a MeshView over an asset in memory. */
+auto DeserializeMeshView(std::span<const std::byte> bytes) -> DeserializedResult<MeshView>;
+
+/** @brief Construct a TextureView over an asset in memory. */
+auto DeserializeTextureView(std::span<const std::byte> bytes) -> DeserializedResult<TextureView>;
 } // nc::asset
@@ -8,20 +8,41 @@
 
 namespace
 {
-auto OpenNca(const std::filesystem::path& ncaPath) -> std::ifstream
+auto GetMappedBytes(const nc::asset::MappedFile& file, size_t offset) -> std::span<const std::byte>
 {
-    if (!std::filesystem::is_regular_file(ncaPath))
+    if (offset > file.Size())
     {
-        throw nc::NcError("File does not exist: ", ncaPath.string());
+        throw nc::NcError("Offset is past the end of the mapped file");
     }
 
-    auto file = std::ifstream{ncaPath, std::ios::binary};
-    if (!file.is_open())
+    return file.Data().subspan(offset);
+}
+
+template<class Deserializer>
+auto ImportFromPackage(const nc::asset::AssetPackage& package, size_t assetId, Deserializer deserialize)
+{
+    return package.Read(assetId, [&](std::istream& stream)
     {
-        throw nc::NcError("Could not open file: ", ncaPath.string());
-    }
+        auto [header, asset] = deserialize(stream);
+        package.ValidateHeader(assetId, header);
 
-    return file;
+        return std::move(asset);
+    });
+}
+
+template<class T>
+auto ImportFromPackage(const nc::asset::AssetPackage& package, size_t assetId, nc::asset::DeserializedResult<T>(*deserialize)(std::istream&))
+{
+    return ::ImportFromPackage<decltype(deserialize)>(package, assetId, deserialize);
+}
+template<class Deserializer>
+void ImportIntoFromPackage(const nc::asset::AssetPackage& package, size_t assetId, Deserializer deserialize)
+{
+    package.Read(assetId, [&](std::istream& stream)
+    {
+        const auto header = deserialize(stream);
+        package.ValidateHeader(assetId, header);
+    });
 }
 } // anonymous namespace
 
@@ -34,7 +55,7 @@ auto ImportNcaHeader(std::istream& data) -> NcaHeader
 
 auto ImportNcaHeader(const std::filesystem::path& ncaPath) -> NcaHeader
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportNcaHeader(file);
 }
 
@@ -46,7 +67,7 @@ auto ImportAudioClip(std::istream& data) -> AudioClip
 
 auto ImportAudioClip(const std::filesystem::path& ncaPath) -> AudioClip
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportAudioClip(file);
 }
 
@@ -58,7 +79,7 @@ auto ImportConcaveCollider(std::istream& data) -> ConcaveCollider
 
 auto ImportConcaveCollider(const std::filesystem::path& ncaPath) -> ConcaveCollider
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportConcaveCollider(file);
 }
 
@@ -70,7 +91,7 @@ auto ImportCubeMap(std::istream& data) -> CubeMap
 
 auto ImportCubeMap(const std::filesystem::path& ncaPath) -> CubeMap
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportCubeMap(file);
 }
 
@@ -82,7 +103,7 @@ auto ImportHullCollider(std::istream& data) -> HullCollider
 
 auto ImportHullCollider(const std::filesystem::path& ncaPath) -> HullCollider
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportHullCollider(file);
 }
 
@@ -94,7 +115,7 @@ auto ImportMesh(std::istream& data) -> Mesh
 
 auto ImportMesh(const std::filesystem::path& ncaPath) -> Mesh
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportMesh(file);
 }
 
@@ -106,7 +127,7 @@ auto ImportSkeletalAnimation(std::istream& data) -> SkeletalAnimation
 
 auto ImportSkeletalAnimation(const std::filesystem::path& ncaPath) -> SkeletalAnimation
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportSkeletalAnimation(file);
 }
 
@@ -118,7 +139,496 @@ auto ImportTexture(std::istream& data) -> Texture
 
 auto ImportTexture(const std::filesystem::path& ncaPath) -> Texture
 {
-    auto file = ::OpenNca(ncaPath);
+    auto file = OpenNca(ncaPath);
     return ImportTexture(file);
 }
+
+auto ImportAny(std::istream& data) -> AnyAsset
+{
+    auto [header, asset] = DeserializeAny(data);
+    return asset;
+}
+
+auto ImportAny(const std::filesystem::path& ncaPath) -> AnyAsset
+{
+    auto file = OpenNca(ncaPath);
+    return ImportAny(file);
+}
+
+auto ImportAnyWithHeader(std::istream& data) -> DeserializedResult<AnyAsset>
+{
+    return DeserializeAny(data);
+}
+
+auto ImportAnyWithHeader(const std::filesystem::path& ncaPath) -> DeserializedResult<AnyAsset>
+{
+    auto file = OpenNca(ncaPath);
+    return ImportAnyWithHeader(file);
+}
+
+auto ImportAudioClip(const AssetPackage& package, size_t assetId) -> AudioClip
+{
+    return ::ImportFromPackage(package, assetId, DeserializeAudioClip);
+}
+
+auto ImportConcaveCollider(const AssetPackage& package, size_t assetId) -> ConcaveCollider
+{
+    return ::ImportFromPackage(package, assetId, DeserializeConcaveCollider);
+}
+
+auto ImportCubeMap(const AssetPackage& package, size_t assetId) -> CubeMap
+{
+    return ::ImportFromPackage(package, assetId, DeserializeCubeMap);
+}
+
+auto ImportHullCollider(const AssetPackage& package, size_t assetId) -> HullCollider
+{
+    return ::ImportFromPackage(package, assetId, DeserializeHullCollider);
+}
+
+auto ImportMesh(const AssetPackage& package, size_t assetId) -> Mesh
+{
+    return ::ImportFromPackage(package, assetId, DeserializeMesh);
+}
+
+auto ImportSkeletalAnimation(const AssetPackage& package, size_t assetId) -> SkeletalAnimation
+{
+    return ::ImportFromPackage(package, assetId, DeserializeSkeletalAnimation);
+}
+
+auto ImportTexture(const AssetPackage& package, size_t assetId) -> Texture
+{
+    return ::ImportFromPackage(package, assetId, DeserializeTexture);
+}
+
+auto ImportAny(const AssetPackage& package, size_t assetId) -> AnyAsset
+{
+    return ::ImportFromPackage(package, assetId, DeserializeAny);
+}
+
+auto ImportNcaHeader(const AssetPackage& package, size_t assetId) -> NcaHeader
+{
+    return package.Read(assetId, [assetId](std::istream& stream)
+    {
+        // A shared nca's header names only one of its assets, so report the requested id.
+        auto header = DeserializeHeader(stream);
+        header.assetId = assetId;
+        return header;
+    });
+}
+
+void ImportAudioClip(std::istream& data, AudioClip& asset)
+{
+    DeserializeAudioClip(data, asset);
+}
+
+void ImportAudioClip(const std::filesystem::path& ncaPath, AudioClip& asset)
+{
+    auto file = OpenNca(ncaPath);
+    ImportAudioClip(file, asset);
+}
+
+void ImportAudioClip(const AssetPackage& package, size_t assetId, AudioClip& asset)
+{
+    ::ImportIntoFromPackage(package, assetId, [&asset](std::istream& stream)
+    {
+        return DeserializeAudioClip(stream, asset);
+    });
+}
+
+void ImportConcaveCollider(std::istream& data, ConcaveCollider& asset)
+{
+    DeserializeConcaveCollider(data, asset);
+}
+
+void ImportConcaveCollider(const std::filesystem::path& ncaPath, ConcaveCollider& asset)
+{
+    auto file = OpenNca(ncaPath);
+    ImportConcaveCollider(file, asset);
+}
+
+void ImportConcaveCollider(const AssetPackage& package, size_t assetId, ConcaveCollider& asset)
+{
+    ::ImportIntoFromPackage(package, assetId, [&asset](std::istream& stream)
+    {
+        return DeserializeConcaveCollider(stream, asset);
+    });
+}
+
+void ImportCubeMap(std::istream& data, CubeMap& asset)
+{
+    DeserializeCubeMap(data, asset);
+}
+
+void ImportCubeMap(const std::filesystem::path& ncaPath, CubeMap& asset)
+{
+    auto file = OpenNca(ncaPath);
+    ImportCubeMap(file, asset);
+}
+
+void ImportCubeMap(const AssetPackage& package, size_t assetId, CubeMap& asset)
+{
+    ::ImportIntoFromPackage(package, assetId, [&asset](std::istream& stream)
+    {
+        return DeserializeCubeMap(stream, asset);
+    });
+}
+
+void ImportHullCollider(std::istream& data, HullCollider& asset)
+{
+    DeserializeHullCollider(data, asset);
+}
+
+void ImportHullCollider(const std::filesystem::path& ncaPath, HullCollider& asset)
+{
+    auto file = OpenNca(ncaPath);
+    ImportHullCollider(file, asset);
+}
+
+void ImportHullCollider(const AssetPackage& package, size_t assetId, HullCollider& asset)
+{
+    ::ImportIntoFromPackage(package, assetId, [&asset](std::istream& stream)
+    {
+        return DeserializeHullCollider(stream, asset);
+    });
+}
+
+void ImportMesh(std::istream& data, Mesh& asset)
+{
+    DeserializeMesh(data, asset);
+}
+
+void ImportMesh(const std::filesystem::path& ncaPath, Mesh& asset)
+{
+    auto file = OpenNca(ncaPath);
+    ImportMesh(file, asset);
+}
+
+void ImportMesh(const AssetPackage& package, size_t assetId, Mesh& asset)
+{
+    ::ImportIntoFromPackage(package, assetId, [&asset](std::istream& stream)
+    {
+        return DeserializeMesh(stream, asset);
+    });
+}
+
+void ImportSkeletalAnimation(std::istream& data, SkeletalAnimation& asset)
+{
+    DeserializeSkeletalAnimation(data, asset);
+}
+
+void ImportSkeletalAnimation(const std::filesystem::path& ncaPath, SkeletalAnimation& asset)
+{
+    auto file = OpenNca(ncaPath);
+    ImportSkeletalAnimation(file, asset);
+}
+
+void ImportSkeletalAnimation(const AssetPackage& package, size_t assetId, SkeletalAnimation& asset)
+{
+    ::ImportIntoFromPackage(package, assetId, [&asset](std::istream& stream)
+    {
+        return DeserializeSkeletalAnimation(stream, asset);
+    });
+}
+
+void ImportTexture(std::istream& data, Texture& asset)
+{
+    DeserializeTexture(data, asset);
+}
+
+void ImportTexture(const std::filesystem::path& ncaPath, Texture& asset)
+{
+    auto file = OpenNca(ncaPath);
+    ImportTexture(file, asset);
+}
+
+void ImportTexture(const AssetPackage& package, size_t assetId, Texture& asset)
+{
+    ::ImportIntoFromPackage(package, assetId, [&asset](std::istream& stream)
+    {
+        return DeserializeTexture(stream, asset);
+    });
+}
+
+auto ImportAudioClip(std::istream& data, std::pmr::memory_resource* resource) -> pmr::AudioClip
+{
+    return DeserializeAudioClip(data, resource).asset;
+}
+
+auto ImportAudioClip(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::AudioClip
+{
+    auto file = OpenNca(ncaPath);
+    return ImportAudioClip(file, resource);
+}
+
+auto ImportAudioClip(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::AudioClip
+{
+    return ::ImportFromPackage(package, assetId, [resource](std::istream& stream)
+    {
+        return DeserializeAudioClip(stream, resource);
+    });
+}
+
+auto ImportConcaveCollider(std::istream& data, std::pmr::memory_resource* resource) -> pmr::ConcaveCollider
+{
+    return DeserializeConcaveCollider(data, resource).asset;
+}
+
+auto ImportConcaveCollider(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::ConcaveCollider
+{
+    auto file = OpenNca(ncaPath);
+    return ImportConcaveCollider(file, resource);
+}
+
+auto ImportConcaveCollider(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::ConcaveCollider
+{
+    return ::ImportFromPackage(package, assetId, [resource](std::istream& stream)
+    {
+        return DeserializeConcaveCollider(stream, resource);
+    });
+}
+
+auto ImportCubeMap(std::istream& data, std::pmr::memory_resource* resource) -> pmr::CubeMap
+{
+    return DeserializeCubeMap(data, resource).asset;
+}
+
+auto ImportCubeMap(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::CubeMap
+{
+    auto file = OpenNca(ncaPath);
+    return ImportCubeMap(file, resource);
+}
+
+auto ImportCubeMap(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::CubeMap
+{
+    return ::ImportFromPackage(package, assetId, [resource](std::istream& stream)
+    {
+        return DeserializeCubeMap(stream, resource);
+    });
+}
+
+auto ImportHullCollider(std::istream& data, std::pmr::memory_resource* resource) -> pmr::HullCollider
+{
+    return DeserializeHullCollider(data, resource).asset;
+}
+
+auto ImportHullCollider(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::HullCollider
+{
+    auto file = OpenNca(ncaPath);
+    return ImportHullCollider(file, resource);
+}
+
+auto ImportHullCollider(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::HullCollider
+{
+    return ::ImportFromPackage(package, assetId, [resource](std::istream& stream)
+    {
+        return DeserializeHullCollider(stream, resource);
+    });
+}
+
+auto ImportMesh(std::istream& data, std::pmr::memory_resource* resource) -> pmr::Mesh
+{
+    return DeserializeMesh(data, resource).asset;
+}
+
+auto ImportMesh(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::Mesh
+{
+    auto file = OpenNca(ncaPath);
+    return ImportMesh(file, resource);
+}
+
+auto ImportMesh(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::Mesh
+{
+    return ::ImportFromPackage(package, assetId, [resource](std::istream& stream)
+    {
+        return DeserializeMesh(stream, resource);
+    });
+}
+
+auto ImportSkeletalAnimation(std::istream& data, std::pmr::memory_resource* resource) -> pmr::SkeletalAnimation
+{
+    return DeserializeSkeletalAnimation(data, resource).asset;
+}
+
+auto ImportSkeletalAnimation(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::SkeletalAnimation
+{
+    auto file = OpenNca(ncaPath);
+    return ImportSkeletalAnimation(file, resource);
+}
+
+auto ImportSkeletalAnimation(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::SkeletalAnimation
+{
+    return ::ImportFromPackage(package, assetId, [resource](std::istream& stream)
+    {
+        return DeserializeSkeletalAnimation(stream, resource);
+    });
+}
+
+auto ImportTexture(std::istream& data, std::pmr::memory_resource* resource) -> pmr::Texture
+{
+    return DeserializeTexture(data, resource).asset;
+}
+
+auto ImportTexture(const std::filesystem::path& ncaPath, std::pmr::memory_resource* resource) -> pmr::Texture
+{
+    auto file = OpenNca(ncaPath);
+    return ImportTexture(file, resource);
+}
+
+auto ImportTexture(const AssetPackage& package, size_t assetId, std::pmr::memory_resource* resource) -> pmr::Texture
+{
+    return ::ImportFromPackage(package, assetId, [resource](std::istream& stream)
+    {
+        return DeserializeTexture(stream, resource);
+    });
+}
+
+auto ImportTextureRegion(std::istream& data, const TextureRegion& region) -> Texture
+{
+    return DeserializeTextureRegion(data, region).asset;
+}
+
+auto ImportTextureRegion(const std::filesystem::path& ncaPath, const TextureRegion& region) -> Texture
+{
+    auto file = OpenNca(ncaPath);
+    return ImportTextureRegion(file, region);
+}
+
+auto ImportTextureRegion(const AssetPackage& package, size_t assetId, const TextureRegion& region) -> Texture
+{
+    return ::ImportFromPackage(package, assetId, [&region](std::istream& stream)
+    {
+        return DeserializeTextureRegion(stream, region);
+    });
+}
+
+auto ImportTextureRows(std::istream& data, uint32_t firstRow, uint32_t rowCount) -> Texture
+{
+    return DeserializeTextureRows(data, firstRow, rowCount).asset;
+}
+
+auto ImportTextureRows(const std::filesystem::path& ncaPath, uint32_t firstRow, uint32_t rowCount) -> Texture
+{
+    auto file = OpenNca(ncaPath);
+    return ImportTextureRows(file, firstRow, rowCount);
+}
+
+auto ImportTextureRows(const AssetPackage& package, size_t assetId, uint32_t firstRow, uint32_t rowCount) -> Texture
+{
+    return ::ImportFromPackage(package, assetId, [firstRow, rowCount](std::istream& stream)
+    {
+        return DeserializeTextureRows(stream, firstRow, rowCount);
+    });
+}
+
+auto ImportMeshWithoutBones(std::istream& data) -> Mesh
+{
+    return DeserializeMeshWithoutBones(data).asset;
+}
+
+auto ImportMeshWithoutBones(const std::filesystem::path& ncaPath) -> Mesh
+{
+    auto file = OpenNca(ncaPath);
+    return ImportMeshWithoutBones(file);
+}
+
+auto ImportMeshWithoutBones(const AssetPackage& package, size_t assetId) -> Mesh
+{
+    return ::ImportFromPackage(package, assetId, [](std::istream& stream)
+    {
+        return DeserializeMeshWithoutBones(stream);
+    });
+}
+
+auto ImportMeshBones(std::istream& data) -> std::optional<BonesData>
+{
+    return DeserializeMeshBones(data).asset;
+}
+
+auto ImportMeshBones(const std::filesystem::path& ncaPath) -> std::optional<BonesData>
+{
+    auto file = OpenNca(ncaPath);
+    return ImportMeshBones(file);
+}
+
+auto ImportMeshBones(const AssetPackage& package, size_t assetId) -> std::optional<BonesData>
+{
+    return ::ImportFromPackage(package, assetId, [](std::istream& stream)
+    {
+        return DeserializeMeshBones(stream);
+    });
+}
+
+auto ImportMeshIndices(std::istream& data) -> std::vector<uint32_t>
+{
+    return DeserializeMeshIndices(data).asset;
+}
+
+auto ImportMeshIndices(const std::filesystem::path& ncaPath) -> std::vector<uint32_t>
+{
+    auto file = OpenNca(ncaPath);
+    return ImportMeshIndices(file);
+}
+
+auto ImportMeshIndices(const AssetPackage& package, size_t assetId) -> std::vector<uint32_t>
+{
+    return ::ImportFromPackage(package, assetId, [](std::istream& stream)
+    {
+        return DeserializeMeshIndices(stream);
+    });
+}
+
+auto ImportMeshVertices(std::istream& data, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> size_t
+{
+    return DeserializeMeshVertices(data, layout, allocate).asset;
+}
+
+auto ImportMeshVertices(const std::filesystem::path& ncaPath, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> size_t
+{
+    auto file = OpenNca(ncaPath);
+    return ImportMeshVertices(file, layout, allocate);
+}
+
+auto ImportMeshVertices(const AssetPackage& package, size_t assetId, const VertexLayout& layout, const VertexStreamAllocator& allocate) -> size_t
+{
+    return ::ImportFromPackage(package, assetId, [&](std::istream& stream)
+    {
+        return DeserializeMeshVertices(stream, layout, allocate);
+    });
+}
+
+auto ImportMeshVertices(const MappedFile& file, const VertexLayout& layout, const VertexStreamAllocator& allocate, size_t offset) -> size_t
+{
+    return DeserializeMeshVertices(::GetMappedBytes(file, offset), layout, allocate).asset;
+}
+
+auto ImportAudioClipView(const MappedFile& file, size_t offset) -> AudioClipView
+{
+    return DeserializeAudioClipView(::GetMappedBytes(file, offset)).asset;
+}
+
+auto ImportConcaveColliderView(const MappedFile& file, size_t offset) -> ConcaveColliderView
+{
+    return DeserializeConcaveColliderView(::GetMappedBytes(file, offset)).asset;
+}
+
+auto ImportCubeMapView(const MappedFile& file, size_t offset) -> CubeMapView
+{
+    return DeserializeCubeMapView(::GetMappedBytes(file, offset)).asset;
+}
+
+auto ImportHullColliderView(const MappedFile& file, size_t offset) -> HullColliderView
+{
+    return DeserializeHullColliderView(::GetMappedBytes(file, offset)).asset;
+}
+
+auto ImportMeshView(const MappedFile& file, size_t offset) -> MeshView
+{
+    return DeserializeMeshView(::GetMappedBytes(file, offset)).asset;
+}
+
+auto ImportTextureView(const MappedFile& file, size_t offset) -> TextureView
+{
+    return DeserializeTextureView(::GetMappedBytes(file, offset)).asset;
+}
 } // namespace nc::asset
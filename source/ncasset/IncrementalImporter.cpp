@@ -0,0 +1,430 @@
+#include "IncrementalImporter.h"
+#include "Deserialize.h"
+#include "ThreadPool.h"
+#include "ncasset/Assets.h"
+
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <fstream>
+#include <functional>
+#include <mutex>
+#include <streambuf>
+#include <thread>
+
+namespace
+{
+/** The most data read between budget checks. */
+constexpr auto sliceSize = size_t{64 * 1024};
+
+/** The number of import pool threads held by unfinished imports. */
+auto pooledImports = std::atomic<size_t>{0};
+
+auto GetImportPool() -> nc::asset::ThreadPool&
+{
+    static auto pool = nc::asset::ThreadPool{};
+    return pool;
+}
+
+/**
+ * Claim an import pool thread if one is free. A paused import keeps its thread until it finishes, so
+ * jobs are only queued when a thread is sure to pick them up, rather than waiting behind paused imports.
+ */
+auto TryReservePoolThread() -> bool
+{
+    const auto threadCount = ::GetImportPool().GetThreadCount();
+    auto count = ::pooledImports.load(std::memory_order_relaxed);
+    while (count < threadCount)
+    {
+        if (::pooledImports.compare_exchange_weak(count, count + 1, std::memory_order_relaxed))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+auto OpenFile(const std::filesystem::path& path) -> std::unique_ptr<std::istream>
+{
+    return std::make_unique<std::ifstream>(nc::asset::OpenNca(path));
+}
+
+auto OpenPackageEntry(const nc::asset::AssetPackage& package, size_t assetId) -> std::unique_ptr<std::istream>
+{
+    const auto& entry = package.GetEntry(assetId);
+    auto file = ::OpenFile(package.GetPath());
+    file->seekg(static_cast<std::streamoff>(entry.offset));
+
+    // The id is checked up front, as the worker no longer has the package.
+    const auto header = nc::asset::DeserializeHeader(*file);
+    if (*file)
+    {
+        package.ValidateHeader(assetId, header);
+    }
+
+    file->clear();
+    file->seekg(static_cast<std::streamoff>(entry.offset));
+    return file;
+}
+
+template<class T>
+auto MakeJob(T* asset) -> std::function<void(std::istream&)>
+{
+    return [asset](std::istream& stream)
+    {
+        nc::asset::DeserializeAsset(stream, *asset);
+    };
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+/** Runs an import on a pool thread that only proceeds while a step is waiting on it. */
+class IncrementalImportState
+{
+    public:
+        using Job = std::function<void(std::istream&)>;
+
+        IncrementalImportState(std::unique_ptr<std::istream> source, Job job);
+        ~IncrementalImportState() noexcept;
+
+        auto Step(const ImportBudget& budget) -> bool;
+        auto IsComplete() const noexcept -> bool;
+        auto GetProgress() const noexcept -> float;
+
+    private:
+        class SliceBuffer;
+        enum class Phase { Paused, Running, Complete };
+
+        std::unique_ptr<std::istream> m_source;
+        Job m_job;
+        size_t m_totalBytes = 0;
+        std::atomic<size_t> m_position = 0;
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        Phase m_phase = Phase::Paused;
+        bool m_started = false;
+        bool m_cancelled = false;
+        bool m_hasReadThisStep = false;
+        size_t m_bytesRemaining = 0;
+        std::chrono::steady_clock::time_point m_deadline;
+        std::exception_ptr m_error;
+        std::thread m_worker;
+
+        void Start();
+        void Run();
+        auto AcquireSlice() -> size_t;
+};
+
+/** Hands the deserializer one slice at a time, parking the worker whenever the step's budget is spent. */
+class IncrementalImportState::SliceBuffer : public std::streambuf
+{
+    public:
+        SliceBuffer(IncrementalImportState& state, std::streambuf& source)
+            : m_state{state},
+              m_source{source}
+        {
+        }
+
+    protected:
+        auto underflow() -> int_type override
+        {
+            if (gptr() < egptr())
+            {
+                return traits_type::to_int_type(*gptr());
+            }
+
+            const auto allowed = m_state.AcquireSlice();
+            if (allowed == 0)
+            {
+                return traits_type::eof();
+            }
+
+            const auto count = m_source.sgetn(m_buffer.data(), static_cast<std::streamsize>(std::min(allowed, m_buffer.size())));
+            if (count <= 0)
+            {
+                return traits_type::eof();
+            }
+
+            Advance(count);
+            setg(m_buffer.data(), m_buffer.data(), m_buffer.data() + count);
+            return traits_type::to_int_type(m_buffer[0]);
+        }
+
+        /** Only relative seeks are made, to skip array padding and mesh sections. */
+        auto seekoff(off_type offset, std::ios::seekdir direction, std::ios::openmode) -> pos_type override
+        {
+            if (direction != std::ios::cur)
+            {
+                return pos_type(off_type(-1));
+            }
+
+            const auto buffered = static_cast<off_type>(egptr() - gptr());
+            if (offset >= 0 && offset <= buffered)
+            {
+                gbump(static_cast<int>(offset));
+            }
+            else
+            {
+                if (m_source.pubseekoff(offset - buffered, std::ios::cur, std::ios::in) == pos_type(off_type(-1)))
+                {
+                    return pos_type(off_type(-1));
+                }
+
+                Advance(offset - buffered);
+                setg(m_buffer.data(), m_buffer.data(), m_buffer.data());
+            }
+
+            return pos_type(m_position - static_cast<off_type>(egptr() - gptr()));
+        }
+
+    private:
+        IncrementalImportState& m_state;
+        std::streambuf& m_source;
+        std::array<char, sliceSize> m_buffer;
+        off_type m_position = 0;
+
+        void Advance(off_type count)
+        {
+            m_position += count;
+            m_state.m_position.store(static_cast<size_t>(std::max(m_position, off_type{0})), std::memory_order_relaxed);
+        }
+};
+
+IncrementalImportState::IncrementalImportState(std::unique_ptr<std::istream> source, Job job)
+    : m_source{std::move(source)},
+      m_job{std::move(job)}
+{
+    const auto header = DeserializeHeader(*m_source);
+    if (!*m_source)
+    {
+        throw NcError("Unexpected end of asset data");
+    }
+
+    m_totalBytes = NcaHeader::binarySize + header.size;
+    m_source->seekg(-static_cast<std::streamoff>(NcaHeader::binarySize), std::ios::cur);
+    if (!*m_source)
+    {
+        throw NcError("Incremental imports require a seekable stream");
+    }
+}
+
+IncrementalImportState::~IncrementalImportState() noexcept
+{
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_cancelled = true;
+    }
+
+    m_condition.notify_all();
+
+    // A pool thread can't be joined, so wait for the import to observe the cancellation instead.
+    {
+        auto lock = std::unique_lock{m_mutex};
+        m_condition.wait(lock, [this]() { return !m_started || m_phase == Phase::Complete; });
+    }
+
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+}
+
+auto IncrementalImportState::Step(const ImportBudget& budget) -> bool
+{
+    if (budget.bytes == 0)
+    {
+        throw NcError("Import budget must allow at least one byte");
+    }
+
+    auto lock = std::unique_lock{m_mutex};
+    if (m_phase != Phase::Complete)
+    {
+        const auto now = std::chrono::steady_clock::now();
+        const auto timeRemaining = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::time_point::max() - now);
+        m_deadline = budget.time < timeRemaining ? now + budget.time : std::chrono::steady_clock::time_point::max();
+        m_bytesRemaining = budget.bytes;
+        m_hasReadThisStep = false;
+        m_phase = Phase::Running;
+        if (m_started)
+        {
+            m_condition.notify_all();
+        }
+        else
+        {
+            Start();
+        }
+
+        m_condition.wait(lock, [this]() { return m_phase != Phase::Running; });
+    }
+
+    if (m_phase != Phase::Complete)
+    {
+        return false;
+    }
+
+    lock.unlock();
+    if (m_worker.joinable())
+    {
+        m_worker.join();
+    }
+
+    if (m_error)
+    {
+        std::rethrow_exception(m_error);
+    }
+
+    return true;
+}
+
+auto IncrementalImportState::IsComplete() const noexcept -> bool
+{
+    auto lock = std::lock_guard{m_mutex};
+    return m_phase == Phase::Complete;
+}
+
+auto IncrementalImportState::GetProgress() const noexcept -> float
+{
+    if (IsComplete())
+    {
+        return 1.0f;
+    }
+
+    const auto position = std::min(m_position.load(std::memory_order_relaxed), m_totalBytes);
+    return static_cast<float>(position) / static_cast<float>(m_totalBytes);
+}
+
+/** Begin the import on the shared pool, or on a dedicated thread if every pool thread holds another import. */
+void IncrementalImportState::Start()
+{
+    m_started = true;
+    if (::TryReservePoolThread())
+    {
+        // The state may be destroyed as soon as Run() completes, so only the pool's count is touched after it.
+        ::GetImportPool().Submit([this]()
+        {
+            Run();
+            ::pooledImports.fetch_sub(1, std::memory_order_relaxed);
+        });
+    }
+    else
+    {
+        m_worker = std::thread{[this]() { Run(); }};
+    }
+}
+
+void IncrementalImportState::Run()
+{
+    auto error = std::exception_ptr{};
+    try
+    {
+        auto buffer = SliceBuffer{*this, *m_source->rdbuf()};
+        auto stream = std::istream{&buffer};
+        m_job(stream);
+    }
+    catch (...)
+    {
+        error = std::current_exception();
+    }
+
+    // Notify while locked, as the owner may destroy the state once it sees the import complete.
+    auto lock = std::lock_guard{m_mutex};
+    m_error = error;
+    m_phase = Phase::Complete;
+    m_condition.notify_all();
+}
+
+/** Wait until the current step can afford another slice, returning its size, or zero if cancelled. */
+auto IncrementalImportState::AcquireSlice() -> size_t
+{
+    auto lock = std::unique_lock{m_mutex};
+    if (m_hasReadThisStep && (m_bytesRemaining == 0 || std::chrono::steady_clock::now() >= m_deadline))
+    {
+        m_phase = Phase::Paused;
+        m_condition.notify_all();
+        m_condition.wait(lock, [this]() { return m_phase == Phase::Running || m_cancelled; });
+    }
+
+    if (m_cancelled)
+    {
+        return 0;
+    }
+
+    const auto slice = std::min(m_bytesRemaining, sliceSize);
+    m_bytesRemaining -= slice;
+    m_hasReadThisStep = true;
+    return slice;
+}
+
+template<class T>
+IncrementalImporter<T>::IncrementalImporter(const std::filesystem::path& ncaPath)
+    : IncrementalImporter{::OpenFile(ncaPath)}
+{
+}
+
+template<class T>
+IncrementalImporter<T>::IncrementalImporter(const AssetPackage& package, size_t assetId)
+    : m_asset{std::make_unique<T>()},
+      m_state{std::make_unique<IncrementalImportState>(::OpenPackageEntry(package, assetId), ::MakeJob(m_asset.get()))}
+{
+}
+
+template<class T>
+IncrementalImporter<T>::IncrementalImporter(std::unique_ptr<std::istream> data)
+    : m_asset{std::make_unique<T>()},
+      m_state{std::make_unique<IncrementalImportState>(std::move(data), ::MakeJob(m_asset.get()))}
+{
+}
+
+template<class T>
+IncrementalImporter<T>::~IncrementalImporter() noexcept = default;
+
+template<class T>
+IncrementalImporter<T>::IncrementalImporter(IncrementalImporter&&) noexcept = default;
+
+template<class T>
+auto IncrementalImporter<T>::operator=(IncrementalImporter&& other) noexcept -> IncrementalImporter&
+{
+    // The worker writes into the asset, so it is stopped before the asset is released.
+    m_state = std::move(other.m_state);
+    m_asset = std::move(other.m_asset);
+    return *this;
+}
+
+template<class T>
+auto IncrementalImporter<T>::Step(const ImportBudget& budget) -> bool
+{
+    return m_state->Step(budget);
+}
+
+template<class T>
+auto IncrementalImporter<T>::Finish() -> T
+{
+    m_state->Step(ImportBudget{});
+    return std::move(*m_asset);
+}
+
+template<class T>
+auto IncrementalImporter<T>::IsComplete() const noexcept -> bool
+{
+    return m_state->IsComplete();
+}
+
+template<class T>
+auto IncrementalImporter<T>::GetProgress() const noexcept -> float
+{
+    return m_state->GetProgress();
+}
+
+template class IncrementalImporter<AudioClip>;
+template class IncrementalImporter<ConcaveCollider>;
+template class IncrementalImporter<CubeMap>;
+template class IncrementalImporter<HullCollider>;
+template class IncrementalImporter<Mesh>;
+template class IncrementalImporter<SkeletalAnimation>;
+template class IncrementalImporter<Texture>;
+} // namespace nc::asset
@@ -0,0 +1,117 @@
+#include "LoadTrace.h"
+#include "LoadTraceRecorder.h"
+
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <atomic>
+#include <charconv>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <utility>
+
+namespace
+{
+/** Lookups only pay for an atomic load unless a trace is running. */
+struct LoadTrace
+{
+    std::atomic<bool> enabled = false;
+    std::mutex mutex;
+    std::vector<size_t> ids;
+    std::unordered_set<size_t> seen;
+};
+
+auto GetLoadTrace() -> LoadTrace&
+{
+    static auto trace = LoadTrace{};
+    return trace;
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+void RecordLoad(size_t assetId)
+{
+    auto& trace = ::GetLoadTrace();
+    if (!trace.enabled.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+
+    auto lock = std::lock_guard{trace.mutex};
+    if (trace.enabled.load(std::memory_order_relaxed) && trace.seen.insert(assetId).second)
+    {
+        trace.ids.push_back(assetId);
+    }
+}
+
+void BeginLoadTrace()
+{
+    auto& trace = ::GetLoadTrace();
+    auto lock = std::lock_guard{trace.mutex};
+    trace.ids.clear();
+    trace.seen.clear();
+    trace.enabled = true;
+}
+
+auto EndLoadTrace() -> std::vector<size_t>
+{
+    auto& trace = ::GetLoadTrace();
+    auto lock = std::lock_guard{trace.mutex};
+    trace.enabled = false;
+    trace.seen.clear();
+    return std::exchange(trace.ids, {});
+}
+
+void WriteLoadTrace(const std::filesystem::path& tracePath, std::span<const size_t> assetIds)
+{
+    auto file = std::ofstream{tracePath, std::ios::trunc};
+    if (!file.is_open())
+    {
+        throw NcError("Could not open file: ", tracePath.string());
+    }
+
+    for (const auto id : assetIds)
+    {
+        file << id << '\n';
+    }
+
+    if (!file)
+    {
+        throw NcError("Failed writing load trace: ", tracePath.string());
+    }
+}
+
+auto ReadLoadTrace(const std::filesystem::path& tracePath) -> std::vector<size_t>
+{
+    auto file = std::ifstream{tracePath};
+    if (!file.is_open())
+    {
+        throw NcError("Could not open file: ", tracePath.string());
+    }
+
+    auto ids = std::vector<size_t>{};
+    auto line = std::string{};
+    while (std::getline(file, line))
+    {
+        if (line.empty())
+        {
+            continue;
+        }
+
+        auto id = size_t{};
+        const auto* end = line.data() + line.size();
+        const auto [parsed, error] = std::from_chars(line.data(), end, id);
+        if (error != std::errc{} || parsed != end)
+        {
+            throw NcError(fmt::format("Invalid asset id '{}' in load trace: {}", line, tracePath.string()));
+        }
+
+        ids.push_back(id);
+    }
+
+    return ids;
+}
+} // namespace nc::asset
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstddef>
+
+namespace nc::asset
+{
+/** @brief Add an asset id to the running load trace, if there is one. */
+void RecordLoad(size_t assetId);
+} // namespace nc::asset
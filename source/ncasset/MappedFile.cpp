@@ -0,0 +1,154 @@
+#include "MappedFile.h"
+
+#include "ncutility/NcError.h"
+
+#include <tuple>
+#include <utility>
+
+#ifdef WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef WIN32
+auto MapFile(const std::filesystem::path& path) -> std::pair<const std::byte*, size_t>
+{
+    auto file = ::CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        throw nc::NcError("Could not open file: ", path.string());
+    }
+
+    auto fileSize = LARGE_INTEGER{};
+    if (!::GetFileSizeEx(file, &fileSize))
+    {
+        ::CloseHandle(file);
+        throw nc::NcError("Could not get size of file: ", path.string());
+    }
+
+    if (fileSize.QuadPart == 0)
+    {
+        ::CloseHandle(file);
+        return {nullptr, 0};
+    }
+
+    // Views hold a reference to the mapping object, so both handles can be closed once mapped.
+    auto mapping = ::CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    ::CloseHandle(file);
+    if (!mapping)
+    {
+        throw nc::NcError("Could not create file mapping: ", path.string());
+    }
+
+    auto data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    ::CloseHandle(mapping);
+    if (!data)
+    {
+        throw nc::NcError("Could not map file: ", path.string());
+    }
+
+    return {static_cast<const std::byte*>(data), static_cast<size_t>(fileSize.QuadPart)};
+}
+
+void UnmapFile(const std::byte* data, size_t)
+{
+    ::UnmapViewOfFile(data);
+}
+#else
+auto MapFile(const std::filesystem::path& path) -> std::pair<const std::byte*, size_t>
+{
+    const auto fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+        throw nc::NcError("Could not open file: ", path.string());
+    }
+
+    struct stat info{};
+    if (::fstat(fd, &info) == -1)
+    {
+        ::close(fd);
+        throw nc::NcError("Could not get size of file: ", path.string());
+    }
+
+    const auto size = static_cast<size_t>(info.st_size);
+    if (size == 0)
+    {
+        ::close(fd);
+        return {nullptr, 0};
+    }
+
+    // The mapping remains valid after the descriptor is closed.
+    auto data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        throw nc::NcError("Could not map file: ", path.string());
+    }
+
+    return {static_cast<const std::byte*>(data), size};
+}
+
+void UnmapFile(const std::byte* data, size_t size)
+{
+    ::munmap(const_cast<std::byte*>(data), size);
+}
+#endif
+} // anonymous namespace
+
+namespace nc::asset
+{
+MappedFile::MappedFile(const std::filesystem::path& path)
+{
+    if (!std::filesystem::is_regular_file(path))
+    {
+        throw NcError("File does not exist: ", path.string());
+    }
+
+    std::tie(m_data, m_size) = ::MapFile(path);
+}
+
+MappedFile::~MappedFile() noexcept
+{
+    Unmap();
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : m_data{std::exchange(other.m_data, nullptr)},
+      m_size{std::exchange(other.m_size, 0)}
+{
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        Unmap();
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+    }
+
+    return *this;
+}
+
+void MappedFile::Unmap() noexcept
+{
+    if (m_data)
+    {
+        ::UnmapFile(m_data, m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+}
+} // namespace nc::asset
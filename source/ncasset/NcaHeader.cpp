@@ -32,6 +32,10 @@ auto GetAssetType(const NcaHeader& header) -> AssetType
     {
         return AssetType::Shader;
     }
+    else if (magicNumber == MagicNumber::skeletalAnimation)
+    {
+        return AssetType::SkeletalAnimation;
+    }
     else if (magicNumber == MagicNumber::texture)
     {
         return AssetType::Texture;
@@ -42,9 +46,8 @@ auto GetAssetType(const NcaHeader& header) -> AssetType
 
 void Serialize(std::ostream& stream, const NcaHeader& header)
 {
-    constexpr char defaultAlgo[5] = "NONE"; // not yet supported
     stream.write(header.magicNumber, 4);
-    stream.write(defaultAlgo, 4);
+    stream.write(header.compressionAlgorithm, 4);
     nc::serialize::Serialize(stream, header.assetId);
     nc::serialize::Serialize(stream, header.size);
 }
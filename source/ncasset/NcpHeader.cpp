@@ -0,0 +1,167 @@
+#include "ncasset/NcpHeader.h"
+
+#include "ncutility/BinarySerialization.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <string>
+
+namespace
+{
+constexpr auto idsPerBucket = size_t{4};
+
+/** Ids are already Fnv1a hashes, but are mixed again so buckets and slots are independent. */
+auto Mix(uint64_t value) -> uint64_t
+{
+    value ^= value >> 33;
+    value *= 0xFF51AFD7ED558CCDull;
+    value ^= value >> 33;
+    value *= 0xC4CEB9FE1A85EC53ull;
+    value ^= value >> 33;
+    return value;
+}
+
+auto GetBucket(size_t assetId, size_t bucketCount) -> size_t
+{
+    return static_cast<size_t>(::Mix(assetId) % bucketCount);
+}
+
+auto GetSlot(size_t assetId, uint32_t seed, size_t assetCount) -> size_t
+{
+    return static_cast<size_t>(::Mix(assetId + (uint64_t{seed} + 1) * 0x9E3779B97F4A7C15ull) % assetCount);
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+auto GetLutBucketCount(size_t assetCount) -> size_t
+{
+    return (assetCount + idsPerBucket - 1) / idsPerBucket;
+}
+
+auto GetLutSlot(size_t assetId, std::span<const uint32_t> seeds, size_t assetCount) -> size_t
+{
+    if (seeds.empty())
+    {
+        return 0;
+    }
+
+    return ::GetSlot(assetId, seeds[::GetBucket(assetId, seeds.size())], assetCount);
+}
+
+auto BuildLutHash(std::span<LutEntry> entries) -> std::vector<uint32_t>
+{
+    const auto count = entries.size();
+    auto seeds = std::vector<uint32_t>(GetLutBucketCount(count));
+    if (count == 0)
+    {
+        return seeds;
+    }
+
+    auto buckets = std::vector<std::vector<size_t>>(seeds.size());
+    for (auto i = size_t{0}; i < count; ++i)
+    {
+        buckets[::GetBucket(entries[i].assetId, seeds.size())].push_back(i);
+    }
+
+    // Place the largest buckets first, while most slots are still free.
+    auto order = std::vector<size_t>(buckets.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&buckets](size_t lhs, size_t rhs)
+    {
+        return buckets[lhs].size() > buckets[rhs].size();
+    });
+
+    auto slotOf = std::vector<size_t>(count);
+    auto taken = std::vector<bool>(count, false);
+    for (const auto bucketIndex : order)
+    {
+        const auto& bucket = buckets[bucketIndex];
+        for (auto i = size_t{0}; i < bucket.size(); ++i)
+        {
+            for (auto j = i + 1; j < bucket.size(); ++j)
+            {
+                if (entries[bucket[i]].assetId == entries[bucket[j]].assetId)
+                {
+                    throw NcError("Duplicate asset id in package: ", std::to_string(entries[bucket[i]].assetId));
+                }
+            }
+        }
+
+        auto seed = uint32_t{0};
+        for (;; ++seed)
+        {
+            auto placed = size_t{0};
+            for (; placed < bucket.size(); ++placed)
+            {
+                const auto slot = ::GetSlot(entries[bucket[placed]].assetId, seed, count);
+                if (taken[slot])
+                {
+                    break;
+                }
+
+                taken[slot] = true;
+                slotOf[bucket[placed]] = slot;
+            }
+
+            if (placed == bucket.size())
+            {
+                break;
+            }
+
+            for (auto i = size_t{0}; i < placed; ++i)
+            {
+                taken[slotOf[bucket[i]]] = false;
+            }
+
+            if (seed == std::numeric_limits<uint32_t>::max())
+            {
+                throw NcError("Failed to build package look up table hash");
+            }
+        }
+
+        seeds[bucketIndex] = seed;
+    }
+
+    auto ordered = std::vector<LutEntry>(count);
+    for (auto i = size_t{0}; i < count; ++i)
+    {
+        ordered[slotOf[i]] = entries[i];
+    }
+
+    std::copy(ordered.cbegin(), ordered.cend(), entries.begin());
+    return seeds;
+}
+
+void Serialize(std::ostream& stream, const NcpHeader& header)
+{
+    stream.write(header.magicNumber, 4);
+    stream.write(header.version, 8);
+    nc::serialize::Serialize(stream, header.assetCount);
+}
+
+void Deserialize(std::istream& stream, NcpHeader& header)
+{
+    stream.read(header.magicNumber, 4);
+    stream.read(header.version, 8);
+    header.magicNumber[4] = '\0';
+    header.version[8] = '\0';
+    nc::serialize::Deserialize(stream, header.assetCount);
+}
+
+void Serialize(std::ostream& stream, const LutEntry& entry)
+{
+    nc::serialize::Serialize(stream, entry.assetId);
+    nc::serialize::Serialize(stream, entry.offset);
+    nc::serialize::Serialize(stream, entry.lastUpdated);
+}
+
+void Deserialize(std::istream& stream, LutEntry& entry)
+{
+    nc::serialize::Deserialize(stream, entry.assetId);
+    nc::serialize::Deserialize(stream, entry.offset);
+    nc::serialize::Deserialize(stream, entry.lastUpdated);
+}
+} // namespace nc::asset
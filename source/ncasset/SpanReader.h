@@ -0,0 +1,93 @@
+#pragma once
+
+#include "ncutility/NcError.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <type_traits>
+
+namespace nc::asset
+{
+/** @brief Bounds-checked forward cursor over a contiguous range of bytes. */
+class SpanReader
+{
+    public:
+        explicit SpanReader(std::span<const std::byte> data) noexcept
+            : m_data{data}
+        {
+        }
+
+        /** @brief Copy a trivially copyable value from the current position. */
+        template<class T>
+            requires std::is_trivially_copyable_v<T>
+        void Read(T& out)
+        {
+            ReadBytes(&out, sizeof(T));
+        }
+
+        /** @brief Copy a number of bytes from the current position. */
+        void ReadBytes(void* out, size_t count)
+        {
+            const auto bytes = Take(count);
+            if (count != 0)
+            {
+                std::memcpy(out, bytes.data(), count);
+            }
+        }
+
+        /** @brief Get a view of an array at the current position without copying. */
+        template<class T>
+            requires std::is_trivially_copyable_v<T>
+        auto View(size_t count) -> std::span<const T>
+        {
+            if (count > Remaining() / sizeof(T))
+            {
+                throw NcError("Read past end of asset data");
+            }
+
+            const auto bytes = Take(count * sizeof(T));
+            if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(T) != 0)
+            {
+                throw NcError("Asset data is not suitably aligned for a view");
+            }
+
+            return std::span<const T>{reinterpret_cast<const T*>(bytes.data()), count};
+        }
+
+        /** @brief Advance the cursor without reading. */
+        void Skip(size_t count)
+        {
+            Take(count);
+        }
+
+        /** @brief Get the number of bytes consumed so far. */
+        auto Position() const noexcept -> size_t
+        {
+            return m_position;
+        }
+
+        /** @brief Get the number of unread bytes. */
+        auto Remaining() const noexcept -> size_t
+        {
+            return m_data.size() - m_position;
+        }
+
+    private:
+        std::span<const std::byte> m_data;
+        size_t m_position = 0;
+
+        auto Take(size_t count) -> std::span<const std::byte>
+        {
+            if (count > Remaining())
+            {
+                throw NcError("Read past end of asset data");
+            }
+
+            const auto bytes = m_data.subspan(m_position, count);
+            m_position += count;
+            return bytes;
+        }
+};
+} // namespace nc::asset
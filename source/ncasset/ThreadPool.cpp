@@ -0,0 +1,65 @@
+#include "ThreadPool.h"
+
+#include <algorithm>
+
+namespace nc::asset
+{
+ThreadPool::ThreadPool(size_t threadCount)
+{
+    if (threadCount == 0)
+    {
+        threadCount = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    m_workers.reserve(threadCount);
+    for (auto i = size_t{0}; i < threadCount; ++i)
+    {
+        m_workers.emplace_back([this]() { Run(); });
+    }
+}
+
+ThreadPool::~ThreadPool() noexcept
+{
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_stopping = true;
+    }
+
+    m_condition.notify_all();
+    for (auto& worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::Submit(std::function<void()> job)
+{
+    {
+        auto lock = std::lock_guard{m_mutex};
+        m_jobs.push(std::move(job));
+    }
+
+    m_condition.notify_one();
+}
+
+void ThreadPool::Run()
+{
+    while (true)
+    {
+        auto job = std::function<void()>{};
+        {
+            auto lock = std::unique_lock{m_mutex};
+            m_condition.wait(lock, [this]() { return m_stopping || !m_jobs.empty(); });
+            if (m_jobs.empty())
+            {
+                return;
+            }
+
+            job = std::move(m_jobs.front());
+            m_jobs.pop();
+        }
+
+        job();
+    }
+}
+} // namespace nc::asset
@@ -0,0 +1,478 @@
+#include "VertexLayout.h"
+
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define NC_ASSET_SSE2
+#include <emmintrin.h>
+#else
+#include <cmath>
+#endif
+
+namespace
+{
+/** Vertices are converted in blocks small enough to stay in cache while every element is written. */
+constexpr auto conversionBlockSize = size_t{256};
+
+struct AttributeInfo
+{
+    size_t offset;
+    uint32_t componentCount;
+};
+
+auto GetAttributeInfo(nc::asset::VertexAttribute attribute) -> AttributeInfo
+{
+    using nc::asset::MeshVertex;
+    using nc::asset::VertexAttribute;
+    switch (attribute)
+    {
+        case VertexAttribute::Position:    return AttributeInfo{offsetof(MeshVertex, position), 3u};
+        case VertexAttribute::Normal:      return AttributeInfo{offsetof(MeshVertex, normal), 3u};
+        case VertexAttribute::Uv:          return AttributeInfo{offsetof(MeshVertex, uv), 2u};
+        case VertexAttribute::Tangent:     return AttributeInfo{offsetof(MeshVertex, tangent), 3u};
+        case VertexAttribute::Bitangent:   return AttributeInfo{offsetof(MeshVertex, bitangent), 3u};
+        case VertexAttribute::BoneWeights: return AttributeInfo{offsetof(MeshVertex, boneWeights), 4u};
+        case VertexAttribute::BoneIds:     return AttributeInfo{offsetof(MeshVertex, boneIds), 4u};
+    }
+
+    throw nc::NcError(fmt::format("Unknown vertex attribute: '{}'", static_cast<int>(attribute)));
+}
+
+auto GetComponentCount(nc::asset::VertexFormat format) noexcept -> uint32_t
+{
+    using nc::asset::VertexFormat;
+    switch (format)
+    {
+        case VertexFormat::Float32x2:
+        case VertexFormat::Float16x2:
+            return 2u;
+        case VertexFormat::Float32x3:
+            return 3u;
+        case VertexFormat::Float32x4:
+        case VertexFormat::Float16x4:
+        case VertexFormat::Snorm16x4:
+        case VertexFormat::Snorm8x4:
+        case VertexFormat::Unorm8x4:
+        case VertexFormat::Uint32x4:
+        case VertexFormat::Uint16x4:
+        case VertexFormat::Uint8x4:
+            return 4u;
+    }
+
+    return 0u;
+}
+
+auto IsIntegerFormat(nc::asset::VertexFormat format) noexcept -> bool
+{
+    using nc::asset::VertexFormat;
+    return format == VertexFormat::Uint32x4 ||
+           format == VertexFormat::Uint16x4 ||
+           format == VertexFormat::Uint8x4;
+}
+
+#ifdef NC_ASSET_SSE2
+using Lanes = __m128;
+
+/** Float attributes are followed by further vertex members, so a full 16 byte load stays within the vertex. */
+auto LoadLanes(const std::byte* source, uint32_t componentCount) -> Lanes
+{
+    const auto lane = _mm_set_epi32(3, 2, 1, 0);
+    const auto mask = _mm_cmplt_epi32(lane, _mm_set1_epi32(static_cast<int>(componentCount)));
+    return _mm_and_ps(_mm_loadu_ps(reinterpret_cast<const float*>(source)), _mm_castsi128_ps(mask));
+}
+
+auto Clamp(Lanes lanes, float low, float high) -> Lanes
+{
+    return _mm_min_ps(_mm_max_ps(lanes, _mm_set1_ps(low)), _mm_set1_ps(high));
+}
+
+/** Round to nearest even float to half conversion, after the branchless SSE2 approach by Fabian Giesen. */
+auto FloatToHalf(Lanes lanes) -> __m128i
+{
+    const auto signMask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000u)));
+    const auto halfMax = _mm_set1_epi32((127 + 16) << 23);
+    const auto minNormal = _mm_set1_epi32((127 - 14) << 23);
+    const auto subnormalMagic = _mm_set1_epi32(((127 - 15) + (23 - 10) + 1) << 23);
+    const auto normalBias = _mm_set1_epi32(0xfff - ((127 - 15) << 23));
+
+    const auto sign = _mm_and_ps(signMask, lanes);
+    const auto absolute = _mm_xor_ps(lanes, sign);
+    const auto absoluteBits = _mm_castps_si128(absolute);
+    const auto isNan = _mm_castps_si128(_mm_cmpunord_ps(absolute, absolute));
+    const auto isRegular = _mm_cmpgt_epi32(halfMax, absoluteBits);
+    const auto special = _mm_or_si128(_mm_and_si128(isNan, _mm_set1_epi32(0x200)), _mm_set1_epi32(0x7c00));
+
+    const auto isSubnormal = _mm_cmpgt_epi32(minNormal, absoluteBits);
+    const auto subnormal = _mm_sub_epi32(_mm_castps_si128(_mm_add_ps(absolute, _mm_castsi128_ps(subnormalMagic))), subnormalMagic);
+
+    const auto mantissaOdd = _mm_srai_epi32(_mm_slli_epi32(absoluteBits, 31 - 13), 31);
+    const auto normal = _mm_srli_epi32(_mm_sub_epi32(_mm_add_epi32(absoluteBits, normalBias), mantissaOdd), 13);
+
+    const auto finite = _mm_or_si128(_mm_and_si128(subnormal, isSubnormal), _mm_andnot_si128(isSubnormal, normal));
+    const auto joined = _mm_or_si128(_mm_and_si128(finite, isRegular), _mm_andnot_si128(isRegular, special));
+    return _mm_or_si128(joined, _mm_srai_epi32(_mm_castps_si128(sign), 16));
+}
+
+void StoreLow32(__m128i value, std::byte* out)
+{
+    const auto bits = _mm_cvtsi128_si32(value);
+    std::memcpy(out, &bits, sizeof(bits));
+}
+
+template<uint32_t Count>
+void StoreFloat32(Lanes lanes, std::byte* out)
+{
+    if constexpr (Count == 4u)
+    {
+        _mm_storeu_ps(reinterpret_cast<float*>(out), lanes);
+    }
+    else
+    {
+        alignas(16) float values[4];
+        _mm_store_ps(values, lanes);
+        std::memcpy(out, values, Count * sizeof(float));
+    }
+}
+
+template<uint32_t Count>
+void StoreFloat16(Lanes lanes, std::byte* out)
+{
+    // Half bit patterns, with the sign extended through the upper bits, fit signed 16 bit saturation.
+    const auto halves = _mm_packs_epi32(::FloatToHalf(lanes), _mm_setzero_si128());
+    if constexpr (Count == 4u)
+    {
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), halves);
+    }
+    else
+    {
+        ::StoreLow32(halves, out);
+    }
+}
+
+void StoreSnorm16(Lanes lanes, std::byte* out)
+{
+    const auto values = _mm_cvtps_epi32(_mm_mul_ps(::Clamp(lanes, -1.0f, 1.0f), _mm_set1_ps(32767.0f)));
+    _mm_storel_epi64(reinterpret_cast<__m128i*>(out), _mm_packs_epi32(values, values));
+}
+
+void StoreSnorm8(Lanes lanes, std::byte* out)
+{
+    const auto values = _mm_cvtps_epi32(_mm_mul_ps(::Clamp(lanes, -1.0f, 1.0f), _mm_set1_ps(127.0f)));
+    const auto words = _mm_packs_epi32(values, values);
+    ::StoreLow32(_mm_packs_epi16(words, words), out);
+}
+
+void StoreUnorm8(Lanes lanes, std::byte* out)
+{
+    const auto values = _mm_cvtps_epi32(_mm_mul_ps(::Clamp(lanes, 0.0f, 1.0f), _mm_set1_ps(255.0f)));
+    const auto words = _mm_packs_epi32(values, values);
+    ::StoreLow32(_mm_packus_epi16(words, words), out);
+}
+#else
+using Lanes = std::array<float, 4>;
+
+auto LoadLanes(const std::byte* source, uint32_t componentCount) -> Lanes
+{
+    auto lanes = Lanes{};
+    std::memcpy(lanes.data(), source, componentCount * sizeof(float));
+    return lanes;
+}
+
+/** NaN clamps to the low bound, matching the SSE2 path. */
+auto Clamp(float value, float low, float high) -> float
+{
+    return value > low ? (value < high ? value : high) : low;
+}
+
+auto FloatToHalf(float value) -> uint16_t
+{
+    auto bits = uint32_t{};
+    std::memcpy(&bits, &value, sizeof(bits));
+    const auto sign = bits & 0x80000000u;
+    bits ^= sign;
+
+    auto half = uint32_t{};
+    if (bits >= (127u + 16u) << 23)
+    {
+        half = bits > 0x7f800000u ? 0x7e00u : 0x7c00u;
+    }
+    else if (bits < (127u - 14u) << 23)
+    {
+        const auto magicBits = uint32_t{((127u - 15u) + (23u - 10u) + 1u) << 23};
+        auto magic = float{};
+        std::memcpy(&magic, &magicBits, sizeof(magic));
+        auto absolute = float{};
+        std::memcpy(&absolute, &bits, sizeof(absolute));
+        const auto sum = absolute + magic;
+        std::memcpy(&half, &sum, sizeof(half));
+        half -= magicBits;
+    }
+    else
+    {
+        const auto mantissaOdd = (bits >> 13) & 1u;
+        half = (bits + 0xfffu - ((127u - 15u) << 23) + mantissaOdd) >> 13;
+    }
+
+    return static_cast<uint16_t>(half | (sign >> 16));
+}
+
+template<class T>
+void StoreNormalized(const Lanes& lanes, std::byte* out, float low, float scale)
+{
+    auto values = std::array<T, 4>{};
+    for (auto i = 0u; i < 4u; ++i)
+    {
+        values[i] = static_cast<T>(std::nearbyint(::Clamp(lanes[i], low, 1.0f) * scale));
+    }
+
+    std::memcpy(out, values.data(), sizeof(values));
+}
+
+template<uint32_t Count>
+void StoreFloat32(Lanes lanes, std::byte* out)
+{
+    std::memcpy(out, lanes.data(), Count * sizeof(float));
+}
+
+template<uint32_t Count>
+void StoreFloat16(Lanes lanes, std::byte* out)
+{
+    auto halves = std::array<uint16_t, Count>{};
+    for (auto i = 0u; i < Count; ++i)
+    {
+        halves[i] = ::FloatToHalf(lanes[i]);
+    }
+
+    std::memcpy(out, halves.data(), sizeof(halves));
+}
+
+void StoreSnorm16(Lanes lanes, std::byte* out)
+{
+    ::StoreNormalized<int16_t>(lanes, out, -1.0f, 32767.0f);
+}
+
+void StoreSnorm8(Lanes lanes, std::byte* out)
+{
+    ::StoreNormalized<int8_t>(lanes, out, -1.0f, 127.0f);
+}
+
+void StoreUnorm8(Lanes lanes, std::byte* out)
+{
+    ::StoreNormalized<uint8_t>(lanes, out, 0.0f, 255.0f);
+}
+#endif
+
+template<void(*Store)(Lanes, std::byte*)>
+void ConvertFloatAttribute(std::span<const nc::asset::MeshVertex> vertices, const AttributeInfo& info, std::byte* out, size_t stride)
+{
+    for (const auto& vertex : vertices)
+    {
+        Store(::LoadLanes(reinterpret_cast<const std::byte*>(&vertex) + info.offset, info.componentCount), out);
+        out += stride;
+    }
+}
+
+template<class T>
+void ConvertBoneIds(std::span<const nc::asset::MeshVertex> vertices, std::byte* out, size_t stride)
+{
+    for (const auto& vertex : vertices)
+    {
+        auto ids = std::array<T, 4>{};
+        for (auto i = 0u; i < ids.size(); ++i)
+        {
+            if (vertex.boneIds[i] > std::numeric_limits<T>::max())
+            {
+                throw nc::NcError(fmt::format(
+                    "Bone id '{}' does not fit in a {} byte vertex component",
+                    vertex.boneIds[i], sizeof(T)
+                ));
+            }
+
+            ids[i] = static_cast<T>(vertex.boneIds[i]);
+        }
+
+        std::memcpy(out, ids.data(), sizeof(ids));
+        out += stride;
+    }
+}
+
+void ConvertElement(std::span<const nc::asset::MeshVertex> vertices, const nc::asset::VertexElement& element, std::byte* out, size_t stride)
+{
+    using nc::asset::VertexFormat;
+    const auto info = ::GetAttributeInfo(element.attribute);
+    switch (element.format)
+    {
+        case VertexFormat::Float32x2: ::ConvertFloatAttribute<::StoreFloat32<2u>>(vertices, info, out, stride); break;
+        case VertexFormat::Float32x3: ::ConvertFloatAttribute<::StoreFloat32<3u>>(vertices, info, out, stride); break;
+        case VertexFormat::Float32x4: ::ConvertFloatAttribute<::StoreFloat32<4u>>(vertices, info, out, stride); break;
+        case VertexFormat::Float16x2: ::ConvertFloatAttribute<::StoreFloat16<2u>>(vertices, info, out, stride); break;
+        case VertexFormat::Float16x4: ::ConvertFloatAttribute<::StoreFloat16<4u>>(vertices, info, out, stride); break;
+        case VertexFormat::Snorm16x4: ::ConvertFloatAttribute<::StoreSnorm16>(vertices, info, out, stride); break;
+        case VertexFormat::Snorm8x4:  ::ConvertFloatAttribute<::StoreSnorm8>(vertices, info, out, stride); break;
+        case VertexFormat::Unorm8x4:  ::ConvertFloatAttribute<::StoreUnorm8>(vertices, info, out, stride); break;
+        case VertexFormat::Uint32x4:  ::ConvertBoneIds<uint32_t>(vertices, out, stride); break;
+        case VertexFormat::Uint16x4:  ::ConvertBoneIds<uint16_t>(vertices, out, stride); break;
+        case VertexFormat::Uint8x4:   ::ConvertBoneIds<uint8_t>(vertices, out, stride); break;
+    }
+}
+} // anonymous namespace
+
+namespace nc::asset
+{
+auto GetVertexFormatSize(VertexFormat format) noexcept -> uint32_t
+{
+    switch (format)
+    {
+        case VertexFormat::Float32x2: return 8u;
+        case VertexFormat::Float32x3: return 12u;
+        case VertexFormat::Float32x4: return 16u;
+        case VertexFormat::Float16x2: return 4u;
+        case VertexFormat::Float16x4: return 8u;
+        case VertexFormat::Snorm16x4: return 8u;
+        case VertexFormat::Snorm8x4:  return 4u;
+        case VertexFormat::Unorm8x4:  return 4u;
+        case VertexFormat::Uint32x4:  return 16u;
+        case VertexFormat::Uint16x4:  return 8u;
+        case VertexFormat::Uint8x4:   return 4u;
+    }
+
+    return 0u;
+}
+
+auto MakeInterleavedLayout(const std::vector<VertexAttributeFormat>& attributes) -> VertexLayout
+{
+    auto layout = VertexLayout{};
+    auto stride = uint32_t{0};
+    for (const auto& [attribute, format] : attributes)
+    {
+        layout.elements.push_back(VertexElement{attribute, format, 0u, stride});
+        stride += GetVertexFormatSize(format);
+    }
+
+    layout.strides.push_back(stride);
+    ValidateVertexLayout(layout);
+    return layout;
+}
+
+auto MakeSplitLayout(const std::vector<VertexAttributeFormat>& attributes) -> VertexLayout
+{
+    auto layout = VertexLayout{};
+    for (const auto& [attribute, format] : attributes)
+    {
+        layout.elements.push_back(VertexElement{attribute, format, static_cast<uint32_t>(layout.strides.size()), 0u});
+        layout.strides.push_back(GetVertexFormatSize(format));
+    }
+
+    ValidateVertexLayout(layout);
+    return layout;
+}
+
+void ValidateVertexLayout(const VertexLayout& layout)
+{
+    if (layout.elements.empty())
+    {
+        throw NcError("Vertex layout has no elements");
+    }
+
+    for (auto i = size_t{0}; i < layout.elements.size(); ++i)
+    {
+        const auto& element = layout.elements[i];
+        if (element.stream >= layout.strides.size())
+        {
+            throw NcError(fmt::format(
+                "Vertex element stream '{}' is not one of the layout's '{}' streams",
+                element.stream, layout.strides.size()
+            ));
+        }
+
+        const auto info = ::GetAttributeInfo(element.attribute);
+        const auto size = GetVertexFormatSize(element.format);
+        if (size == 0u)
+        {
+            throw NcError(fmt::format("Unknown vertex format: '{}'", static_cast<int>(element.format)));
+        }
+
+        if (::IsIntegerFormat(element.format) != (element.attribute == VertexAttribute::BoneIds) ||
+            ::GetComponentCount(element.format) < info.componentCount)
+        {
+            throw NcError(fmt::format(
+                "Vertex format '{}' cannot hold attribute '{}'",
+                static_cast<int>(element.format), static_cast<int>(element.attribute)
+            ));
+        }
+
+        const auto stride = layout.strides[element.stream];
+        if (size_t{element.offset} + size > stride)
+        {
+            throw NcError(fmt::format(
+                "Vertex element at offset '{}' with size '{}' exceeds stream stride '{}'",
+                element.offset, size, stride
+            ));
+        }
+
+        for (auto j = size_t{0}; j < i; ++j)
+        {
+            const auto& other = layout.elements[j];
+            if (other.stream == element.stream &&
+                other.offset < element.offset + size &&
+                element.offset < other.offset + GetVertexFormatSize(other.format))
+            {
+                throw NcError(fmt::format(
+                    "Vertex elements at offsets '{}' and '{}' overlap in stream '{}'",
+                    other.offset, element.offset, element.stream
+                ));
+            }
+        }
+    }
+}
+
+auto GetVertexStreamSize(const VertexLayout& layout, size_t stream, size_t vertexCount) -> size_t
+{
+    return vertexCount * layout.strides.at(stream);
+}
+
+void ConvertVertices(std::span<const MeshVertex> vertices,
+                     const VertexLayout& layout,
+                     std::span<const std::span<std::byte>> streams,
+                     size_t firstVertex)
+{
+    ValidateVertexLayout(layout);
+    if (streams.size() < layout.strides.size())
+    {
+        throw NcError(fmt::format(
+            "Vertex layout has '{}' streams, but '{}' were provided",
+            layout.strides.size(), streams.size()
+        ));
+    }
+
+    const auto vertexEnd = firstVertex + vertices.size();
+    for (auto i = size_t{0}; i < layout.strides.size(); ++i)
+    {
+        const auto required = GetVertexStreamSize(layout, i, vertexEnd);
+        if (streams[i].size() < required)
+        {
+            throw NcError(fmt::format(
+                "Vertex stream '{}' holds '{}' bytes, but '{}' are needed",
+                i, streams[i].size(), required
+            ));
+        }
+    }
+
+    for (auto blockBegin = size_t{0}; blockBegin < vertices.size(); blockBegin += conversionBlockSize)
+    {
+        const auto block = vertices.subspan(blockBegin, std::min(conversionBlockSize, vertices.size() - blockBegin));
+        for (const auto& element : layout.elements)
+        {
+            const auto stride = size_t{layout.strides[element.stream]};
+            auto* out = streams[element.stream].data() + (firstVertex + blockBegin) * stride + element.offset;
+            ::ConvertElement(block, element, out, stride);
+        }
+    }
+}
+} // namespace nc::asset
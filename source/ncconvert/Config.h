@@ -5,6 +5,8 @@
 #include <filesystem>
 #include <optional>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace nc::convert
@@ -57,5 +59,36 @@ struct Config
      * @note Specific to manifest mode.
      */
     std::optional<std::filesystem::path> manifestPath;
+
+    /**
+     * @brief A path to an .ncp package to write all assets into instead of individual .nca files.
+     * @note Specific to single target and manifest modes. Overrides the manifest's 'packagePath'.
+     */
+    std::optional<std::filesystem::path> packagePath;
+
+    /**
+     * @brief A load trace written by ncasset, used to lay out package assets in first-load order.
+     * @note Specific to packages. Overrides the manifest's 'loadTrace'.
+     */
+    std::optional<std::filesystem::path> loadTracePath;
+
+    /**
+     * @brief The compression algorithm to apply to blobs of each asset type.
+     * @note Types without an entry fall back to the manifest's 'compression' option, or
+     *       are left uncompressed. Values are asset::CompressionAlgorithm identifiers.
+     */
+    std::unordered_map<asset::AssetType, std::string_view> compression;
+
+    /**
+     * @brief The alignment in bytes of array data within each nca.
+     * @note Overrides the manifest's 'blobAlignment'. Defaults to defaultBlobAlignment.
+     */
+    std::optional<size_t> blobAlignment;
+
+    /**
+     * @brief The number of targets to build at once. Zero uses one job per hardware thread.
+     * @note Overrides the manifest's 'jobs'. Defaults to one.
+     */
+    std::optional<size_t> jobCount;
 };
 } // namespace nc::convert
@@ -7,8 +7,11 @@
 
 #include <algorithm>
 #include <cctype>
+#include <charconv>
+#include <cstring>
 #include <filesystem>
 #include <iostream>
+#include <optional>
 #include <string>
 
 constexpr auto usageMessage = 
@@ -21,6 +24,27 @@ Options
   -o <dir>                Output assets to <dir>.
   -m <manifest>           Perform conversions specified in <manifest>.
   -i <assetPath>          Print details about an existing asset file.
+  -p <package>            Write all assets into a single .ncp <package>.
+  -l <trace>              Lay out package assets in the first-load order
+                          recorded in <trace>, with assets that were never
+                          loaded at the end. Requires a package.
+  -c [<type>=]<codec>     Compress asset blobs with <codec>, for all asset
+                          types or only <type>. May be given more than once.
+  -a <bytes>              Align array data such as vertices and pixels to a
+                          multiple of <bytes> within each asset, so mapped
+                          assets can be used with aligned SIMD loads. Must be
+                          a power of two up to 4096 (default: 16).
+  -j <count>              Build up to <count> targets at once, each with its
+                          own converters. 0 uses one job per hardware thread
+                          (default: 1), and at most 4 per hardware thread are
+                          allowed. Output is still logged in target order.
+
+Compression codecs
+  none                    Store asset blobs uncompressed (default).
+  lz4                     Fast decompression, moderate compression ratio.
+  zstd                    High compression ratio using a dictionary trained
+                          per asset type. Assets of a zstd type are always
+                          rebuilt. Requires NC_TOOLS_ENABLE_ZSTD.
 
 Asset types               Supported file types      Can produce multiple assets
   mesh                    fbx, obj                  true
@@ -40,11 +64,22 @@ Json Manifest
   A provided manifest should be a json file containing an array of conversion
   specifications for each required asset type, and an optional 'globalOptions'
   object defining global settings. Relative paths within `globalOptions` will
-  be interpreted relative to the manifest. Example:
+  be interpreted relative to the manifest. If 'packagePath' is given, all
+  assets are written into a single .ncp package, and entries that are newer
+  than their source files are reused from an existing package. 'loadTrace'
+  is a load trace used as with '-l', 'blobAlignment' is an alignment
+  used as with '-a', and 'jobs' is a job count used as with '-j'. 'compression'
+  may be a codec for all asset types or an object mapping asset types to
+  codecs; '-c' options take precedence over it. Example:
   {
       "globalOptions": {
           "outputDirectory": "./", // default: "./"
-          "workingDirectory": "./" // default: "./"
+          "workingDirectory": "./", // default: "./"
+          "packagePath": "assets.ncp", // optional, default: none
+          "loadTrace": "startup.trace", // optional, default: none
+          "blobAlignment": 64, // optional, default: 16
+          "jobs": 8, // optional, default: 1
+          "compression": { "mesh": "lz4", "texture": "lz4" } // optional, default: none
       },
       "mesh": [
           {
@@ -80,6 +115,7 @@ Return Values
 )";
 
 bool ParseArgs(int argc, char** argv, nc::convert::Config* config);
+bool ParseSize(const char* value, std::optional<size_t>* out);
 
 int main(int argc, char** argv)
 {
@@ -159,6 +195,50 @@ bool ParseArgs(int argc, char** argv, nc::convert::Config* out)
             out->outputDirectory = std::filesystem::path(argv[current++]);
             out->outputDirectory.make_preferred();
         }
+        else if (option == "-p")
+        {
+            out->packagePath = std::filesystem::absolute(std::filesystem::path(argv[current++]));
+            out->packagePath.value().make_preferred();
+        }
+        else if (option == "-l")
+        {
+            out->loadTracePath = std::filesystem::absolute(std::filesystem::path(argv[current++]));
+            out->loadTracePath.value().make_preferred();
+        }
+        else if (option == "-c")
+        {
+            const auto value = std::string{argv[current++]};
+            const auto separator = value.find('=');
+            if (separator == std::string::npos)
+            {
+                const auto algorithm = nc::convert::ToCompressionAlgorithm(value);
+                for (auto type : {nc::asset::AssetType::AudioClip, nc::asset::AssetType::ConcaveCollider, nc::asset::AssetType::CubeMap,
+                                  nc::asset::AssetType::HullCollider, nc::asset::AssetType::Mesh, nc::asset::AssetType::SkeletalAnimation,
+                                  nc::asset::AssetType::Texture})
+                {
+                    out->compression.try_emplace(type, algorithm);
+                }
+            }
+            else
+            {
+                const auto type = nc::convert::ToAssetType(value.substr(0, separator));
+                out->compression.insert_or_assign(type, nc::convert::ToCompressionAlgorithm(value.substr(separator + 1)));
+            }
+        }
+        else if (option == "-a")
+        {
+            if (!ParseSize(argv[current++], &out->blobAlignment))
+            {
+                return false;
+            }
+        }
+        else if (option == "-j")
+        {
+            if (!ParseSize(argv[current++], &out->jobCount))
+            {
+                return false;
+            }
+        }
         else if (option == "-i")
         {
             out->mode = nc::convert::OperationMode::Inspect;
@@ -179,6 +259,12 @@ bool ParseArgs(int argc, char** argv, nc::convert::Config* out)
         }
         case nc::convert::OperationMode::SingleTarget:
         {
+            // A load trace only orders package entries, and a single target has no manifest to provide a package.
+            if (out->loadTracePath.has_value() && !out->packagePath.has_value())
+            {
+                return false;
+            }
+
             return out->targetPath.has_value() && out->targetType.has_value() && out->assetName.has_value();
         }
         case nc::convert::OperationMode::Manifest:
@@ -193,3 +279,18 @@ bool ParseArgs(int argc, char** argv, nc::convert::Config* out)
 
     return false;
 }
+
+/** Parse a whole argument as a size, rejecting signs, trailing characters, and values that overflow. */
+bool ParseSize(const char* value, std::optional<size_t>* out)
+{
+    const auto* end = value + std::strlen(value);
+    auto parsed = size_t{};
+    const auto [last, error] = std::from_chars(value, end, parsed);
+    if (value == end || error != std::errc{} || last != end)
+    {
+        return false;
+    }
+
+    *out = parsed;
+    return true;
+}
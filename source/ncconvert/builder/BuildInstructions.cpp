@@ -1,12 +1,22 @@
 #include "BuildInstructions.h"
+#include "BuildSettings.h"
 #include "Config.h"
 #include "Manifest.h"
 #include "Target.h"
+#include "utility/BlobSize.h"
 #include "utility/Log.h"
 #include "utility/Path.h"
 
+#include "ncasset/Import.h"
+#include "ncasset/NcaHeader.h"
+
+#include "fmt/format.h"
 #include "ncutility/NcError.h"
 
+#include <algorithm>
+#include <thread>
+#include <utility>
+
 namespace
 {
 auto BuildTargetMap() -> std::unordered_map<nc::asset::AssetType, std::vector<nc::convert::Target>>
@@ -21,14 +31,59 @@ auto BuildTargetMap() -> std::unordered_map<nc::asset::AssetType, std::vector<nc
     out.emplace(nc::asset::AssetType::Texture, std::vector<nc::convert::Target>{});
     return out;
 }
+
+// Each job owns a full set of converters, so counts beyond a few per hardware thread only cost memory.
+constexpr auto maxJobsPerHardwareThread = size_t{4};
+
+auto GetMaxJobCount() -> size_t
+{
+    return std::max(1u, std::thread::hardware_concurrency()) * maxJobsPerHardwareThread;
+}
+
+auto IsUpToDate(const nc::convert::Target& target, std::string_view compression) -> bool
+{
+    if (!std::filesystem::exists(target.destinationPath))
+    {
+        return false;
+    }
+
+    if (std::filesystem::last_write_time(target.destinationPath) <= std::filesystem::last_write_time(target.sourcePath))
+    {
+        return false;
+    }
+
+    // Changing the codec does not touch the source, so the existing nca's header must name the requested one.
+    try
+    {
+        return std::string_view{nc::asset::ImportNcaHeader(target.destinationPath).compressionAlgorithm} == compression;
+    }
+    catch (const std::exception&)
+    {
+        return false;
+    }
+}
 } // anonymous namespace
 
 namespace nc::convert
 {
 BuildInstructions::BuildInstructions(const Config& config)
-    : m_instructions{::BuildTargetMap()}
+    : m_instructions{::BuildTargetMap()},
+      m_packagePath{config.packagePath},
+      m_loadTracePath{config.loadTracePath},
+      m_compression{config.compression},
+      m_blobAlignment{config.blobAlignment},
+      m_jobCount{config.jobCount},
+      m_outputDirectory{config.outputDirectory}
 {
     ReadTargets(config);
+    ValidateBlobAlignment(GetBlobAlignment());
+    if (const auto jobCount = GetJobCount(); jobCount > ::GetMaxJobCount())
+    {
+        throw NcError(fmt::format(
+            "Job count must be no larger than {} ({} per hardware thread): '{}'",
+            ::GetMaxJobCount(), maxJobsPerHardwareThread, jobCount
+        ));
+    }
 }
 
 auto BuildInstructions::GetTargetsForType(asset::AssetType type) const -> const std::vector<Target>&
@@ -36,6 +91,38 @@ auto BuildInstructions::GetTargetsForType(asset::AssetType type) const -> const
     return m_instructions.at(type);
 }
 
+auto BuildInstructions::GetPackagePath() const -> const std::optional<std::filesystem::path>&
+{
+    return m_packagePath;
+}
+
+auto BuildInstructions::GetLoadTracePath() const -> const std::optional<std::filesystem::path>&
+{
+    return m_loadTracePath;
+}
+
+auto BuildInstructions::GetCompression(asset::AssetType type) const -> std::string_view
+{
+    const auto pos = m_compression.find(type);
+    return pos == m_compression.cend() ? asset::CompressionAlgorithm::none : pos->second;
+}
+
+auto BuildInstructions::GetBlobAlignment() const -> size_t
+{
+    return m_blobAlignment.value_or(defaultBlobAlignment);
+}
+
+auto BuildInstructions::GetJobCount() const -> size_t
+{
+    const auto jobCount = m_jobCount.value_or(1);
+    return jobCount == 0 ? std::max(1u, std::thread::hardware_concurrency()) : jobCount;
+}
+
+auto BuildInstructions::GetOutputDirectory() const -> const std::filesystem::path&
+{
+    return m_outputDirectory;
+}
+
 void BuildInstructions::ReadTargets(const Config& config)
 {
     LOG("--Generating Build Targets--");
@@ -54,7 +141,7 @@ void BuildInstructions::ReadTargets(const Config& config)
         case OperationMode::Manifest:
         {
             LOG("Running in manifest mode");
-            ReadManifest(config.manifestPath.value(), m_instructions);
+            ApplyManifest(ReadManifest(config.manifestPath.value()));
             break;
         }
         default:
@@ -64,4 +151,60 @@ void BuildInstructions::ReadTargets(const Config& config)
         }
     }
 }
+
+void BuildInstructions::ApplyManifest(ManifestOptions manifest)
+{
+    // Options from the command line take precedence.
+    if (!m_packagePath)
+    {
+        m_packagePath = std::move(manifest.packagePath);
+    }
+
+    if (!m_loadTracePath)
+    {
+        m_loadTracePath = std::move(manifest.loadTracePath);
+    }
+
+    if (!m_blobAlignment)
+    {
+        m_blobAlignment = manifest.blobAlignment;
+    }
+
+    if (!m_jobCount)
+    {
+        m_jobCount = manifest.jobCount;
+    }
+
+    m_compression.merge(manifest.compression);
+    m_outputDirectory = std::move(manifest.outputDirectory);
+
+    // Alignment changes the bytes of every nca without touching a source, so existing files are only
+    // trusted if the directory records the requested settings. Package entries are checked against
+    // the existing package when building instead.
+    const auto recordedSettings = ReadBuildSettings(GetDirectorySettingsPath(m_outputDirectory));
+    const auto settingsMatch = recordedSettings == BuildSettings{GetBlobAlignment()};
+    const auto checkNcaFiles = !m_packagePath && settingsMatch;
+    if (!m_packagePath && recordedSettings && !settingsMatch)
+    {
+        LOG("Output directory was built with blob alignment {}, rebuilding all targets", recordedSettings->blobAlignment);
+    }
+
+    for (auto& [type, targets] : manifest.targets)
+    {
+        // A zstd dictionary is trained from every asset of its type, so none of them can be skipped.
+        const auto compression = GetCompression(type);
+        const auto skipUpToDate = checkNcaFiles && compression != asset::CompressionAlgorithm::zstd;
+        auto& collection = m_instructions.at(type);
+        for (auto& target : targets)
+        {
+            if (skipUpToDate && ::IsUpToDate(target, compression))
+            {
+                LOG("Up-to-date: {}", target.destinationPath.string());
+                continue;
+            }
+
+            collection.push_back(std::move(target));
+        }
+    }
+}
 } // namespace nc::convert
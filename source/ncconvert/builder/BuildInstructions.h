@@ -3,12 +3,15 @@
 #include "ncasset/AssetType.h"
 
 #include <filesystem>
+#include <optional>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace nc::convert
 {
 struct Config;
+struct ManifestOptions;
 struct Target;
 
 /** @brief A collection of all targets that need to be built. */
@@ -21,9 +24,37 @@ class BuildInstructions
         /** @brief Get the collection of targets to build matching an AssetType. */
         auto GetTargetsForType(asset::AssetType type) const -> const std::vector<Target>&;
 
+        /** @brief Get the package to write targets into, if packaging is enabled. */
+        auto GetPackagePath() const -> const std::optional<std::filesystem::path>&;
+
+        /** @brief Get the load trace to lay out the package by, if one was given. */
+        auto GetLoadTracePath() const -> const std::optional<std::filesystem::path>&;
+
+        /** @brief Get the compression algorithm to apply to assets of a type. */
+        auto GetCompression(asset::AssetType type) const -> std::string_view;
+
+        /** @brief Get the alignment of array data within each nca. */
+        auto GetBlobAlignment() const -> size_t;
+
+        /**
+         * @brief Get the number of targets to build at once, resolving zero to the hardware thread count.
+         * @note Construction fails if this is more than a few jobs per hardware thread.
+         */
+        auto GetJobCount() const -> size_t;
+
+        /** @brief Get the directory loose .nca files are written to. */
+        auto GetOutputDirectory() const -> const std::filesystem::path&;
+
     private:
         std::unordered_map<asset::AssetType, std::vector<Target>> m_instructions;
+        std::optional<std::filesystem::path> m_packagePath;
+        std::optional<std::filesystem::path> m_loadTracePath;
+        std::unordered_map<asset::AssetType, std::string_view> m_compression;
+        std::optional<size_t> m_blobAlignment;
+        std::optional<size_t> m_jobCount;
+        std::filesystem::path m_outputDirectory;
 
         void ReadTargets(const Config& config);
+        void ApplyManifest(ManifestOptions manifest);
 };
 } // namespace nc::convert
@@ -1,16 +1,31 @@
 #include "BuildOrchestrator.h"
 #include "Builder.h"
 #include "BuildInstructions.h"
+#include "BuildSettings.h"
 #include "Inspect.h"
+#include "PackageWriter.h"
+#include "Serialize.h"
 #include "Target.h"
+#include "utility/Compress.h"
 #include "utility/EnumExtensions.h"
 #include "utility/Log.h"
 
 #include "ncasset/AssetType.h"
+#include "ncasset/Dictionary.h"
+#include "ncasset/LoadTrace.h"
+#include "ncasset/NcaHeader.h"
 #include "ncutility/NcError.h"
 
+#include <algorithm>
 #include <array>
+#include <condition_variable>
+#include <exception>
 #include <fstream>
+#include <mutex>
+#include <span>
+#include <sstream>
+#include <thread>
+#include <utility>
 
 namespace
 {
@@ -23,13 +38,61 @@ constexpr auto assetTypes = std::array<nc::asset::AssetType, 7>{
     nc::asset::AssetType::SkeletalAnimation,
     nc::asset::AssetType::Texture
 };
+
+// Dictionaries for loose .nca files are written to this file in the output directory.
+constexpr auto dictionaryFileName = std::string_view{"dictionaries.ncd"};
+
+// Workers may finish this many targets per worker ahead of the oldest unwritten one, bounding buffered ncas.
+constexpr auto maxTargetsAheadPerWorker = size_t{4};
+
+/** A target's output from a worker, held until every earlier target has been written. */
+struct BufferedTarget
+{
+    std::ostringstream log;
+    std::optional<std::string> nca;
+    std::exception_ptr error;
+    bool done = false;
+};
+
+/** Build a target in memory, returning nullopt if the Builder reports a failure. */
+auto BuildNca(nc::convert::Builder& builder,
+              nc::asset::AssetType type,
+              const nc::convert::Target& target,
+              std::string_view compression,
+              size_t alignment,
+              const std::filesystem::path& displayPath) -> std::optional<std::string>
+{
+    LOG("Building {}: {}", nc::convert::ToString(type), displayPath.string());
+    auto nca = std::ostringstream{std::ios::binary};
+    if (!builder.Build(type, target, nca, compression, alignment))
+    {
+        LOG("Failed building: {}", displayPath.string());
+        return std::nullopt;
+    }
+
+    return std::move(nca).str();
+}
+
+void WriteFile(const std::filesystem::path& path, std::string_view contents)
+{
+    if (path.has_parent_path() && !std::filesystem::exists(path.parent_path()))
+    {
+        std::filesystem::create_directories(path.parent_path());
+    }
+
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    if (!file)
+    {
+        throw nc::NcError("Failed writing file: ", path.string());
+    }
+}
 }
 
 namespace nc::convert
 {
 BuildOrchestrator::BuildOrchestrator(Config config)
-    : m_config{std::move(config)},
-      m_builder{std::make_unique<Builder>()}
+    : m_config{std::move(config)}
 {
 }
 
@@ -43,27 +106,343 @@ void BuildOrchestrator::RunBuild()
         return;
     }
 
-    if(!std::filesystem::exists(m_config.outputDirectory))
+    const auto instructions = BuildInstructions{m_config};
+    m_jobCount = instructions.GetJobCount();
+    m_builders.clear();
+
+    LOG("--Building Assets--");
+    if (m_jobCount > 1)
+    {
+        LOG("Building with up to {} jobs", m_jobCount);
+    }
+
+    if (const auto& packagePath = instructions.GetPackagePath())
     {
-        LOG("Creating directory: {}", m_config.outputDirectory.string());
-        if(!std::filesystem::create_directories(m_config.outputDirectory))
+        BuildPackage(instructions, packagePath.value());
+    }
+    else
+    {
+        if (const auto& tracePath = instructions.GetLoadTracePath())
         {
-            throw NcError("Failed to create output directory: ", m_config.outputDirectory.string());
+            LOG("Ignoring load trace without a package: {}", tracePath->string());
         }
+
+        BuildFiles(instructions);
     }
+}
 
-    const auto instructions = BuildInstructions{m_config};
-    LOG("--Building Assets--");
+void BuildOrchestrator::BuildFiles(const BuildInstructions& instructions)
+{
+    // Only loose files need the output directory, a package's directory is created by its PackageWriter.
+    const auto& outputDirectory = instructions.GetOutputDirectory();
+    if(!std::filesystem::exists(outputDirectory))
+    {
+        LOG("Creating directory: {}", outputDirectory.string());
+        if(!std::filesystem::create_directories(outputDirectory))
+        {
+            throw NcError("Failed to create output directory: ", outputDirectory.string());
+        }
+    }
+
+    // The record is dropped while files with other settings may be written, so an interrupted build rebuilds everything.
+    const auto settingsPath = GetDirectorySettingsPath(outputDirectory);
+    const auto settings = BuildSettings{instructions.GetBlobAlignment()};
+    if (ReadBuildSettings(settingsPath) != settings)
+    {
+        RemoveBuildSettings(settingsPath);
+    }
+
+    auto targetCount = size_t{0};
+    auto writtenCount = size_t{0};
+    auto dictionaries = std::ostringstream{std::ios::binary};
     for (auto type : assetTypes)
     {
+        targetCount += instructions.GetTargetsForType(type).size();
+        if (instructions.GetCompression(type) == asset::CompressionAlgorithm::zstd)
+        {
+            const auto dictionary = BuildWithDictionary(type, instructions.GetTargetsForType(type), instructions.GetBlobAlignment(), [&writtenCount](const Target& target, std::string_view nca)
+            {
+                ::WriteFile(target.destinationPath, nca);
+                ++writtenCount;
+            });
+
+            if (dictionary)
+            {
+                convert::Serialize(dictionaries, dictionary.value());
+            }
+
+            continue;
+        }
+
+        const auto& targets = instructions.GetTargetsForType(type);
+        BuildInOrder(targets.size(), [&](Builder& builder, size_t index)
+        {
+            const auto& target = targets[index];
+            return ::BuildNca(builder, type, target, instructions.GetCompression(type), instructions.GetBlobAlignment(), target.destinationPath);
+        },
+        [&targets, &writtenCount](size_t index, std::string nca)
+        {
+            ::WriteFile(targets[index].destinationPath, nca);
+            ++writtenCount;
+        });
+    }
+
+    // Every zstd type was rebuilt, so the file only needs this build's dictionaries.
+    if (const auto view = dictionaries.view(); !view.empty())
+    {
+        const auto dictionaryPath = outputDirectory / dictionaryFileName;
+        LOG("Writing dictionaries: {}", dictionaryPath.string());
+        ::WriteFile(dictionaryPath, view);
+    }
+
+    // A manifest build covers every target, so its settings now describe the directory. A failed
+    // target may have left a file with other settings, so nothing is recorded until all succeed.
+    if (m_config.mode == OperationMode::Manifest && writtenCount == targetCount)
+    {
+        WriteBuildSettings(settingsPath, settings);
+    }
+}
+
+void BuildOrchestrator::BuildPackage(const BuildInstructions& instructions, const std::filesystem::path& packagePath)
+{
+    LOG("Writing package: {}", packagePath.string());
+    auto writer = PackageWriter{packagePath, instructions.GetBlobAlignment()};
+    for (auto type : assetTypes)
+    {
+        // Entries are not reused for zstd types, as their dictionary is retrained from every asset.
+        if (instructions.GetCompression(type) == asset::CompressionAlgorithm::zstd)
+        {
+            const auto dictionary = BuildWithDictionary(type, instructions.GetTargetsForType(type), instructions.GetBlobAlignment(), [&writer](const Target& target, std::string_view nca)
+            {
+                writer.Add(GetAssetId(target.destinationPath), nca);
+            });
+
+            if (dictionary)
+            {
+                auto record = std::ostringstream{std::ios::binary};
+                convert::Serialize(record, dictionary.value());
+                writer.Add(asset::GetDictionaryAssetId(dictionary->GetId()), record.view());
+            }
+
+            continue;
+        }
+
+        // Reused entries are copied up front, so only stale targets are handed to the workers.
+        auto stale = std::vector<const Target*>{};
         for (const auto& target : instructions.GetTargetsForType(type))
         {
-            LOG("Building {}: {}", ToString(type), target.destinationPath.string());
-            if (!m_builder->Build(type, target))
+            if (writer.TryReuse(GetAssetId(target.destinationPath), target.sourcePath, instructions.GetCompression(type)))
+            {
+                LOG("Up-to-date: {}", target.destinationPath.filename().string());
+                continue;
+            }
+
+            stale.push_back(&target);
+        }
+
+        BuildInOrder(stale.size(), [&](Builder& builder, size_t index)
+        {
+            const auto& target = *stale[index];
+            return ::BuildNca(builder, type, target, instructions.GetCompression(type), instructions.GetBlobAlignment(), target.destinationPath.filename());
+        },
+        [&writer, &stale](size_t index, std::string nca)
+        {
+            writer.Add(GetAssetId(stale[index]->destinationPath), nca);
+        });
+    }
+
+    // A single target updates one entry of an existing package rather than replacing it.
+    if (m_config.mode == OperationMode::SingleTarget)
+    {
+        writer.CarryForwardUnreferenced();
+    }
+
+    if (const auto& tracePath = instructions.GetLoadTracePath())
+    {
+        LOG("Reading load trace: {}", tracePath->string());
+        writer.SetLoadOrder(asset::ReadLoadTrace(tracePath.value()));
+    }
+
+    writer.Finalize();
+}
+
+auto BuildOrchestrator::BuildWithDictionary(asset::AssetType type,
+                                            const std::vector<Target>& targets,
+                                            size_t alignment,
+                                            const std::function<void(const Target&, std::string_view)>& write) -> std::optional<CompressionDictionary>
+{
+    // Targets are built uncompressed first so their blobs can be used as training samples.
+    auto built = std::vector<std::pair<const Target*, std::string>>{};
+    built.reserve(targets.size());
+    BuildInOrder(targets.size(), [&](Builder& builder, size_t index)
+    {
+        const auto& target = targets[index];
+        return ::BuildNca(builder, type, target, asset::CompressionAlgorithm::none, alignment, target.destinationPath.filename());
+    },
+    [&built, &targets](size_t index, std::string nca)
+    {
+        built.emplace_back(&targets[index], std::move(nca));
+    });
+
+    auto samples = std::vector<std::span<const std::byte>>{};
+    samples.reserve(built.size());
+    for (const auto& [target, nca] : built)
+    {
+        const auto blob = std::string_view{nca}.substr(asset::NcaHeader::binarySize);
+        samples.push_back(std::as_bytes(std::span{blob.data(), blob.size()}));
+    }
+
+    auto dictionary = TrainDictionary(samples);
+    if (dictionary)
+    {
+        LOG("Trained {} dictionary '{}' ({} bytes) from {} assets", ToString(type), dictionary->GetId(), dictionary->GetBytes().size(), samples.size());
+    }
+    else if (!built.empty())
+    {
+        LOG("Too few {} assets to train a dictionary, compressing without one", ToString(type));
+    }
+
+    // Compression with a trained dictionary is slow as well, so it is also spread across the workers.
+    BuildInOrder(built.size(), [&built, &dictionary](Builder&, size_t index) -> std::optional<std::string>
+    {
+        auto compressed = std::ostringstream{std::ios::binary};
+        convert::Compress(compressed, built[index].second, asset::CompressionAlgorithm::zstd, dictionary ? &dictionary.value() : nullptr);
+        return std::move(compressed).str();
+    },
+    [&built, &write](size_t index, std::string nca)
+    {
+        write(*built[index].first, nca);
+    });
+
+    return dictionary;
+}
+
+void BuildOrchestrator::BuildInOrder(size_t count, const BuildJob& build, const BuildCompletion& complete)
+{
+    // Builders are only created once a job needs them, as each owns a full set of converters.
+    const auto workerCount = std::min(m_jobCount, count);
+    while (m_builders.size() < workerCount)
+    {
+        m_builders.push_back(std::make_unique<Builder>());
+    }
+
+    if (workerCount <= 1)
+    {
+        for (auto index = size_t{0}; index < count; ++index)
+        {
+            if (auto nca = build(*m_builders.front(), index))
+            {
+                complete(index, std::move(nca).value());
+            }
+        }
+
+        return;
+    }
+
+    const auto maxAhead = workerCount * maxTargetsAheadPerWorker;
+    auto targets = std::vector<BufferedTarget>(count);
+    auto mutex = std::mutex{};
+    auto condition = std::condition_variable{};
+    auto next = size_t{0};
+    auto written = size_t{0};
+    auto stopping = false;
+
+    const auto work = [&](Builder& builder)
+    {
+        while (true)
+        {
+            auto index = size_t{0};
             {
-                LOG("Failed building: {}", target.destinationPath.string());
+                auto lock = std::unique_lock{mutex};
+                condition.wait(lock, [&]() { return stopping || next == count || next < written + maxAhead; });
+                if (stopping || next == count)
+                {
+                    return;
+                }
+
+                index = next++;
+            }
+
+            auto& target = targets[index];
+            const auto previousLog = std::exchange(logStream, &target.log);
+            try
+            {
+                target.nca = build(builder, index);
+            }
+            catch (...)
+            {
+                target.error = std::current_exception();
+            }
+
+            logStream = previousLog;
+            {
+                auto lock = std::lock_guard{mutex};
+                target.done = true;
+            }
+
+            condition.notify_all();
+        }
+    };
+
+    auto workers = std::vector<std::thread>{};
+    workers.reserve(workerCount);
+    for (auto i = size_t{0}; i < workerCount; ++i)
+    {
+        workers.emplace_back(work, std::ref(*m_builders[i]));
+    }
+
+    auto error = std::exception_ptr{};
+    for (auto index = size_t{0}; index < count; ++index)
+    {
+        auto& target = targets[index];
+        {
+            auto lock = std::unique_lock{mutex};
+            condition.wait(lock, [&target]() { return target.done; });
+        }
+
+        *logStream << target.log.view();
+        if (target.error)
+        {
+            error = target.error;
+            break;
+        }
+
+        try
+        {
+            if (target.nca)
+            {
+                complete(index, std::move(target.nca).value());
             }
         }
+        catch (...)
+        {
+            error = std::current_exception();
+            break;
+        }
+
+        target = BufferedTarget{};
+        {
+            auto lock = std::lock_guard{mutex};
+            ++written;
+        }
+
+        condition.notify_all();
+    }
+
+    {
+        auto lock = std::lock_guard{mutex};
+        stopping = true;
+    }
+
+    condition.notify_all();
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    if (error)
+    {
+        std::rethrow_exception(error);
     }
 }
 } // namespace nc::convert
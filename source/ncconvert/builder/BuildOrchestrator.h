@@ -2,13 +2,27 @@
 
 #include "Config.h"
 
+#include <functional>
 #include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace nc::convert
 {
 class Builder;
+class BuildInstructions;
+class CompressionDictionary;
+struct Target;
 
-/** @brief Manager that handles dispatching instructions to the Builder. */
+/**
+ * @brief Manager that handles dispatching instructions to the Builder.
+ *
+ * Targets are built by up to the configured job count of workers, each with its own Builder,
+ * since converters are not shareable between threads. Workers claim targets in order, so a
+ * slow target never holds up the rest, and results are written and logged in target order.
+ */
 class BuildOrchestrator
 {
     public:
@@ -19,7 +33,30 @@ class BuildOrchestrator
         void RunBuild();
 
     private:
+        /** Builds the nca for a target index on a worker, returning nullopt if it failed. */
+        using BuildJob = std::function<std::optional<std::string>(Builder&, size_t)>;
+
+        /** Receives a built nca on the calling thread. */
+        using BuildCompletion = std::function<void(size_t, std::string)>;
+
         Config m_config;
-        std::unique_ptr<Builder> m_builder;
+        size_t m_jobCount = 1;
+        std::vector<std::unique_ptr<Builder>> m_builders;
+
+        void BuildFiles(const BuildInstructions& instructions);
+        void BuildPackage(const BuildInstructions& instructions, const std::filesystem::path& packagePath);
+
+        /** Build all targets of a type, train a zstd dictionary from them, and pass each compressed nca to write. */
+        auto BuildWithDictionary(asset::AssetType type,
+                                 const std::vector<Target>& targets,
+                                 size_t alignment,
+                                 const std::function<void(const Target&, std::string_view)>& write) -> std::optional<CompressionDictionary>;
+
+        /**
+         * Run build for each index in [0, count) across the workers, passing each nca to complete on the
+         * calling thread in index order. A job's log output is buffered until its turn to complete, and
+         * the first exception in index order is rethrown once the workers have stopped.
+         */
+        void BuildInOrder(size_t count, const BuildJob& build, const BuildCompletion& complete);
 };
 } // namespace nc::convert
@@ -0,0 +1,60 @@
+#include "BuildSettings.h"
+
+#include "ncutility/NcError.h"
+
+#include <fstream>
+#include <string>
+
+namespace
+{
+// Loose .nca files share one record in their output directory.
+constexpr auto directorySettingsFileName = std::string_view{"ncconvert.settings"};
+constexpr auto blobAlignmentKey = std::string_view{"blobAlignment"};
+} // anonymous namespace
+
+namespace nc::convert
+{
+auto GetDirectorySettingsPath(const std::filesystem::path& outputDirectory) -> std::filesystem::path
+{
+    return outputDirectory / directorySettingsFileName;
+}
+
+auto GetPackageSettingsPath(const std::filesystem::path& packagePath) -> std::filesystem::path
+{
+    return std::filesystem::path{packagePath.string() + ".settings"};
+}
+
+auto ReadBuildSettings(const std::filesystem::path& settingsPath) -> std::optional<BuildSettings>
+{
+    auto file = std::ifstream{settingsPath};
+    if (!file.is_open())
+    {
+        return std::nullopt;
+    }
+
+    auto key = std::string{};
+    auto settings = BuildSettings{};
+    if (!(file >> key >> settings.blobAlignment) || key != blobAlignmentKey)
+    {
+        return std::nullopt;
+    }
+
+    return settings;
+}
+
+void WriteBuildSettings(const std::filesystem::path& settingsPath, const BuildSettings& settings)
+{
+    auto file = std::ofstream{settingsPath, std::ios::trunc};
+    file << blobAlignmentKey << ' ' << settings.blobAlignment << '\n';
+    if (!file)
+    {
+        throw NcError("Failed writing build settings: ", settingsPath.string());
+    }
+}
+
+void RemoveBuildSettings(const std::filesystem::path& settingsPath)
+{
+    auto ec = std::error_code{};
+    std::filesystem::remove(settingsPath, ec);
+}
+} // namespace nc::convert
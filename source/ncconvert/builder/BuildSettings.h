@@ -0,0 +1,36 @@
+#pragma once
+
+#include "utility/BlobSize.h"
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+
+namespace nc::convert
+{
+/**
+ * @brief Options that change the bytes of built assets without touching their sources.
+ * @note Compression is not recorded, as each nca header names its own codec.
+ */
+struct BuildSettings
+{
+    size_t blobAlignment = defaultBlobAlignment;
+
+    friend auto operator==(const BuildSettings&, const BuildSettings&) -> bool = default;
+};
+
+/** @brief Get the path of the settings recorded for loose .nca files in a directory. */
+auto GetDirectorySettingsPath(const std::filesystem::path& outputDirectory) -> std::filesystem::path;
+
+/** @brief Get the path of the settings recorded for a package. */
+auto GetPackageSettingsPath(const std::filesystem::path& packagePath) -> std::filesystem::path;
+
+/** @brief Read recorded settings, or nullopt if there are none or they cannot be read. */
+auto ReadBuildSettings(const std::filesystem::path& settingsPath) -> std::optional<BuildSettings>;
+
+/** @brief Record the settings assets were built with. */
+void WriteBuildSettings(const std::filesystem::path& settingsPath, const BuildSettings& settings);
+
+/** @brief Remove recorded settings, so everything they covered is rebuilt next time. */
+void RemoveBuildSettings(const std::filesystem::path& settingsPath);
+} // namespace nc::convert
@@ -36,16 +36,16 @@ auto OpenOutFile(const std::filesystem::path& outPath) -> std::ofstream
 
     return outFile;
 }
+} // anonymous namespace
 
-auto GetAssetId(const std::filesystem::path& outPath) -> size_t
+namespace nc::convert
+{
+auto GetAssetId(const std::filesystem::path& ncaPath) -> size_t
 {
-    const auto ncaName = outPath.filename();
+    const auto ncaName = ncaPath.filename();
     return nc::utility::Fnv1a(ncaName.string());
 }
-} // anonymous namespace
 
-namespace nc::convert
-{
 Builder::Builder()
     : m_audioConverter{std::make_unique<AudioConverter>()},
       m_geometryConverter{std::make_unique<GeometryConverter>()},
@@ -55,40 +55,45 @@ Builder::Builder()
 
 Builder::~Builder() noexcept = default;
 
-auto Builder::Build(asset::AssetType type, const Target& target) -> bool
+auto Builder::Build(asset::AssetType type, const Target& target, std::string_view compression, size_t alignment) -> bool
 {
     auto outFile = ::OpenOutFile(target.destinationPath);
-    const auto assetId = ::GetAssetId(target.destinationPath);
+    return Build(type, target, outFile, compression, alignment);
+}
+
+auto Builder::Build(asset::AssetType type, const Target& target, std::ostream& out, std::string_view compression, size_t alignment) -> bool
+{
+    const auto assetId = GetAssetId(target.destinationPath);
     switch (type)
     {
         case asset::AssetType::AudioClip:
         {
             const auto asset = m_audioConverter->ImportAudioClip(target.sourcePath);
-            convert::Serialize(outFile, asset, assetId);
+            convert::Serialize(out, asset, assetId, compression, alignment);
             return true;
         }
         case asset::AssetType::CubeMap:
         {
             const auto asset = m_textureConverter->ImportCubeMap(target.sourcePath);
-            convert::Serialize(outFile, asset, assetId);
+            convert::Serialize(out, asset, assetId, compression, alignment);
             return true;
         }
         case asset::AssetType::ConcaveCollider:
         {
             const auto asset = m_geometryConverter->ImportConcaveCollider(target.sourcePath);
-            convert::Serialize(outFile, asset, assetId);
+            convert::Serialize(out, asset, assetId, compression, alignment);
             return true;
         }
         case asset::AssetType::HullCollider:
         {
             const auto asset = m_geometryConverter->ImportHullCollider(target.sourcePath);
-            convert::Serialize(outFile, asset, assetId);
+            convert::Serialize(out, asset, assetId, compression, alignment);
             return true;
         }
         case asset::AssetType::Mesh:
         {
             const auto asset = m_geometryConverter->ImportMesh(target.sourcePath, target.subResourceName);
-            convert::Serialize(outFile, asset, assetId);
+            convert::Serialize(out, asset, assetId, compression, alignment);
             return true;
         }
         case asset::AssetType::Shader:
@@ -98,13 +103,13 @@ auto Builder::Build(asset::AssetType type, const Target& target) -> bool
         case asset::AssetType::SkeletalAnimation:
         {
             const auto asset = m_geometryConverter->ImportSkeletalAnimation(target.sourcePath, target.subResourceName);
-            convert::Serialize(outFile, asset, assetId);
+            convert::Serialize(out, asset, assetId, compression, alignment);
             return true;
         }
         case asset::AssetType::Texture:
         {
             const auto asset = m_textureConverter->ImportTexture(target.sourcePath);
-            convert::Serialize(outFile, asset, assetId);
+            convert::Serialize(out, asset, assetId, compression, alignment);
             return true;
         }
         case asset::AssetType::Font:
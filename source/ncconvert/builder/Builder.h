@@ -1,8 +1,13 @@
 #pragma once
 
 #include "ncasset/AssetType.h"
+#include "ncasset/NcaHeader.h"
+#include "utility/BlobSize.h"
 
+#include <filesystem>
+#include <iosfwd>
 #include <memory>
+#include <string_view>
 
 namespace nc::convert
 {
@@ -11,6 +16,9 @@ class AudioConverter;
 class GeometryConverter;
 class TextureConverter;
 
+/** @brief Get the asset id for an output .nca path. */
+auto GetAssetId(const std::filesystem::path& ncaPath) -> size_t;
+
 /** @brief Manager that handles nca conversion and serialization. */
 class Builder
 {
@@ -18,8 +26,22 @@ class Builder
         Builder();
         ~Builder() noexcept;
 
-        /** @brief Create a new .nca file. */
-        auto Build(asset::AssetType type, const Target& target) -> bool;
+        /**
+         * @brief Create a new .nca file.
+         * @param compression An asset::CompressionAlgorithm identifier for the asset blob.
+         * @param alignment The alignment of array data within the nca.
+         */
+        auto Build(asset::AssetType type,
+                   const Target& target,
+                   std::string_view compression = asset::CompressionAlgorithm::none,
+                   size_t alignment = defaultBlobAlignment) -> bool;
+
+        /** @brief Convert a target and write the resulting nca to a stream. */
+        auto Build(asset::AssetType type,
+                   const Target& target,
+                   std::ostream& out,
+                   std::string_view compression = asset::CompressionAlgorithm::none,
+                   size_t alignment = defaultBlobAlignment) -> bool;
 
     private:
         std::unique_ptr<AudioConverter> m_audioConverter;
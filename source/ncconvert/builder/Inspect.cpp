@@ -3,7 +3,8 @@
 #include "utility/EnumExtensions.h"
 
 #include "ncasset/Import.h"
-#include "ncutility/NcError.h"
+
+#include <variant>
 
 namespace
 {
@@ -56,72 +57,50 @@ R"(Data
   width  {}
   height {})";
 
+void LogAsset(const nc::asset::AudioClip& asset)
+{
+    LOG(audioClipTemplate, asset.samplesPerChannel);
+}
+
+void LogAsset(const nc::asset::ConcaveCollider& asset)
+{
+    LOG(concaveColliderTemplate, asset.extents.x, asset.extents.y, asset.extents.z, asset.maxExtent, asset.triangles.size());
+}
+
+void LogAsset(const nc::asset::CubeMap& asset)
+{
+    LOG(cubeMapTemplate, asset.faceSideLength);
+}
+
+void LogAsset(const nc::asset::HullCollider& asset)
+{
+    LOG(concaveColliderTemplate, asset.extents.x, asset.extents.y, asset.extents.z, asset.maxExtent, asset.vertices.size());
+}
+
+void LogAsset(const nc::asset::Mesh& asset)
+{
+    auto vertexSpaceSize = asset.bonesData.has_value()? asset.bonesData.value().vertexSpaceToBoneSpace.size() : 0;
+    auto boneSpaceSize = asset.bonesData.has_value()? asset.bonesData.value().boneSpaceToParentSpace.size() : 0;
+    LOG(meshTemplate, asset.extents.x, asset.extents.y, asset.extents.z, asset.maxExtent, asset.vertices.size(), asset.indices.size(), vertexSpaceSize, boneSpaceSize);
+}
+
+void LogAsset(const nc::asset::SkeletalAnimation& asset)
+{
+    LOG(skeletalAnimationTemplate, asset.name, asset.durationInTicks, asset.ticksPerSecond, asset.framesPerBone.size());
+}
+
+void LogAsset(const nc::asset::Texture& asset)
+{
+    LOG(textureTemplate, asset.width, asset.height);
+}
 } // anonymous namespace
 
 namespace nc::convert
 {
 void Inspect(const std::filesystem::path& ncaPath)
 {
-    const auto header = asset::ImportNcaHeader(ncaPath);
-    const auto type = GetAssetType(header);
+    const auto [header, imported] = asset::ImportAnyWithHeader(ncaPath);
     LOG(headerTemplate, ncaPath.string(), header.magicNumber, header.compressionAlgorithm, header.assetId, header.size);
-
-    switch (type)
-    {
-        case asset::AssetType::AudioClip:
-        {
-            const auto asset = asset::ImportAudioClip(ncaPath);
-            LOG(audioClipTemplate, asset.samplesPerChannel);
-            break;
-        }
-        case asset::AssetType::ConcaveCollider:
-        {
-            const auto asset = asset::ImportConcaveCollider(ncaPath);
-            LOG(concaveColliderTemplate, asset.extents.x, asset.extents.y, asset.extents.z, asset.maxExtent, asset.triangles.size());
-            break;
-        }
-        case asset::AssetType::CubeMap:
-        {
-            const auto asset = asset::ImportCubeMap(ncaPath);
-            LOG(cubeMapTemplate, asset.faceSideLength);
-            break;
-        }
-        case asset::AssetType::HullCollider:
-        {
-            const auto asset = asset::ImportHullCollider(ncaPath);
-            LOG(concaveColliderTemplate, asset.extents.x, asset.extents.y, asset.extents.z, asset.maxExtent, asset.vertices.size());
-            break;
-        }
-        case asset::AssetType::Mesh:
-        {
-            const auto asset = asset::ImportMesh(ncaPath);
-            auto vertexSpaceSize = asset.bonesData.has_value()? asset.bonesData.value().vertexSpaceToBoneSpace.size() : 0;
-            auto boneSpaceSize = asset.bonesData.has_value()? asset.bonesData.value().boneSpaceToParentSpace.size() : 0;
-            LOG(meshTemplate, asset.extents.x, asset.extents.y, asset.extents.z, asset.maxExtent, asset.vertices.size(), asset.indices.size(), vertexSpaceSize, boneSpaceSize);
-            break;
-        }
-        case asset::AssetType::Shader:
-        {
-            LOG("Shader not supported");
-            break;
-        }
-        case asset::AssetType::SkeletalAnimation:
-        {
-            const auto asset = asset::ImportSkeletalAnimation(ncaPath);
-            LOG(skeletalAnimationTemplate, asset.name, asset.durationInTicks, asset.ticksPerSecond, asset.framesPerBone.size());
-            break;
-        }
-        case asset::AssetType::Texture:
-        {
-            const auto asset = asset::ImportTexture(ncaPath);
-            LOG(textureTemplate, asset.width, asset.height);
-            break;
-        }
-        case asset::AssetType::Font:
-        {
-            LOG("Font not supported");
-            break;
-        }
-    }
+    std::visit([](const auto& asset) { ::LogAsset(asset); }, imported);
 }
 } // namespace nc::convert
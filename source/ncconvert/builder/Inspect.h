@@ -4,6 +4,6 @@
 
 namespace nc::convert
 {
-/** @brief Print details about an asset. */
+/** @brief Print details about an asset. Throws for shaders and fonts, which cannot be imported. */
 void Inspect(const std::filesystem::path& ncaPath);
 } // namespace nc::convert
@@ -4,10 +4,12 @@
 #include "utility/Log.h"
 #include "utility/Path.h"
 
+#include "ncasset/NcaHeader.h"
 #include "ncutility/NcError.h"
 #include "nlohmann/json.hpp"
 
 #include <fstream>
+#include <utility>
 
 namespace
 {
@@ -19,12 +21,57 @@ struct GlobalManifestOptions
 {
     std::filesystem::path outputDirectory;
     std::filesystem::path workingDirectory;
+    std::optional<std::filesystem::path> packagePath;
+    std::optional<std::filesystem::path> loadTracePath;
+    std::unordered_map<nc::asset::AssetType, std::string_view> compression;
+    std::optional<size_t> blobAlignment;
+    std::optional<size_t> jobCount;
 };
 
 void from_json(const nlohmann::json& json, GlobalManifestOptions& options)
 {
     options.outputDirectory = json.value("outputDirectory", "./");
     options.workingDirectory = json.value("workingDirectory", "./");
+    if (json.contains("packagePath"))
+    {
+        options.packagePath = json.at("packagePath").get<std::string>();
+    }
+
+    if (json.contains("loadTrace"))
+    {
+        options.loadTracePath = json.at("loadTrace").get<std::string>();
+    }
+
+    if (json.contains("blobAlignment"))
+    {
+        options.blobAlignment = json.at("blobAlignment").get<size_t>();
+    }
+
+    if (json.contains("jobs"))
+    {
+        options.jobCount = json.at("jobs").get<size_t>();
+    }
+
+    // 'compression' is either one algorithm for every type, or an object of type tags to algorithms.
+    if (json.contains("compression"))
+    {
+        const auto& compression = json.at("compression");
+        if (compression.is_string())
+        {
+            const auto algorithm = nc::convert::ToCompressionAlgorithm(compression.get<std::string>());
+            for (const auto& typeTag : jsonAssetArrayTags)
+            {
+                options.compression.emplace(nc::convert::ToAssetType(typeTag), algorithm);
+            }
+        }
+        else
+        {
+            for (const auto& [typeTag, algorithm] : compression.items())
+            {
+                options.compression.emplace(nc::convert::ToAssetType(typeTag), nc::convert::ToCompressionAlgorithm(algorithm.get<std::string>()));
+            }
+        }
+    }
 }
 
 void ProcessOptions(GlobalManifestOptions& options, const std::filesystem::path& manifestPath)
@@ -43,6 +90,24 @@ void ProcessOptions(GlobalManifestOptions& options, const std::filesystem::path&
         options.outputDirectory = parentPath / options.outputDirectory;
     }
 
+    if (options.packagePath.has_value())
+    {
+        options.packagePath.value().make_preferred();
+        if (options.packagePath.value().is_relative())
+        {
+            options.packagePath = parentPath / options.packagePath.value();
+        }
+    }
+
+    if (options.loadTracePath.has_value())
+    {
+        options.loadTracePath.value().make_preferred();
+        if (options.loadTracePath.value().is_relative())
+        {
+            options.loadTracePath = parentPath / options.loadTracePath.value();
+        }
+    }
+
     LOG("Setting working directory: {}", options.workingDirectory.string());
     std::filesystem::current_path(options.workingDirectory);
 
@@ -72,21 +137,11 @@ auto BuildTarget(const std::string& assetName, const std::string& sourcePath, co
 
     return target;
 }
-
-auto IsUpToDate(const nc::convert::Target& target) -> bool
-{
-    if (!std::filesystem::exists(target.destinationPath))
-    {
-        return false;
-    }
-
-    return std::filesystem::last_write_time(target.destinationPath) > std::filesystem::last_write_time(target.sourcePath);
-}
 } // anonymous namespace
 
 namespace nc::convert
 {
-void ReadManifest(const std::filesystem::path& manifestPath, std::unordered_map<asset::AssetType, std::vector<Target>>& instructions)
+auto ReadManifest(const std::filesystem::path& manifestPath) -> ManifestOptions
 {
     auto file = std::ifstream{manifestPath};
     if (!file.is_open())
@@ -98,6 +153,16 @@ void ReadManifest(const std::filesystem::path& manifestPath, std::unordered_map<
     auto options = json.value("globalOptions", ::GlobalManifestOptions{});
     ::ProcessOptions(options, manifestPath);
 
+    auto manifest = ManifestOptions{
+        .targets = {},
+        .outputDirectory = std::move(options.outputDirectory),
+        .packagePath = std::move(options.packagePath),
+        .loadTracePath = std::move(options.loadTracePath),
+        .compression = std::move(options.compression),
+        .blobAlignment = options.blobAlignment,
+        .jobCount = options.jobCount
+    };
+
     for (const auto& typeTag : ::jsonAssetArrayTags)
     {
         if (!json.contains(typeTag))
@@ -106,6 +171,7 @@ void ReadManifest(const std::filesystem::path& manifestPath, std::unordered_map<
         }
 
         const auto type = ToAssetType(typeTag);
+        auto& targets = manifest.targets[type];
         for (const auto& asset : json.at(typeTag))
         {
             // Types that CanOutputMany support both single target (legacy) mode and multiple output mode.
@@ -116,27 +182,17 @@ void ReadManifest(const std::filesystem::path& manifestPath, std::unordered_map<
                 {
                     for (const auto& subResource : asset.at("assetNames"))
                     {
-                        auto target = BuildTarget(subResource.at("assetName"), asset.at("sourcePath"), options.outputDirectory, subResource.at("subResourceName"));
-                        if (::IsUpToDate(target))
-                        {
-                            LOG("Up-to-date: {}", target.destinationPath.string());
-                            continue;
-                        }
-                        instructions.at(type).push_back(std::move(target));
+                        targets.push_back(BuildTarget(subResource.at("assetName"), asset.at("sourcePath"), manifest.outputDirectory, subResource.at("subResourceName")));
                     }
                     continue;
                 }
             }
 
             // Single target mode
-            auto target = BuildTarget(asset.at("assetName"), asset.at("sourcePath"), options.outputDirectory);
-            if (::IsUpToDate(target))
-            {
-                LOG("Up-to-date: {}", target.destinationPath.string());
-                continue;
-            }
-            instructions.at(type).push_back(std::move(target));
+            targets.push_back(BuildTarget(asset.at("assetName"), asset.at("sourcePath"), manifest.outputDirectory));
         }
     }
+
+    return manifest;
 }
 } // namespace nc::convert
@@ -1,13 +1,33 @@
 #pragma once
 
+#include "Target.h"
+
 #include "ncasset/AssetType.h"
 
 #include <filesystem>
+#include <optional>
+#include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace nc::convert
 {
-struct Target;
-void ReadManifest(const std::filesystem::path& manifestPath, std::unordered_map<asset::AssetType, std::vector<Target>>& targets);
-}
\ No newline at end of file
+/** @brief Build targets and global options read from a manifest. Options the manifest omits are empty. */
+struct ManifestOptions
+{
+    std::unordered_map<asset::AssetType, std::vector<Target>> targets;
+    std::filesystem::path outputDirectory;
+    std::optional<std::filesystem::path> packagePath;
+    std::optional<std::filesystem::path> loadTracePath;
+    std::unordered_map<asset::AssetType, std::string_view> compression;
+    std::optional<size_t> blobAlignment;
+    std::optional<size_t> jobCount;
+};
+
+/**
+ * @brief Read build targets and global options from a manifest.
+ * @note Relative paths are resolved against the manifest, and the working directory and
+ *       output directory options are applied before targets are read.
+ */
+auto ReadManifest(const std::filesystem::path& manifestPath) -> ManifestOptions;
+} // namespace nc::convert
@@ -0,0 +1,472 @@
+#include "PackageWriter.h"
+#include "BuildSettings.h"
+#include "utility/Log.h"
+
+#include "ncasset/AssetPackage.h"
+#include "ncasset/Dictionary.h"
+#include "ncasset/Import.h"
+#include "ncutility/BinarySerialization.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <numeric>
+#include <utility>
+
+namespace
+{
+/** The asset id follows the magic number and compression algorithm in a serialized NcaHeader, then the blob size. */
+constexpr auto assetIdOffset = size_t{8};
+constexpr auto contentOffset = assetIdOffset + sizeof(size_t);
+
+/** Blobs are hashed and compared in chunks, so reused entries never need to be held in memory whole. */
+constexpr auto chunkSize = size_t{64 * 1024};
+
+auto ToUnixSeconds(std::filesystem::file_time_type time) -> int64_t
+{
+    const auto systemTime = std::chrono::file_clock::to_sys(time);
+    return std::chrono::duration_cast<std::chrono::seconds>(systemTime.time_since_epoch()).count();
+}
+
+auto Now() -> int64_t
+{
+    const auto now = std::chrono::system_clock::now();
+    return std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
+}
+
+auto AlignUp(size_t offset, size_t alignment) -> size_t
+{
+    return (offset + alignment - 1) / alignment * alignment;
+}
+
+auto CombineHash(size_t hash, std::string_view bytes) -> size_t
+{
+    return hash ^ (std::hash<std::string_view>{}(bytes) + 0x9e3779b97f4a7c15 + (hash << 6) + (hash >> 2));
+}
+
+/**
+ * Hash everything in an nca after its asset id, one blob chunk at a time, so an nca streamed in chunks
+ * hashes the same as one held in memory. The type and compression are compared on a match.
+ */
+auto GetContentHash(std::string_view nca) -> size_t
+{
+    auto hash = ::CombineHash(0, nca.substr(contentOffset, nc::asset::NcaHeader::binarySize - contentOffset));
+    for (auto position = nc::asset::NcaHeader::binarySize; position < nca.size(); position += chunkSize)
+    {
+        hash = ::CombineHash(hash, nca.substr(position, chunkSize));
+    }
+
+    return hash;
+}
+
+auto HasSameContent(std::string_view lhs, std::string_view rhs) -> bool
+{
+    return lhs.size() == rhs.size()
+        && lhs.substr(0, assetIdOffset) == rhs.substr(0, assetIdOffset)
+        && lhs.substr(contentOffset) == rhs.substr(contentOffset);
+}
+
+/** Compare two ncas of the same size a chunk at a time. Only the first chunk holds the header, with the asset id to skip. */
+auto HasSameContent(std::istream& lhs, std::istream& rhs, size_t size) -> bool
+{
+    auto lhsChunk = std::string(std::min(size, chunkSize), '\0');
+    auto rhsChunk = std::string(lhsChunk.size(), '\0');
+    for (auto position = size_t{0}; position < size; position += chunkSize)
+    {
+        const auto count = std::min(size - position, chunkSize);
+        if (!lhs.read(lhsChunk.data(), static_cast<std::streamsize>(count)) ||
+            !rhs.read(rhsChunk.data(), static_cast<std::streamsize>(count)))
+        {
+            throw nc::NcError("Failed comparing staged asset data");
+        }
+
+        const auto lhsBytes = std::string_view{lhsChunk}.substr(0, count);
+        const auto rhsBytes = std::string_view{rhsChunk}.substr(0, count);
+        if (position == 0 ? !::HasSameContent(lhsBytes, rhsBytes) : lhsBytes != rhsBytes)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CopyBytes(std::istream& in, std::ostream& out, size_t count)
+{
+    auto buffer = std::array<char, 64 * 1024>{};
+    while (count != 0)
+    {
+        const auto chunk = std::min(count, buffer.size());
+        if (!in.read(buffer.data(), static_cast<std::streamsize>(chunk)))
+        {
+            throw nc::NcError("Failed copying asset data");
+        }
+
+        out.write(buffer.data(), static_cast<std::streamsize>(chunk));
+        count -= chunk;
+    }
+}
+
+/** Copy a blob like CopyBytes(), folding each chunk into a content hash started by GetContentHash()'s rules. */
+auto CopyAndHashBlob(std::istream& in, std::ostream& out, size_t count, size_t hash) -> size_t
+{
+    auto buffer = std::array<char, chunkSize>{};
+    while (count != 0)
+    {
+        const auto chunk = std::min(count, buffer.size());
+        if (!in.read(buffer.data(), static_cast<std::streamsize>(chunk)))
+        {
+            throw nc::NcError("Failed copying asset data");
+        }
+
+        hash = ::CombineHash(hash, std::string_view{buffer.data(), chunk});
+        out.write(buffer.data(), static_cast<std::streamsize>(chunk));
+        count -= chunk;
+    }
+
+    return hash;
+}
+} // anonymous namespace
+
+namespace nc::convert
+{
+PackageWriter::PackageWriter(std::filesystem::path packagePath, size_t alignment)
+    : m_packagePath{std::move(packagePath)},
+      m_stagingPath{m_packagePath.string() + ".staging"},
+      m_alignment{alignment}
+{
+    ValidateBlobAlignment(m_alignment);
+    if (m_packagePath.has_parent_path())
+    {
+        const auto parentPath = m_packagePath.parent_path();
+        if (!std::filesystem::exists(parentPath) && !std::filesystem::create_directories(parentPath))
+        {
+            throw NcError("Could not create parent directories for: ", m_packagePath.string());
+        }
+    }
+
+    if (std::filesystem::exists(m_packagePath))
+    {
+        try
+        {
+            m_previous = std::make_unique<asset::AssetPackage>(m_packagePath);
+            LOG("Found existing package with {} entries", m_previous->GetEntries().size());
+
+            // Alignment pads array data inside each nca, so entries built with another alignment cannot be copied.
+            const auto previousSettings = ReadBuildSettings(GetPackageSettingsPath(m_packagePath));
+            m_previousMatchesSettings = previousSettings == BuildSettings{m_alignment};
+            if (!previousSettings)
+            {
+                LOG("Existing package has no recorded build settings, its entries will be rebuilt");
+            }
+            else if (!m_previousMatchesSettings)
+            {
+                LOG("Existing package was built with blob alignment {}, its entries will be rebuilt", previousSettings->blobAlignment);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            LOG("Existing package will be rebuilt: {}", e.what());
+        }
+    }
+
+    m_staging.open(m_stagingPath, std::ios::binary | std::ios::trunc);
+    if (!m_staging.is_open())
+    {
+        throw NcError("Could not open staging file: ", m_stagingPath.string());
+    }
+}
+
+PackageWriter::~PackageWriter() noexcept
+{
+    if (!m_finalized)
+    {
+        m_staging.close();
+        auto ec = std::error_code{};
+        std::filesystem::remove(m_stagingPath, ec);
+    }
+}
+
+auto PackageWriter::TryReuse(size_t assetId, const std::filesystem::path& sourcePath, std::string_view compression) -> bool
+{
+    if (!m_previous || !m_previousMatchesSettings || !m_previous->Contains(assetId) || m_ids.contains(assetId))
+    {
+        return false;
+    }
+
+    const auto& entry = m_previous->GetEntry(assetId);
+    if (entry.lastUpdated <= ::ToUnixSeconds(std::filesystem::last_write_time(sourcePath)))
+    {
+        return false;
+    }
+
+    if (std::string_view{asset::ImportNcaHeader(*m_previous, assetId).compressionAlgorithm} != compression)
+    {
+        return false;
+    }
+
+    CopyFromPrevious(entry);
+    return true;
+}
+
+void PackageWriter::Add(size_t assetId, std::string_view nca)
+{
+    Stage(assetId, ::Now(), nca);
+}
+
+void PackageWriter::CarryForwardUnreferenced()
+{
+    if (!m_previous)
+    {
+        return;
+    }
+
+    for (const auto& entry : m_previous->GetEntries())
+    {
+        if (m_ids.contains(entry.assetId))
+        {
+            continue;
+        }
+
+        if (!m_previousMatchesSettings)
+        {
+            throw NcError(fmt::format("Existing package was built with other settings, rebuild it from its manifest "
+                                      "to use blob alignment {}: {}", m_alignment, m_packagePath.string()));
+        }
+
+        CopyFromPrevious(entry);
+    }
+}
+
+void PackageWriter::SetLoadOrder(std::span<const size_t> assetIds)
+{
+    m_loadOrder.clear();
+    for (const auto assetId : assetIds)
+    {
+        m_loadOrder.try_emplace(assetId, m_loadOrder.size());
+    }
+}
+
+void PackageWriter::Finalize()
+{
+    m_staging.close();
+    if (!m_staging)
+    {
+        throw NcError("Failed writing staging file: ", m_stagingPath.string());
+    }
+
+    // Release the previous package before it is replaced.
+    m_previous.reset();
+
+    // Each staged nca starts at the next aligned offset after the previous one, with zero padding
+    // between. An nca shared by several entries is placed at the first of them in the layout.
+    const auto layout = GetLayout();
+    const auto dataOffset = asset::NcpHeader::binarySize
+                          + layout.size() * asset::LutEntry::binarySize
+                          + asset::GetLutBucketCount(layout.size()) * sizeof(uint32_t);
+    auto entries = std::vector<asset::LutEntry>{};
+    auto placed = std::unordered_map<size_t, size_t>{};
+    auto blobs = std::vector<size_t>{};
+    entries.reserve(layout.size());
+    auto offset = dataOffset;
+    for (const auto index : layout)
+    {
+        entries.push_back(m_entries[index]);
+        const auto [pos, isNew] = placed.try_emplace(m_entries[index].offset, ::AlignUp(offset, m_alignment));
+        entries.back().offset = pos->second;
+        if (isNew)
+        {
+            blobs.push_back(index);
+            offset = pos->second + m_sizes[index];
+        }
+    }
+
+    if (m_deduplicatedBytes != 0)
+    {
+        LOG("Stored {} duplicate assets once, saving {} bytes", layout.size() - blobs.size(), m_deduplicatedBytes);
+    }
+
+    const auto tempPath = std::filesystem::path{m_packagePath.string() + ".tmp"};
+    {
+        auto out = std::ofstream{tempPath, std::ios::binary | std::ios::trunc};
+        if (!out.is_open())
+        {
+            throw NcError("Could not open output file: ", tempPath.string());
+        }
+
+        auto header = asset::NcpHeader{};
+        header.assetCount = entries.size();
+        nc::serialize::Serialize(out, header);
+
+        // Entries are written in hash slot order, independent of the asset layout.
+        const auto seeds = asset::BuildLutHash(entries);
+        for (const auto& entry : entries)
+        {
+            nc::serialize::Serialize(out, entry);
+        }
+
+        out.write(reinterpret_cast<const char*>(seeds.data()), static_cast<std::streamsize>(seeds.size() * sizeof(uint32_t)));
+
+        if (!blobs.empty())
+        {
+            static constexpr auto zeros = std::array<char, maxBlobAlignment>{};
+            auto staged = std::ifstream{m_stagingPath, std::ios::binary};
+            auto written = dataOffset;
+            for (const auto index : blobs)
+            {
+                const auto blobOffset = placed.at(m_entries[index].offset);
+                out.write(zeros.data(), static_cast<std::streamsize>(blobOffset - written));
+                staged.seekg(static_cast<std::streamoff>(m_entries[index].offset));
+                ::CopyBytes(staged, out, m_sizes[index]);
+                written = blobOffset + m_sizes[index];
+            }
+        }
+
+        if (!out)
+        {
+            throw NcError("Failed writing package: ", tempPath.string());
+        }
+    }
+
+    // The settings are removed first, so a failed write leaves nothing that claims the new package's entries are reusable.
+    const auto settingsPath = GetPackageSettingsPath(m_packagePath);
+    RemoveBuildSettings(settingsPath);
+    std::filesystem::rename(tempPath, m_packagePath);
+    std::filesystem::remove(m_stagingPath);
+    WriteBuildSettings(settingsPath, BuildSettings{m_alignment});
+    m_finalized = true;
+}
+
+void PackageWriter::Stage(size_t assetId, int64_t lastUpdated, std::string_view nca)
+{
+    if (!m_ids.insert(assetId).second)
+    {
+        throw NcError("Duplicate asset id in package: ", std::to_string(assetId));
+    }
+
+    const auto offset = static_cast<size_t>(m_staging.tellp());
+    m_staging.write(nca.data(), static_cast<std::streamsize>(nca.size()));
+    if (nca.size() < asset::NcaHeader::binarySize)
+    {
+        m_entries.push_back(asset::LutEntry{assetId, offset, lastUpdated});
+        m_sizes.push_back(nca.size());
+        return;
+    }
+
+    CommitStaged(assetId, lastUpdated, offset, nca.size(), ::GetContentHash(nca));
+}
+
+/** Add an entry for an nca just written to staging, or point it at an identical staged nca and drop the copy. */
+void PackageWriter::CommitStaged(size_t assetId, int64_t lastUpdated, size_t offset, size_t size, size_t contentHash)
+{
+    if (const auto stagedOffset = FindStaged(contentHash, offset, size))
+    {
+        // The next nca is staged over the dropped copy. Any bytes it leaves behind are never referenced.
+        m_staging.seekp(static_cast<std::streamoff>(offset));
+        m_entries.push_back(asset::LutEntry{assetId, stagedOffset.value(), lastUpdated});
+        m_sizes.push_back(size);
+        m_deduplicatedBytes += size;
+        return;
+    }
+
+    m_contentHashes.emplace(contentHash, m_entries.size());
+    m_entries.push_back(asset::LutEntry{assetId, offset, lastUpdated});
+    m_sizes.push_back(size);
+}
+
+/** Find the staging offset of an nca with the same content as the one at offset, comparing bytes as hashes may collide. */
+auto PackageWriter::FindStaged(size_t contentHash, size_t offset, size_t size) -> std::optional<size_t>
+{
+    const auto [begin, end] = m_contentHashes.equal_range(contentHash);
+    if (begin == end)
+    {
+        return std::nullopt;
+    }
+
+    m_staging.flush();
+    auto candidate = std::ifstream{m_stagingPath, std::ios::binary};
+    auto staged = std::ifstream{m_stagingPath, std::ios::binary};
+    for (auto pos = begin; pos != end; ++pos)
+    {
+        const auto& entry = m_entries[pos->second];
+        if (m_sizes[pos->second] != size)
+        {
+            continue;
+        }
+
+        candidate.seekg(static_cast<std::streamoff>(entry.offset));
+        staged.seekg(static_cast<std::streamoff>(offset));
+        if (::HasSameContent(candidate, staged, size))
+        {
+            return entry.offset;
+        }
+    }
+
+    return std::nullopt;
+}
+
+void PackageWriter::CopyFromPrevious(const asset::LutEntry& entry)
+{
+    m_ids.insert(entry.assetId);
+    const auto offset = static_cast<size_t>(m_staging.tellp());
+    const auto [size, contentHash] = m_previous->Read(entry.assetId, [&](std::istream& stream)
+    {
+        auto header = std::array<char, asset::NcaHeader::binarySize>{};
+        if (!stream.read(header.data(), static_cast<std::streamsize>(header.size())))
+        {
+            throw NcError("Failed copying asset data");
+        }
+
+        // A shared nca's header names only one of its assets. This entry's own id is restored, as the
+        // asset it was shared with may have changed or been dropped.
+        std::memcpy(header.data() + assetIdOffset, &entry.assetId, sizeof(entry.assetId));
+        auto blobSize = size_t{};
+        std::memcpy(&blobSize, header.data() + contentOffset, sizeof(blobSize));
+
+        const auto headerBytes = std::string_view{header.data(), header.size()};
+        m_staging.write(header.data(), static_cast<std::streamsize>(header.size()));
+        const auto hash = ::CopyAndHashBlob(stream, m_staging, blobSize, ::CombineHash(0, headerBytes.substr(contentOffset)));
+        return std::pair{header.size() + blobSize, hash};
+    });
+
+    CommitStaged(entry.assetId, entry.lastUpdated, offset, size, contentHash);
+}
+
+auto PackageWriter::GetLayout() const -> std::vector<size_t>
+{
+    // Dictionaries rank first, then loaded assets by first load, then cold assets.
+    const auto coldRank = m_loadOrder.size() + 1;
+    const auto getRank = [this, coldRank](const asset::LutEntry& entry)
+    {
+        if (asset::IsDictionaryAssetId(entry.assetId))
+        {
+            return size_t{0};
+        }
+
+        const auto pos = m_loadOrder.find(entry.assetId);
+        return pos == m_loadOrder.cend() ? coldRank : pos->second + 1;
+    };
+
+    auto layout = std::vector<size_t>(m_entries.size());
+    std::iota(layout.begin(), layout.end(), size_t{0});
+    std::stable_sort(layout.begin(), layout.end(), [&](size_t lhs, size_t rhs)
+    {
+        return getRank(m_entries[lhs]) < getRank(m_entries[rhs]);
+    });
+
+    if (!m_loadOrder.empty())
+    {
+        const auto cold = std::count_if(m_entries.cbegin(), m_entries.cend(), [&](const asset::LutEntry& entry)
+        {
+            return getRank(entry) == coldRank;
+        });
+
+        LOG("Laying out package by load order: {} cold assets", cold);
+    }
+
+    return layout;
+}
+} // namespace nc::convert
@@ -0,0 +1,102 @@
+#pragma once
+
+#include "ncasset/NcpHeader.h"
+#include "utility/BlobSize.h"
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace nc::asset
+{
+class AssetPackage;
+} // namespace nc::asset
+
+namespace nc::convert
+{
+/**
+ * @brief Assembles built assets into an .ncp package.
+ *
+ * Entries are staged in a temporary file and the package is only replaced
+ * once Finalize() succeeds. If a package already exists at the output path,
+ * its entries may be reused instead of rebuilding unchanged assets. Entries are
+ * only reused if the package was built with the same blob alignment, which is
+ * recorded next to it.
+ *
+ * Assets are laid out with zstd dictionaries first, as they are read when the
+ * package is opened, then in load order if one is set, then everything else.
+ * Each asset starts at a multiple of the blob alignment, so array data built
+ * with the same alignment stays aligned when the package is mapped.
+ *
+ * Assets whose ncas are identical apart from their asset id are stored once,
+ * with every one of their look up table entries pointing at the same offset.
+ */
+class PackageWriter
+{
+    public:
+        explicit PackageWriter(std::filesystem::path packagePath, size_t alignment = defaultBlobAlignment);
+        ~PackageWriter() noexcept;
+
+        PackageWriter(const PackageWriter&) = delete;
+        PackageWriter& operator=(const PackageWriter&) = delete;
+
+        /**
+         * @brief Copy an asset from the previous package if it is newer than its source file
+         *        and was compressed with the requested codec.
+         * @return True if the asset was reused, false if it needs to be built.
+         */
+        auto TryReuse(size_t assetId, const std::filesystem::path& sourcePath, std::string_view compression) -> bool;
+
+        /** @brief Add a complete serialized nca (header and blob) to the package. */
+        void Add(size_t assetId, std::string_view nca);
+
+        /**
+         * @brief Copy all previous package entries that have not been added or reused.
+         * @note Throws if the previous package was built with a different blob alignment.
+         */
+        void CarryForwardUnreferenced();
+
+        /**
+         * @brief Lay out assets in first-load order, as recorded by an ncasset load trace.
+         * @note Assets missing from the order are placed after all ordered assets, in the
+         *       order they were added, so they do not interrupt sequential startup reads.
+         */
+        void SetLoadOrder(std::span<const size_t> assetIds);
+
+        /** @brief Write the header, look up table, and staged assets to the package file. */
+        void Finalize();
+
+        /** @brief Get the number of bytes not written because assets shared an identical nca. */
+        auto GetDeduplicatedBytes() const noexcept -> size_t
+        {
+            return m_deduplicatedBytes;
+        }
+
+    private:
+        std::filesystem::path m_packagePath;
+        std::filesystem::path m_stagingPath;
+        std::ofstream m_staging;
+        std::unique_ptr<asset::AssetPackage> m_previous;
+        bool m_previousMatchesSettings = false;
+        std::vector<asset::LutEntry> m_entries;
+        std::vector<size_t> m_sizes;
+        std::unordered_set<size_t> m_ids;
+        std::unordered_multimap<size_t, size_t> m_contentHashes;
+        std::unordered_map<size_t, size_t> m_loadOrder;
+        size_t m_alignment;
+        size_t m_deduplicatedBytes = 0;
+        bool m_finalized = false;
+
+        void Stage(size_t assetId, int64_t lastUpdated, std::string_view nca);
+        void CommitStaged(size_t assetId, int64_t lastUpdated, size_t offset, size_t size, size_t contentHash);
+        auto FindStaged(size_t contentHash, size_t offset, size_t size) -> std::optional<size_t>;
+        void CopyFromPrevious(const asset::LutEntry& entry);
+        auto GetLayout() const -> std::vector<size_t>;
+};
+} // namespace nc::convert
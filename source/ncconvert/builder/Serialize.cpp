@@ -1,59 +1,262 @@
 #include "Serialize.h"
 #include "utility/BlobSize.h"
+#include "utility/Compress.h"
 #include "ncasset/Assets.h"
+#include "ncasset/Dictionary.h"
 #include "ncasset/NcaHeader.h"
+#include "ncutility/NcError.h"
 
-#include "ncutility/BinarySerialization.h"
-
+#include <array>
 #include <cstring>
 #include <iostream>
+#include <span>
+#include <sstream>
+#include <type_traits>
 
 namespace
 {
+/** A stream positioned within a blob, tracking the blob offset so arrays can be aligned. */
+struct BlobStream
+{
+    std::ostream& stream;
+    size_t alignment;
+    size_t offset = 0;
+};
+
+template<class T>
+    requires std::is_trivially_copyable_v<T>
+void Write(BlobStream& out, const T& data)
+{
+    out.stream.write(reinterpret_cast<const char*>(&data), sizeof(T));
+    out.offset += sizeof(T);
+}
+
+void WriteBytes(BlobStream& out, const void* data, size_t size)
+{
+    out.stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    out.offset += size;
+}
+
+void WriteString(BlobStream& out, const std::string& data)
+{
+    ::Write(out, data.size());
+    ::WriteBytes(out, data.data(), data.size());
+}
+
+/**
+ * Arrays of trivially copyable elements are written with a single call, after padding that aligns
+ * the first element. The padding size is recorded so readers never need to know the alignment.
+ */
+template<class T>
+    requires std::is_trivially_copyable_v<T>
+void WriteVector(BlobStream& out, const std::vector<T>& data)
+{
+    static constexpr auto zeros = std::array<char, nc::convert::maxBlobAlignment>{};
+    const auto padding = nc::convert::GetArrayPadding(out.offset, out.alignment);
+    ::Write(out, static_cast<uint64_t>(data.size()));
+    ::Write(out, static_cast<uint32_t>(padding));
+    ::WriteBytes(out, zeros.data(), padding);
+    ::WriteBytes(out, data.data(), data.size() * sizeof(T));
+}
+
+template<class T, class ElementWriter>
+void WriteVector(BlobStream& out, const std::vector<T>& data, ElementWriter writeElement)
+{
+    ::Write(out, data.size());
+    for (const auto& element : data)
+    {
+        writeElement(out, element);
+    }
+}
+
+template<class T, class ValueWriter>
+void WriteMap(BlobStream& out, const std::unordered_map<std::string, T>& data, ValueWriter writeValue)
+{
+    ::Write(out, data.size());
+    for (const auto& [key, value] : data)
+    {
+        ::WriteString(out, key);
+        writeValue(out, value);
+    }
+}
+
+void WriteBonesData(BlobStream& out, const std::optional<nc::asset::BonesData>& data)
+{
+    ::Write(out, data.has_value());
+    if (!data)
+    {
+        return;
+    }
+
+    ::WriteMap(out, data->boneMapping, [](BlobStream& stream, uint32_t index) { ::Write(stream, index); });
+    ::WriteVector(out, data->vertexSpaceToBoneSpace, [](BlobStream& stream, const nc::asset::VertexSpaceToBoneSpace& bone)
+    {
+        ::WriteString(stream, bone.boneName);
+        ::Write(stream, bone.transformationMatrix);
+    });
+
+    ::WriteVector(out, data->boneSpaceToParentSpace, [](BlobStream& stream, const nc::asset::BoneSpaceToParentSpace& bone)
+    {
+        ::WriteString(stream, bone.boneName);
+        ::Write(stream, bone.transformationMatrix);
+        ::Write(stream, bone.numChildren);
+        ::Write(stream, bone.indexOfFirstChild);
+    });
+}
+
+void WriteBlob(BlobStream& out, const nc::asset::AudioClip& data)
+{
+    ::Write(out, data.samplesPerChannel);
+    ::WriteVector(out, data.leftChannel);
+    ::WriteVector(out, data.rightChannel);
+}
+
+void WriteBlob(BlobStream& out, const nc::asset::ConcaveCollider& data)
+{
+    ::Write(out, data.extents);
+    ::Write(out, data.maxExtent);
+    ::WriteVector(out, data.triangles);
+}
+
+void WriteBlob(BlobStream& out, const nc::asset::CubeMap& data)
+{
+    ::Write(out, data.faceSideLength);
+    ::WriteVector(out, data.pixelData);
+}
+
+void WriteBlob(BlobStream& out, const nc::asset::HullCollider& data)
+{
+    ::Write(out, data.extents);
+    ::Write(out, data.maxExtent);
+    ::WriteVector(out, data.vertices);
+}
+
+void WriteBlob(BlobStream& out, const nc::asset::Mesh& data)
+{
+    static_assert(sizeof(data.extents) + sizeof(data.maxExtent) == nc::asset::MeshSectionTable::blobOffset);
+    ::Write(out, data.extents);
+    ::Write(out, data.maxExtent);
+    ::Write(out, nc::convert::GetMeshSections(data, out.alignment));
+    ::WriteVector(out, data.vertices);
+    ::WriteVector(out, data.indices);
+    ::WriteBonesData(out, data.bonesData);
+}
+
+void WriteBlob(BlobStream& out, const nc::asset::SkeletalAnimation& data)
+{
+    ::WriteString(out, data.name);
+    ::Write(out, data.durationInTicks);
+    ::Write(out, data.ticksPerSecond);
+    ::WriteMap(out, data.framesPerBone, [](BlobStream& stream, const nc::asset::SkeletalAnimationFrames& frames)
+    {
+        ::WriteVector(stream, frames.positionFrames);
+        ::WriteVector(stream, frames.rotationFrames);
+        ::WriteVector(stream, frames.scaleFrames);
+    });
+}
+
+void WriteBlob(BlobStream& out, const nc::asset::Texture& data)
+{
+    ::Write(out, data.width);
+    ::Write(out, data.height);
+    ::WriteVector(out, data.pixelData);
+}
+
+/** Compress a blob and write it with a header recording the algorithm and stored size. */
+void WriteCompressed(std::ostream& stream,
+                     nc::asset::NcaHeader header,
+                     std::span<const std::byte> blob,
+                     std::string_view compression,
+                     const nc::convert::CompressionDictionary* dictionary)
+{
+    const auto compressed = nc::convert::CompressBlob(blob, compression, dictionary);
+    std::memcpy(header.compressionAlgorithm, compression.data(), compression.size());
+    header.compressionAlgorithm[compression.size()] = '\0';
+    header.size = compressed.size();
+    nc::asset::Serialize(stream, header);
+    stream.write(reinterpret_cast<const char*>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+}
+
 template<class T>
-void SerializeImpl(std::ostream& stream, const T& data, std::string_view magicNumber, size_t assetId)
+void SerializeImpl(std::ostream& stream, const T& data, std::string_view magicNumber, size_t assetId, std::string_view compression, size_t alignment)
 {
-    auto header = nc::asset::NcaHeader{"", "NONE", assetId, nc::convert::GetBlobSize(data)};
+    nc::convert::ValidateBlobAlignment(alignment);
+    auto header = nc::asset::NcaHeader{"", "NONE", assetId, nc::convert::GetBlobSize(data, alignment)};
     std::memcpy(header.magicNumber, magicNumber.data(), 5);
-    nc::serialize::Serialize(stream, header);
-    nc::serialize::Serialize(stream, data);
+    if (compression == nc::asset::CompressionAlgorithm::none)
+    {
+        nc::asset::Serialize(stream, header);
+        auto out = BlobStream{stream, alignment};
+        ::WriteBlob(out, data);
+        return;
+    }
+
+    // Compressed blobs are staged in memory so the stored size is known before writing the header.
+    auto blob = std::ostringstream{std::ios::binary};
+    auto out = BlobStream{blob, alignment};
+    ::WriteBlob(out, data);
+    const auto view = blob.view();
+    ::WriteCompressed(stream, header, std::as_bytes(std::span{view.data(), view.size()}), compression, nullptr);
 }
 } // anonymous namespace
 
 namespace nc::convert
 {
-void Serialize(std::ostream& stream, const asset::AudioClip& data, size_t assetId)
+void Serialize(std::ostream& stream, const asset::AudioClip& data, size_t assetId, std::string_view compression, size_t alignment)
 {
-    SerializeImpl(stream, data, asset::MagicNumber::audioClip, assetId);
+    SerializeImpl(stream, data, asset::MagicNumber::audioClip, assetId, compression, alignment);
 }
 
-void Serialize(std::ostream& stream, const asset::ConcaveCollider& data, size_t assetId)
+void Serialize(std::ostream& stream, const asset::ConcaveCollider& data, size_t assetId, std::string_view compression, size_t alignment)
 {
-    SerializeImpl(stream, data, asset::MagicNumber::concaveCollider, assetId);
+    SerializeImpl(stream, data, asset::MagicNumber::concaveCollider, assetId, compression, alignment);
 }
 
-void Serialize(std::ostream& stream, const asset::CubeMap& data, size_t assetId)
+void Serialize(std::ostream& stream, const asset::CubeMap& data, size_t assetId, std::string_view compression, size_t alignment)
 {
-    SerializeImpl(stream, data, asset::MagicNumber::cubeMap, assetId);
+    SerializeImpl(stream, data, asset::MagicNumber::cubeMap, assetId, compression, alignment);
 }
 
-void Serialize(std::ostream& stream, const asset::HullCollider& data, size_t assetId)
+void Serialize(std::ostream& stream, const asset::HullCollider& data, size_t assetId, std::string_view compression, size_t alignment)
 {
-    SerializeImpl(stream, data, asset::MagicNumber::hullCollider, assetId);
+    SerializeImpl(stream, data, asset::MagicNumber::hullCollider, assetId, compression, alignment);
 }
 
-void Serialize(std::ostream& stream, const asset::Mesh& data, size_t assetId)
+void Serialize(std::ostream& stream, const asset::Mesh& data, size_t assetId, std::string_view compression, size_t alignment)
 {
-    SerializeImpl(stream, data, asset::MagicNumber::mesh, assetId);
+    SerializeImpl(stream, data, asset::MagicNumber::mesh, assetId, compression, alignment);
 }
 
-void Serialize(std::ostream& stream, const asset::SkeletalAnimation& data, size_t assetId)
+void Serialize(std::ostream& stream, const asset::SkeletalAnimation& data, size_t assetId, std::string_view compression, size_t alignment)
 {
-    SerializeImpl(stream, data, asset::MagicNumber::skeletalAnimation, assetId);
+    SerializeImpl(stream, data, asset::MagicNumber::skeletalAnimation, assetId, compression, alignment);
 }
 
-void Serialize(std::ostream& stream, const asset::Texture& data, size_t assetId)
+void Serialize(std::ostream& stream, const asset::Texture& data, size_t assetId, std::string_view compression, size_t alignment)
 {
-    SerializeImpl(stream, data, asset::MagicNumber::texture, assetId);
+    SerializeImpl(stream, data, asset::MagicNumber::texture, assetId, compression, alignment);
+}
+
+void Serialize(std::ostream& stream, const CompressionDictionary& dictionary)
+{
+    const auto bytes = dictionary.GetBytes();
+    auto header = asset::NcaHeader{"", "NONE", asset::GetDictionaryAssetId(dictionary.GetId()), bytes.size()};
+    std::memcpy(header.magicNumber, asset::MagicNumber::dictionary.data(), 5);
+    asset::Serialize(stream, header);
+    stream.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+}
+
+void Compress(std::ostream& stream, std::string_view nca, std::string_view compression, const CompressionDictionary* dictionary)
+{
+    auto header = asset::NcaHeader{};
+    auto in = std::istringstream{std::string{nca.substr(0, asset::NcaHeader::binarySize)}, std::ios::binary};
+    asset::Deserialize(in, header);
+    if (!in || std::string_view{header.compressionAlgorithm} != asset::CompressionAlgorithm::none)
+    {
+        throw NcError("Expected an uncompressed nca");
+    }
+
+    const auto blob = nca.substr(asset::NcaHeader::binarySize);
+    ::WriteCompressed(stream, header, std::as_bytes(std::span{blob.data(), blob.size()}), compression, dictionary);
 }
 } // namespace nc::convert
@@ -1,29 +1,48 @@
 #pragma once
 
 #include "ncasset/AssetsFwd.h"
+#include "ncasset/NcaHeader.h"
+#include "utility/BlobSize.h"
 
 #include <iosfwd>
+#include <string_view>
 
 namespace nc::convert
 {
-/** @brief Write an AudioClip to a binary stream. */
-void Serialize(std::ostream& stream, const asset::AudioClip& data, size_t assetId);
+class CompressionDictionary;
+
+/**
+ * @brief Write an AudioClip to a binary stream.
+ * @note If compression is not CompressionAlgorithm::none, the blob is compressed and the
+ *       header records the algorithm and compressed size. Array data is padded to start at a
+ *       multiple of alignment bytes from the start of the nca. The same applies to all overloads.
+ */
+void Serialize(std::ostream& stream, const asset::AudioClip& data, size_t assetId, std::string_view compression = asset::CompressionAlgorithm::none, size_t alignment = defaultBlobAlignment);
 
 /** @brief Write a ConcaveCollider to a binary stream. */
-void Serialize(std::ostream& stream, const asset::ConcaveCollider& data, size_t assetId);
+void Serialize(std::ostream& stream, const asset::ConcaveCollider& data, size_t assetId, std::string_view compression = asset::CompressionAlgorithm::none, size_t alignment = defaultBlobAlignment);
 
 /** @brief Write a CubeMap to a binary stream. */
-void Serialize(std::ostream& stream, const asset::CubeMap& data, size_t assetId);
+void Serialize(std::ostream& stream, const asset::CubeMap& data, size_t assetId, std::string_view compression = asset::CompressionAlgorithm::none, size_t alignment = defaultBlobAlignment);
 
 /** @brief Write a HullCollider to a binary stream. */
-void Serialize(std::ostream& stream, const asset::HullCollider& data, size_t assetId);
+void Serialize(std::ostream& stream, const asset::HullCollider& data, size_t assetId, std::string_view compression = asset::CompressionAlgorithm::none, size_t alignment = defaultBlobAlignment);
 
 /** @brief Write a Mesh to a binary stream. */
-void Serialize(std::ostream& stream, const asset::Mesh& data, size_t assetId);
+void Serialize(std::ostream& stream, const asset::Mesh& data, size_t assetId, std::string_view compression = asset::CompressionAlgorithm::none, size_t alignment = defaultBlobAlignment);
 
 /** @brief Write a SkeletalAnimation to a binary stream. */
-void Serialize(std::ostream& stream, const asset::SkeletalAnimation& data, size_t assetId);
+void Serialize(std::ostream& stream, const asset::SkeletalAnimation& data, size_t assetId, std::string_view compression = asset::CompressionAlgorithm::none, size_t alignment = defaultBlobAlignment);
 
 /** @brief Write a Texture to a binary stream. */
-void Serialize(std::ostream& stream, const asset::Texture& data, size_t assetId);
+void Serialize(std::ostream& stream, const asset::Texture& data, size_t assetId, std::string_view compression = asset::CompressionAlgorithm::none, size_t alignment = defaultBlobAlignment);
+
+/** @brief Write a zstd dictionary record: a DICT header with the dictionary's reserved asset id and the raw dictionary. */
+void Serialize(std::ostream& stream, const CompressionDictionary& dictionary);
+
+/**
+ * @brief Write a compressed copy of a serialized, uncompressed nca.
+ * @param dictionary A dictionary to compress with. Only used for CompressionAlgorithm::zstd.
+ */
+void Compress(std::ostream& stream, std::string_view nca, std::string_view compression, const CompressionDictionary* dictionary);
 } // nc::convert
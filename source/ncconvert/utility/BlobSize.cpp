@@ -1,6 +1,9 @@
 #include "BlobSize.h"
 
 #include "ncasset/Assets.h"
+#include "ncasset/NcaHeader.h"
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
 
 namespace
 {
@@ -11,8 +14,9 @@ auto GetBonesSize(const std::optional<nc::asset::BonesData>& bonesData) -> size_
     auto out = size_t{0};
     if (bonesData.has_value())
     {
-        out += sizeof(size_t);
-        out += sizeof(size_t);
+        out += sizeof(size_t); // boneMapping count
+        out += sizeof(size_t); // vertexSpaceToBoneSpace count
+        out += sizeof(size_t); // boneSpaceToParentSpace count
 
         for (const auto& [boneName, index] : bonesData.value().boneMapping)
         {
@@ -32,69 +36,128 @@ auto GetBonesSize(const std::optional<nc::asset::BonesData>& bonesData) -> size_
     return out;
 }
 
-auto GetSkeletalAnimationSize(const nc::asset::SkeletalAnimation& asset) -> size_t
+/** Accumulates the size of a blob field by field, placing arrays as the writer does. */
+class BlobLayout
 {
-    auto baseSize = sizeof(size_t)    + // name size
-                    asset.name.size() + // name
-                    sizeof(uint32_t)  + // durationInTicks
-                    sizeof(float)     + // ticksPerSecond
-                    sizeof(size_t);     // framesPerBone count
+    public:
+        explicit BlobLayout(size_t alignment) noexcept
+            : m_alignment{alignment}
+        {
+        }
 
-    for (const auto& [name, frames] : asset.framesPerBone)
+        void Add(size_t size) noexcept
+        {
+            m_size += size;
+        }
+
+        void AddArray(size_t count, size_t elementSize) noexcept
+        {
+            m_size += nc::convert::GetArrayPadding(m_size, m_alignment) + nc::convert::arrayPrefixSize + count * elementSize;
+        }
+
+        void AddString(size_t length) noexcept
+        {
+            m_size += sizeof(size_t) + length;
+        }
+
+        auto Size() const noexcept -> size_t
+        {
+            return m_size;
+        }
+
+    private:
+        size_t m_alignment;
+        size_t m_size = 0;
+};
+}  // anonymous namespace
+
+namespace nc::convert
+{
+void ValidateBlobAlignment(size_t alignment)
+{
+    if (alignment == 0 || alignment > maxBlobAlignment || (alignment & (alignment - 1)) != 0)
     {
-        baseSize += sizeof(size_t);
-        baseSize += name.size();
-        baseSize += sizeof(size_t);
-        baseSize += frames.positionFrames.size() * sizeof(nc::asset::PositionFrame);
-        baseSize += sizeof(size_t);
-        baseSize += frames.rotationFrames.size() * sizeof(nc::asset::RotationFrame);
-        baseSize += sizeof(size_t);
-        baseSize += frames.scaleFrames.size() * sizeof(nc::asset::ScaleFrame);
+        throw NcError(fmt::format(
+            "Blob alignment must be a power of two no larger than {}: '{}'",
+            maxBlobAlignment, alignment
+        ));
     }
-    return baseSize;
 }
-}  // anonymous namespace
 
-namespace nc::convert
+auto GetMeshSections(const asset::Mesh& asset, size_t alignment) -> asset::MeshSectionTable
 {
-auto GetBlobSize(const asset::AudioClip& asset) -> size_t
+    auto sections = asset::MeshSectionTable{};
+    auto layout = BlobLayout{alignment};
+    layout.Add(sections.vertices);
+    layout.AddArray(asset.vertices.size(), sizeof(asset::MeshVertex));
+    sections.indices = layout.Size();
+    layout.AddArray(asset.indices.size(), sizeof(uint32_t));
+    sections.bones = layout.Size();
+    layout.Add(sizeof(bool) + GetBonesSize(asset.bonesData));
+    sections.end = layout.Size();
+    return sections;
+}
+
+auto GetBlobSize(const asset::AudioClip& asset, size_t alignment) -> size_t
 {
-    constexpr auto baseSize = sizeof(asset::AudioClip::samplesPerChannel);
-    return baseSize + asset.samplesPerChannel * sizeof(double) * 2ull + sizeof(size_t) * 2ull;
+    auto layout = BlobLayout{alignment};
+    layout.Add(sizeof(asset::AudioClip::samplesPerChannel));
+    layout.AddArray(asset.leftChannel.size(), sizeof(double));
+    layout.AddArray(asset.rightChannel.size(), sizeof(double));
+    return layout.Size();
 }
 
-auto GetBlobSize(const asset::ConcaveCollider& asset) -> size_t
+auto GetBlobSize(const asset::ConcaveCollider& asset, size_t alignment) -> size_t
 {
-    constexpr auto baseSize = sizeof(asset::ConcaveCollider::extents) + sizeof(asset::ConcaveCollider::maxExtent) + sizeof(size_t);
-    return baseSize + asset.triangles.size() * sizeof(Triangle);
+    auto layout = BlobLayout{alignment};
+    layout.Add(sizeof(asset::ConcaveCollider::extents) + sizeof(asset::ConcaveCollider::maxExtent));
+    layout.AddArray(asset.triangles.size(), sizeof(Triangle));
+    return layout.Size();
 }
 
-auto GetBlobSize(const asset::CubeMap& asset) -> size_t
+auto GetBlobSize(const asset::CubeMap& asset, size_t alignment) -> size_t
 {
-    constexpr auto baseSize = sizeof(asset::CubeMap::faceSideLength);
-    return baseSize + asset.pixelData.size();
+    auto layout = BlobLayout{alignment};
+    layout.Add(sizeof(asset::CubeMap::faceSideLength));
+    layout.AddArray(asset.pixelData.size(), sizeof(unsigned char));
+    return layout.Size();
 }
 
-auto GetBlobSize(const asset::HullCollider& asset) -> size_t
+auto GetBlobSize(const asset::HullCollider& asset, size_t alignment) -> size_t
 {
-    constexpr auto baseSize = sizeof(asset::HullCollider::extents) + sizeof(asset::HullCollider::maxExtent) + sizeof(size_t);
-    return  baseSize + asset.vertices.size() * sizeof(Vector3);
+    auto layout = BlobLayout{alignment};
+    layout.Add(sizeof(asset::HullCollider::extents) + sizeof(asset::HullCollider::maxExtent));
+    layout.AddArray(asset.vertices.size(), sizeof(Vector3));
+    return layout.Size();
 }
 
-auto GetBlobSize(const asset::Mesh& asset) -> size_t
+auto GetBlobSize(const asset::Mesh& asset, size_t alignment) -> size_t
 {
-    constexpr auto baseSize = sizeof(asset::Mesh::extents) + sizeof(asset::Mesh::maxExtent) + sizeof(size_t) + sizeof(size_t);
-    return baseSize + asset.vertices.size() * sizeof(asset::MeshVertex) + asset.indices.size() * sizeof(uint32_t) + sizeof(bool) + GetBonesSize(asset.bonesData);
+    return GetMeshSections(asset, alignment).end;
 }
 
-auto GetBlobSize(const asset::SkeletalAnimation& asset) -> size_t
+auto GetBlobSize(const asset::SkeletalAnimation& asset, size_t alignment) -> size_t
 {
-    return GetSkeletalAnimationSize(asset);
+    auto layout = BlobLayout{alignment};
+    layout.AddString(asset.name.size());
+    layout.Add(sizeof(asset::SkeletalAnimation::durationInTicks) + sizeof(asset::SkeletalAnimation::ticksPerSecond));
+    layout.Add(sizeof(size_t)); // framesPerBone count
+    for (const auto& [name, frames] : asset.framesPerBone)
+    {
+        layout.AddString(name.size());
+        layout.AddArray(frames.positionFrames.size(), sizeof(asset::PositionFrame));
+        layout.AddArray(frames.rotationFrames.size(), sizeof(asset::RotationFrame));
+        layout.AddArray(frames.scaleFrames.size(), sizeof(asset::ScaleFrame));
+    }
+
+    return layout.Size();
 }
 
-auto GetBlobSize(const asset::Texture& asset) -> size_t
+auto GetBlobSize(const asset::Texture& asset, size_t alignment) -> size_t
 {
-    constexpr auto baseSize = sizeof(asset::Texture::width) + sizeof(asset::Texture::height);
-    return baseSize + asset.pixelData.size();
+    auto layout = BlobLayout{alignment};
+    layout.Add(sizeof(asset::Texture::width) + sizeof(asset::Texture::height));
+    layout.AddArray(asset.pixelData.size(), sizeof(unsigned char));
+    return layout.Size();
 }
 } // namsepace nc::asset
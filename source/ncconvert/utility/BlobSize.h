@@ -1,29 +1,60 @@
 #pragma once
 
 #include "ncasset/AssetsFwd.h"
+#include "ncasset/NcaHeader.h"
 
 #include <cstddef>
+#include <cstdint>
 
 namespace nc::convert
 {
-/** @brief Get the serialized size in bytes for an AudioClip. */
-auto GetBlobSize(const asset::AudioClip& asset) -> size_t;
+/** @brief Alignment of array data in blobs unless configured otherwise. Suits 16-byte SIMD loads. */
+constexpr auto defaultBlobAlignment = size_t{16};
+
+/** @brief The largest supported blob alignment. */
+constexpr auto maxBlobAlignment = size_t{4096};
+
+/** @brief Size of the element count and padding size written before each array's data. */
+constexpr auto arrayPrefixSize = sizeof(uint64_t) + sizeof(uint32_t);
+
+/** @brief Throw if an alignment is not a power of two no larger than maxBlobAlignment. */
+void ValidateBlobAlignment(size_t alignment);
+
+/**
+ * @brief Get the padding written between an array's prefix and its data.
+ * @param blobOffset Offset of the array's prefix from the start of the blob.
+ * @note Data is aligned relative to the start of the nca, so it is aligned in memory wherever the nca is.
+ */
+constexpr auto GetArrayPadding(size_t blobOffset, size_t alignment) -> size_t
+{
+    const auto dataOffset = asset::NcaHeader::binarySize + blobOffset + arrayPrefixSize;
+    return (alignment - dataOffset % alignment) % alignment;
+}
+
+/** @brief Get the section table written to a Mesh blob. */
+auto GetMeshSections(const asset::Mesh& asset, size_t alignment = defaultBlobAlignment) -> asset::MeshSectionTable;
+
+/**
+ * @brief Get the serialized size in bytes for an AudioClip.
+ * @note Sizes include the padding that aligns array data to the alignment. The same applies to all overloads.
+ */
+auto GetBlobSize(const asset::AudioClip& asset, size_t alignment = defaultBlobAlignment) -> size_t;
 
 /** @brief Get the serialized size in bytes for a ConcaveCollider. */
-auto GetBlobSize(const asset::ConcaveCollider& asset) -> size_t;
+auto GetBlobSize(const asset::ConcaveCollider& asset, size_t alignment = defaultBlobAlignment) -> size_t;
 
 /** @brief Get the serialized size in bytes for a CubeMap. */
-auto GetBlobSize(const asset::CubeMap& asset) -> size_t;
+auto GetBlobSize(const asset::CubeMap& asset, size_t alignment = defaultBlobAlignment) -> size_t;
 
 /** @brief Get the serialized size in bytes for a HullCollider. */
-auto GetBlobSize(const asset::HullCollider& asset) -> size_t;
+auto GetBlobSize(const asset::HullCollider& asset, size_t alignment = defaultBlobAlignment) -> size_t;
 
 /** @brief Get the serialized size in bytes for a Mesh. */
-auto GetBlobSize(const asset::Mesh& asset) -> size_t;
+auto GetBlobSize(const asset::Mesh& asset, size_t alignment = defaultBlobAlignment) -> size_t;
 
 /** @brief Get the serialized size in bytes for a SkeletalAnimation. */
-auto GetBlobSize(const asset::SkeletalAnimation& asset) -> size_t;
+auto GetBlobSize(const asset::SkeletalAnimation& asset, size_t alignment = defaultBlobAlignment) -> size_t;
 
 /** @brief Get the serialized size in bytes for a Texture. */
-auto GetBlobSize(const asset::Texture& asset) -> size_t;
+auto GetBlobSize(const asset::Texture& asset, size_t alignment = defaultBlobAlignment) -> size_t;
 } // namespace nc::convert
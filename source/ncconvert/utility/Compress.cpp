@@ -0,0 +1,349 @@
+#include "Compress.h"
+
+#include "ncasset/NcaHeader.h"
+#include "ncutility/NcError.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <utility>
+
+#ifdef NC_TOOLS_ZSTD
+#include "zdict.h"
+#include "zstd.h"
+#endif
+
+namespace
+{
+constexpr auto minMatchLength = size_t{4};
+constexpr auto maxOffset = size_t{65535};
+
+// Block format end conditions: the last 5 bytes are always literals, and the last
+// match must start at least 12 bytes before the end of the input.
+constexpr auto lastLiterals = size_t{5};
+constexpr auto matchFindLimit = size_t{12};
+
+constexpr auto hashBits = 16u;
+
+// Number of earlier positions compared when looking for the longest match. Higher values
+// trade build time for ratio; decode speed is unaffected.
+constexpr auto maxSearchDepth = 64;
+
+// zstd is used where download size matters more than build time.
+constexpr auto zstdLevel = 19;
+
+// Dictionary training needs a handful of samples and works best with a dictionary around a
+// tenth of the sample data. Only the start of large blobs is sampled to bound training time.
+constexpr auto minDictionarySamples = size_t{8};
+constexpr auto minDictionarySize = size_t{1024};
+constexpr auto maxDictionarySize = size_t{112640};
+constexpr auto maxSampleSize = size_t{128 * 1024};
+constexpr auto maxTrainingSize = size_t{64 * 1024 * 1024};
+
+auto Read32(const std::byte* data) -> uint32_t
+{
+    auto value = uint32_t{};
+    std::memcpy(&value, data, sizeof(value));
+    return value;
+}
+
+auto Hash(uint32_t sequence) -> uint32_t
+{
+    return (sequence * 2654435761u) >> (32u - hashBits);
+}
+
+/** Hash chains over the last 64KB of input, as in LZ4HC. */
+class MatchFinder
+{
+    public:
+        explicit MatchFinder(std::span<const std::byte> data)
+            : m_data{data},
+              m_head(size_t{1} << hashBits, 0u),
+              m_chain(maxOffset + 1, uint16_t{0})
+        {
+        }
+
+        /** Find the longest match for a position, not extending past matchLimit. Returns {offset, length}. */
+        auto Find(size_t position, size_t matchLimit) -> std::pair<size_t, size_t>
+        {
+            InsertUpTo(position);
+            const auto* src = m_data.data();
+            const auto sequence = ::Read32(src + position);
+            auto best = std::pair<size_t, size_t>{0, 0};
+            auto candidate = size_t{m_head[::Hash(sequence)]};
+            for (auto attempt = 0; attempt < maxSearchDepth && candidate != 0; ++attempt)
+            {
+                candidate -= 1;
+                if (position - candidate > maxOffset)
+                {
+                    break;
+                }
+
+                if (::Read32(src + candidate) == sequence)
+                {
+                    auto length = minMatchLength;
+                    while (position + length < matchLimit && src[position + length] == src[candidate + length])
+                    {
+                        ++length;
+                    }
+
+                    if (length > best.second)
+                    {
+                        best = {position - candidate, length};
+                        if (position + length >= matchLimit)
+                        {
+                            break;
+                        }
+                    }
+                }
+
+                const auto delta = size_t{m_chain[candidate & maxOffset]};
+                candidate = delta == 0 || delta > candidate ? 0 : candidate - delta + 1;
+            }
+
+            return best;
+        }
+
+    private:
+        std::span<const std::byte> m_data;
+        std::vector<uint32_t> m_head; // most recent position + 1 for each hash, 0 if none
+        std::vector<uint16_t> m_chain; // distance to the previous position with the same hash
+        size_t m_next = 0;
+
+        void InsertUpTo(size_t position)
+        {
+            for (; m_next < position; ++m_next)
+            {
+                auto& head = m_head[::Hash(::Read32(m_data.data() + m_next))];
+                const auto delta = head == 0 ? size_t{0} : m_next - (head - 1);
+                m_chain[m_next & maxOffset] = static_cast<uint16_t>(delta > maxOffset ? 0 : delta);
+                head = static_cast<uint32_t>(m_next + 1);
+            }
+        }
+};
+
+void WriteLength(std::vector<std::byte>& out, size_t length)
+{
+    while (length >= 255)
+    {
+        out.push_back(std::byte{255});
+        length -= 255;
+    }
+
+    out.push_back(static_cast<std::byte>(length));
+}
+
+void WriteSequence(std::vector<std::byte>& out, std::span<const std::byte> literals, size_t offset, size_t matchLength)
+{
+    const auto literalToken = std::min(literals.size(), size_t{15});
+    const auto matchToken = matchLength == 0 ? size_t{0} : std::min(matchLength - minMatchLength, size_t{15});
+    out.push_back(static_cast<std::byte>((literalToken << 4) | matchToken));
+    if (literalToken == 15)
+    {
+        ::WriteLength(out, literals.size() - 15);
+    }
+
+    out.insert(out.end(), literals.begin(), literals.end());
+    if (matchLength == 0)
+    {
+        return;
+    }
+
+    out.push_back(static_cast<std::byte>(offset & 0xFF));
+    out.push_back(static_cast<std::byte>(offset >> 8));
+    if (matchToken == 15)
+    {
+        ::WriteLength(out, matchLength - minMatchLength - 15);
+    }
+}
+
+#ifdef NC_TOOLS_ZSTD
+struct CompressionContextDeleter
+{
+    void operator()(ZSTD_CCtx* context) const noexcept
+    {
+        ZSTD_freeCCtx(context);
+    }
+};
+
+/** Each thread keeps one context, as a level 19 context is expensive to create. */
+auto ZstdCompress(std::span<const std::byte> data, const ZSTD_CDict* dictionary) -> std::vector<std::byte>
+{
+    thread_local auto context = std::unique_ptr<ZSTD_CCtx, CompressionContextDeleter>{ZSTD_createCCtx()};
+    if (!context)
+    {
+        throw nc::NcError("Failed to create zstd compression context");
+    }
+
+    auto out = std::vector<std::byte>(ZSTD_compressBound(data.size()));
+    const auto size = dictionary
+        ? ZSTD_compress_usingCDict(context.get(), out.data(), out.size(), data.data(), data.size(), dictionary)
+        : ZSTD_compressCCtx(context.get(), out.data(), out.size(), data.data(), data.size(), zstdLevel);
+
+    if (ZSTD_isError(size))
+    {
+        throw nc::NcError(fmt::format("zstd compression failed: {}", ZSTD_getErrorName(size)));
+    }
+
+    out.resize(size);
+    return out;
+}
+#endif
+
+template<class T>
+void WriteValue(std::vector<std::byte>& out, size_t offset, T value)
+{
+    std::memcpy(out.data() + offset, &value, sizeof(T));
+}
+} // anonymous namespace
+
+namespace nc::convert
+{
+CompressionDictionary::CompressionDictionary(std::vector<std::byte> dictionary)
+    : m_bytes{std::move(dictionary)},
+      m_handle{},
+      m_id{0}
+{
+#ifdef NC_TOOLS_ZSTD
+    m_id = ZDICT_getDictID(m_bytes.data(), m_bytes.size());
+    if (m_id == 0)
+    {
+        throw NcError("Not a trained zstd dictionary");
+    }
+
+    m_handle.reset(ZSTD_createCDict(m_bytes.data(), m_bytes.size(), zstdLevel));
+    if (!m_handle)
+    {
+        throw NcError(fmt::format("Failed to load zstd dictionary '{}'", m_id));
+    }
+#else
+    throw NcError("nc-convert was built without zstd support");
+#endif
+}
+
+void CompressionDictionary::Deleter::operator()([[maybe_unused]] ZSTD_CDict_s* dictionary) const noexcept
+{
+#ifdef NC_TOOLS_ZSTD
+    ZSTD_freeCDict(dictionary);
+#endif
+}
+
+auto Lz4Compress(std::span<const std::byte> data) -> std::vector<std::byte>
+{
+    auto out = std::vector<std::byte>{};
+    out.reserve(data.size() + data.size() / 255 + 16);
+
+    const auto size = data.size();
+    auto anchor = size_t{0};
+    if (size > matchFindLimit)
+    {
+        auto finder = MatchFinder{data};
+        const auto matchLimit = size - lastLiterals;
+        const auto searchLimit = size - matchFindLimit;
+        auto position = size_t{0};
+        while (position < searchLimit)
+        {
+            const auto [offset, length] = finder.Find(position, matchLimit);
+            if (length == 0)
+            {
+                ++position;
+                continue;
+            }
+
+            ::WriteSequence(out, data.subspan(anchor, position - anchor), offset, length);
+            position += length;
+            anchor = position;
+        }
+    }
+
+    ::WriteSequence(out, data.subspan(anchor), 0, 0);
+    return out;
+}
+
+auto TrainDictionary([[maybe_unused]] std::span<const std::span<const std::byte>> samples) -> std::optional<CompressionDictionary>
+{
+#ifdef NC_TOOLS_ZSTD
+    if (samples.size() < minDictionarySamples)
+    {
+        return std::nullopt;
+    }
+
+    auto buffer = std::vector<std::byte>{};
+    auto sampleSizes = std::vector<size_t>{};
+    for (const auto& sample : samples)
+    {
+        const auto size = std::min(sample.size(), maxSampleSize);
+        if (buffer.size() + size > maxTrainingSize)
+        {
+            break;
+        }
+
+        buffer.insert(buffer.end(), sample.begin(), sample.begin() + static_cast<std::ptrdiff_t>(size));
+        sampleSizes.push_back(size);
+    }
+
+    auto dictionary = std::vector<std::byte>(std::clamp(buffer.size() / 10, minDictionarySize, maxDictionarySize));
+    const auto size = ZDICT_trainFromBuffer(dictionary.data(), dictionary.size(), buffer.data(), sampleSizes.data(), static_cast<unsigned>(sampleSizes.size()));
+
+    // Training fails when samples are too small or too uniform to be worth a dictionary.
+    if (ZDICT_isError(size))
+    {
+        return std::nullopt;
+    }
+
+    dictionary.resize(size);
+    return CompressionDictionary{std::move(dictionary)};
+#else
+    throw NcError("nc-convert was built without zstd support");
+#endif
+}
+
+auto CompressBlob(std::span<const std::byte> blob, std::string_view algorithm, [[maybe_unused]] const CompressionDictionary* dictionary, size_t chunkSize) -> std::vector<std::byte>
+{
+    auto compressChunk = std::function<std::vector<std::byte>(std::span<const std::byte>)>{};
+    if (algorithm == asset::CompressionAlgorithm::lz4)
+    {
+        compressChunk = &Lz4Compress;
+    }
+#ifdef NC_TOOLS_ZSTD
+    else if (algorithm == asset::CompressionAlgorithm::zstd)
+    {
+        const auto* handle = dictionary ? dictionary->GetHandle() : nullptr;
+        compressChunk = [handle](std::span<const std::byte> chunk) { return ::ZstdCompress(chunk, handle); };
+    }
+#endif
+    else
+    {
+        throw NcError(fmt::format("Unsupported compression algorithm: '{}'", algorithm));
+    }
+
+    if (chunkSize == 0 || chunkSize > std::numeric_limits<uint32_t>::max())
+    {
+        throw NcError(fmt::format("Invalid compression chunk size: '{}'", chunkSize));
+    }
+
+    const auto chunkCount = (blob.size() + chunkSize - 1) / chunkSize;
+    if (chunkCount > std::numeric_limits<uint32_t>::max())
+    {
+        throw NcError(fmt::format("Too many compression chunks for blob of '{}' bytes", blob.size()));
+    }
+
+    // Chunk table: u64 uncompressed size, u32 chunk size, u32 chunk count, u32 compressed size per chunk.
+    constexpr auto sizesOffset = sizeof(uint64_t) + 2 * sizeof(uint32_t);
+    auto out = std::vector<std::byte>(sizesOffset + chunkCount * sizeof(uint32_t));
+    ::WriteValue(out, 0, static_cast<uint64_t>(blob.size()));
+    ::WriteValue(out, sizeof(uint64_t), static_cast<uint32_t>(chunkSize));
+    ::WriteValue(out, sizeof(uint64_t) + sizeof(uint32_t), static_cast<uint32_t>(chunkCount));
+    for (auto chunk = size_t{0}; chunk < chunkCount; ++chunk)
+    {
+        const auto compressed = compressChunk(blob.subspan(chunk * chunkSize, std::min(chunkSize, blob.size() - chunk * chunkSize)));
+        ::WriteValue(out, sizesOffset + chunk * sizeof(uint32_t), static_cast<uint32_t>(compressed.size()));
+        out.insert(out.end(), compressed.cbegin(), compressed.cend());
+    }
+
+    return out;
+}
+} // namespace nc::convert
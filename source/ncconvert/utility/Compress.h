@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string_view>
+#include <vector>
+
+struct ZSTD_CDict_s;
+
+namespace nc::convert
+{
+/** @brief A trained zstd dictionary, shared by all assets of one type. */
+class CompressionDictionary
+{
+    public:
+        /** @brief Prepare a dictionary produced by TrainDictionary() for compression. */
+        explicit CompressionDictionary(std::vector<std::byte> dictionary);
+
+        /** @brief Get the id that blobs compressed with this dictionary refer to. */
+        auto GetId() const noexcept -> uint32_t
+        {
+            return m_id;
+        }
+
+        /** @brief Get the raw dictionary, as stored in packages and .ncd files. */
+        auto GetBytes() const noexcept -> std::span<const std::byte>
+        {
+            return m_bytes;
+        }
+
+        /** @brief Get the digested dictionary. */
+        auto GetHandle() const noexcept -> const ZSTD_CDict_s*
+        {
+            return m_handle.get();
+        }
+
+    private:
+        struct Deleter
+        {
+            void operator()(ZSTD_CDict_s* dictionary) const noexcept;
+        };
+
+        std::vector<std::byte> m_bytes;
+        std::unique_ptr<ZSTD_CDict_s, Deleter> m_handle;
+        uint32_t m_id;
+};
+
+/** @brief Encode bytes as a single LZ4 block. */
+auto Lz4Compress(std::span<const std::byte> data) -> std::vector<std::byte>;
+
+/**
+ * @brief Train a zstd dictionary from sample blobs.
+ * @note Large samples are truncated. Returns nullopt if there are too few samples to train from.
+ */
+auto TrainDictionary(std::span<const std::span<const std::byte>> samples) -> std::optional<CompressionDictionary>;
+
+/** @brief Default uncompressed size of each independently compressed chunk of a blob. */
+constexpr auto defaultChunkSize = size_t{1024 * 1024};
+
+/**
+ * @brief Compress an asset blob for storage after an NcaHeader.
+ * @param dictionary A dictionary to compress with. Only used for CompressionAlgorithm::zstd.
+ * @param chunkSize The blob is split into chunks of this size, compressed independently so they
+ *        can be decompressed in parallel or individually.
+ * @return A chunk table followed by the compressed chunks.
+ */
+auto CompressBlob(std::span<const std::byte> blob,
+                  std::string_view algorithm,
+                  const CompressionDictionary* dictionary = nullptr,
+                  size_t chunkSize = defaultChunkSize) -> std::vector<std::byte>;
+} // namespace nc::convert
@@ -1,5 +1,7 @@
 #include "EnumExtensions.h"
 
+#include "ncasset/NcaHeader.h"
+
 #include "fmt/format.h"
 #include "ncutility/NcError.h"
 
@@ -60,4 +62,23 @@ auto ToString(asset::AssetType type) -> std::string
         fmt::format("Unknown AssetType: {}", static_cast<int>(type))
     );
 }
+
+auto ToCompressionAlgorithm(std::string algorithm) -> std::string_view
+{
+    std::ranges::transform(algorithm, algorithm.begin(), [](char c) { return std::tolower(c); });
+
+    if(algorithm == "none")
+        return asset::CompressionAlgorithm::none;
+    else if(algorithm == "lz4")
+        return asset::CompressionAlgorithm::lz4;
+#ifdef NC_TOOLS_ZSTD
+    else if(algorithm == "zstd")
+        return asset::CompressionAlgorithm::zstd;
+#else
+    else if(algorithm == "zstd")
+        throw NcError("nc-convert was built without zstd support (NC_TOOLS_ENABLE_ZSTD)");
+#endif
+
+    throw NcError("Failed to parse compression algorithm from: " + algorithm);
+}
 } // namespace nc::convert
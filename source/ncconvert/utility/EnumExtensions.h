@@ -3,10 +3,12 @@
 #include "ncasset/AssetType.h"
 
 #include <string>
+#include <string_view>
 
 namespace nc::convert
 {
 auto CanOutputMany(asset::AssetType type) -> bool;
 auto ToAssetType(std::string type) -> asset::AssetType;
 auto ToString(asset::AssetType type) -> std::string;
+auto ToCompressionAlgorithm(std::string algorithm) -> std::string_view;
 }
@@ -4,4 +4,10 @@
 
 #include <iostream>
 
-#define LOG(...) std::cout << fmt::format(__VA_ARGS__) << '\n';
+namespace nc::convert
+{
+/** @brief The stream LOG writes to on the calling thread. Build workers point it at a per-target buffer. */
+inline thread_local std::ostream* logStream = &std::cout;
+} // namespace nc::convert
+
+#define LOG(...) *nc::convert::logStream << fmt::format(__VA_ARGS__) << '\n';
@@ -0,0 +1,111 @@
+/**
+ * Measures Mesh serialization throughput for the bulk array path used by
+ * nc-convert and NcAsset against generic element-wise serialization.
+ *
+ * Usage: SerializeMesh_benchmark [vertexCount]
+ */
+#include "Deserialize.h"
+#include "builder/Serialize.h"
+#include "ncasset/Assets.h"
+
+#include "ncutility/BinarySerialization.h"
+#include "fmt/format.h"
+
+#include <algorithm>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace
+{
+constexpr auto defaultVertexCount = size_t{4'000'000};
+constexpr auto iterations = 3;
+
+auto MakeMesh(size_t vertexCount) -> nc::asset::Mesh
+{
+    auto mesh = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 1.0f, 1.0f},
+        .maxExtent = 1.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(vertexCount),
+        .indices = std::vector<uint32_t>(vertexCount * 3),
+        .bonesData = std::nullopt
+    };
+
+    for (auto i = size_t{0}; i < vertexCount; ++i)
+    {
+        mesh.vertices[i].position = nc::Vector3::Splat(static_cast<float>(i));
+    }
+
+    for (auto i = size_t{0}; i < mesh.indices.size(); ++i)
+    {
+        mesh.indices[i] = static_cast<uint32_t>(i % vertexCount);
+    }
+
+    return mesh;
+}
+
+template<class F>
+auto MeasureMBps(size_t byteCount, F&& run) -> double
+{
+    auto best = std::chrono::duration<double>::max();
+    for (auto i = 0; i < iterations; ++i)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        run();
+        best = std::min(best, std::chrono::duration<double>{std::chrono::steady_clock::now() - begin});
+    }
+
+    return static_cast<double>(byteCount) / (1024.0 * 1024.0) / best.count();
+}
+
+auto MakeStream(const std::string& bytes = {}) -> std::stringstream
+{
+    return std::stringstream{bytes, std::ios::in | std::ios::out | std::ios::binary};
+}
+} // anonymous namespace
+
+int main(int argc, char** argv)
+{
+    const auto vertexCount = argc > 1 ? std::stoull(argv[1]) : defaultVertexCount;
+    const auto mesh = MakeMesh(vertexCount);
+
+    auto serialized = MakeStream();
+    nc::convert::Serialize(serialized, mesh, 0u);
+    const auto bytes = serialized.str();
+
+    auto blob = MakeStream();
+    nc::serialize::Serialize(blob, mesh);
+    const auto blobBytes = blob.str();
+
+    fmt::print("Mesh with {} vertices, {} indices ({:.1f} MB)\n",
+               vertexCount, mesh.indices.size(), static_cast<double>(bytes.size()) / (1024.0 * 1024.0));
+
+    const auto elementWiseWrite = MeasureMBps(blobBytes.size(), [&]()
+    {
+        auto stream = MakeStream();
+        nc::serialize::Serialize(stream, mesh);
+    });
+
+    const auto bulkWrite = MeasureMBps(bytes.size(), [&]()
+    {
+        auto stream = MakeStream();
+        nc::convert::Serialize(stream, mesh, 0u);
+    });
+
+    const auto elementWiseRead = MeasureMBps(blobBytes.size(), [&]()
+    {
+        auto stream = MakeStream(blobBytes);
+        auto out = nc::asset::Mesh{};
+        nc::serialize::Deserialize(stream, out);
+    });
+
+    const auto bulkRead = MeasureMBps(bytes.size(), [&]()
+    {
+        auto stream = MakeStream(bytes);
+        nc::asset::DeserializeMesh(stream);
+    });
+
+    fmt::print("{:<12}{:>16}{:>16}\n", "", "element-wise", "bulk");
+    fmt::print("{:<12}{:>11.1f} MB/s{:>11.1f} MB/s\n", "serialize", elementWiseWrite, bulkWrite);
+    fmt::print("{:<12}{:>11.1f} MB/s{:>11.1f} MB/s\n", "deserialize", elementWiseRead, bulkRead);
+}
@@ -5,13 +5,20 @@
 #include "GeometryTestUtility.h"
 #include "TextureTestUtility.h"
 
+#include <sstream>
+
 #include "ncasset/Assets.h"
 #include "ncasset/AssetType.h"
+#include "ncasset/Dictionary.h"
 #include "ncasset/Import.h"
 #include "ncconvert/builder/Builder.h"
+#include "ncconvert/builder/PackageWriter.h"
+#include "ncconvert/builder/Serialize.h"
 #include "ncconvert/builder/Target.h"
 #include "ncconvert/converters/GeometryConverter.h"
 #include "ncconvert/converters/TextureConverter.h"
+#include "ncconvert/utility/Compress.h"
+#include "ncutility/NcError.h"
 
 const auto ncaTestOutDirectory = std::filesystem::path{"./test_temp_dir"};
 
@@ -56,6 +63,39 @@ TEST_F(BuildAndImportTest, Texture_from_png)
         const auto actualPixel = ReadPixel(asset.pixelData.data(), pixelIndex * 4);
         EXPECT_EQ(expectedPixel, actualPixel);
     }
+
+    const auto anyAsset = nc::asset::ImportAny(outFile);
+    ASSERT_TRUE(std::holds_alternative<nc::asset::Texture>(anyAsset));
+    EXPECT_EQ(asset.pixelData, std::get<nc::asset::Texture>(anyAsset).pixelData);
+
+    const auto [header, assetWithHeader] = nc::asset::ImportAnyWithHeader(outFile);
+    EXPECT_EQ(nc::asset::MagicNumber::texture, header.magicNumber);
+    EXPECT_EQ(nc::asset::ImportNcaHeader(outFile).size, header.size);
+    ASSERT_TRUE(std::holds_alternative<nc::asset::Texture>(assetWithHeader));
+    EXPECT_EQ(asset.pixelData, std::get<nc::asset::Texture>(assetWithHeader).pixelData);
+}
+
+TEST_F(BuildAndImportTest, Texture_from_png_lz4)
+{
+    namespace test_data = collateral::rgb_corners;
+    const auto inFile = test_data::pngFilePath;
+    const auto outFile = ncaTestOutDirectory / "rgb_png_lz4.nca";
+    const auto target = nc::convert::Target{inFile, outFile};
+    auto builder = nc::convert::Builder{};
+    ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, target, nc::asset::CompressionAlgorithm::lz4));
+
+    const auto header = nc::asset::ImportNcaHeader(outFile);
+    EXPECT_STREQ("LZ4", header.compressionAlgorithm);
+
+    const auto asset = nc::asset::ImportTexture(outFile);
+    EXPECT_EQ(test_data::width, asset.width);
+    EXPECT_EQ(test_data::height, asset.height);
+    ASSERT_EQ(test_data::numBytes, asset.pixelData.size());
+
+    for (auto pixelIndex = 0u; pixelIndex < test_data::numPixels; ++pixelIndex)
+    {
+        EXPECT_EQ(test_data::pixels[pixelIndex], ReadPixel(asset.pixelData.data(), pixelIndex * 4));
+    }
 }
 
 TEST_F(BuildAndImportTest, ConcaveCollider_from_fbx)
@@ -214,3 +254,390 @@ TEST_F(BuildAndImportTest, CubeMap_from_png)
         EXPECT_EQ(expectedPixel, actualPixel);
     }
 }
+
+TEST_F(BuildAndImportTest, Package_from_png_and_wav)
+{
+    const auto packagePath = ncaTestOutDirectory / "package.ncp";
+    const auto textureTarget = nc::convert::Target{collateral::rgb_corners::pngFilePath, ncaTestOutDirectory / "rgb_png.nca"};
+    const auto audioTarget = nc::convert::Target{collateral::sine::filePath, ncaTestOutDirectory / "sine.nca"};
+    const auto textureId = nc::convert::GetAssetId(textureTarget.destinationPath);
+    const auto audioId = nc::convert::GetAssetId(audioTarget.destinationPath);
+    auto builder = nc::convert::Builder{};
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        auto texture = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, textureTarget, texture));
+        writer.Add(textureId, texture.view());
+        auto audio = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::AudioClip, audioTarget, audio));
+        writer.Add(audioId, audio.view());
+        writer.Finalize();
+    }
+
+    {
+        // Entries are newer than their sources, so a rebuild copies them from the existing package.
+        auto writer = nc::convert::PackageWriter{packagePath};
+        EXPECT_TRUE(writer.TryReuse(audioId, audioTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        EXPECT_TRUE(writer.TryReuse(textureId, textureTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        writer.Finalize();
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    ASSERT_EQ(2u, package.GetEntries().size());
+
+    const auto texture = nc::asset::ImportTexture(package, textureId);
+    EXPECT_EQ(collateral::rgb_corners::width, texture.width);
+    EXPECT_EQ(collateral::rgb_corners::height, texture.height);
+    EXPECT_EQ(collateral::rgb_corners::numBytes, texture.pixelData.size());
+
+    const auto audio = nc::asset::ImportAudioClip(package, audioId);
+    EXPECT_EQ(collateral::sine::samplesPerChannel, audio.samplesPerChannel);
+
+    const auto anyAudio = nc::asset::ImportAny(package, audioId);
+    ASSERT_TRUE(std::holds_alternative<nc::asset::AudioClip>(anyAudio));
+    EXPECT_EQ(audio.samplesPerChannel, std::get<nc::asset::AudioClip>(anyAudio).samplesPerChannel);
+}
+
+TEST_F(BuildAndImportTest, Package_changedCompression_rebuildsEntry)
+{
+    const auto packagePath = ncaTestOutDirectory / "compression_package.ncp";
+    const auto target = nc::convert::Target{collateral::rgb_corners::pngFilePath, ncaTestOutDirectory / "rgb_png.nca"};
+    const auto assetId = nc::convert::GetAssetId(target.destinationPath);
+    auto builder = nc::convert::Builder{};
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        auto nca = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, target, nca));
+        writer.Add(assetId, nca.view());
+        writer.Finalize();
+    }
+
+    {
+        // The entry is newer than its source, but was stored uncompressed.
+        auto writer = nc::convert::PackageWriter{packagePath};
+        EXPECT_FALSE(writer.TryReuse(assetId, target.sourcePath, nc::asset::CompressionAlgorithm::lz4));
+        auto nca = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, target, nca, nc::asset::CompressionAlgorithm::lz4));
+        writer.Add(assetId, nca.view());
+        writer.Finalize();
+    }
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        EXPECT_FALSE(writer.TryReuse(assetId, target.sourcePath, nc::asset::CompressionAlgorithm::none));
+        EXPECT_TRUE(writer.TryReuse(assetId, target.sourcePath, nc::asset::CompressionAlgorithm::lz4));
+        writer.Finalize();
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    EXPECT_STREQ("LZ4", nc::asset::ImportNcaHeader(package, assetId).compressionAlgorithm);
+    EXPECT_EQ(collateral::rgb_corners::numBytes, nc::asset::ImportTexture(package, assetId).pixelData.size());
+}
+
+TEST_F(BuildAndImportTest, Package_loadOrder_placesTracedAssetsFirst)
+{
+    const auto packagePath = ncaTestOutDirectory / "ordered_package.ncp";
+    const auto textureTarget = nc::convert::Target{collateral::rgb_corners::pngFilePath, ncaTestOutDirectory / "rgb_png.nca"};
+    const auto audioTarget = nc::convert::Target{collateral::sine::filePath, ncaTestOutDirectory / "sine.nca"};
+    const auto textureId = nc::convert::GetAssetId(textureTarget.destinationPath);
+    const auto audioId = nc::convert::GetAssetId(audioTarget.destinationPath);
+    auto builder = nc::convert::Builder{};
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        auto texture = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, textureTarget, texture));
+        writer.Add(textureId, texture.view());
+        auto audio = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::AudioClip, audioTarget, audio));
+        writer.Add(audioId, audio.view());
+
+        // Ids missing from the package are ignored.
+        const auto loadOrder = std::vector<size_t>{7u, audioId, textureId};
+        writer.SetLoadOrder(loadOrder);
+        writer.Finalize();
+    }
+
+    {
+        const auto package = nc::asset::AssetPackage{packagePath};
+        EXPECT_LT(package.GetEntry(audioId).offset, package.GetEntry(textureId).offset);
+        EXPECT_EQ(collateral::rgb_corners::width, nc::asset::ImportTexture(package, textureId).width);
+        EXPECT_EQ(collateral::sine::samplesPerChannel, nc::asset::ImportAudioClip(package, audioId).samplesPerChannel);
+    }
+
+    {
+        // Reused entries follow the new order, and untraced assets go after traced ones.
+        auto writer = nc::convert::PackageWriter{packagePath};
+        EXPECT_TRUE(writer.TryReuse(audioId, audioTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        EXPECT_TRUE(writer.TryReuse(textureId, textureTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        const auto loadOrder = std::vector<size_t>{textureId};
+        writer.SetLoadOrder(loadOrder);
+        writer.Finalize();
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    EXPECT_LT(package.GetEntry(textureId).offset, package.GetEntry(audioId).offset);
+    EXPECT_EQ(collateral::rgb_corners::numBytes, nc::asset::ImportTexture(package, textureId).pixelData.size());
+    EXPECT_EQ(collateral::sine::samplesPerChannel, nc::asset::ImportAudioClip(package, audioId).samplesPerChannel);
+}
+
+TEST_F(BuildAndImportTest, Package_alignment_alignsEntriesAndArrays)
+{
+    constexpr auto alignment = size_t{64};
+    const auto packagePath = ncaTestOutDirectory / "aligned_package.ncp";
+    const auto textureTarget = nc::convert::Target{collateral::rgb_corners::pngFilePath, ncaTestOutDirectory / "rgb_png.nca"};
+    const auto audioTarget = nc::convert::Target{collateral::sine::filePath, ncaTestOutDirectory / "sine.nca"};
+    const auto textureId = nc::convert::GetAssetId(textureTarget.destinationPath);
+    const auto audioId = nc::convert::GetAssetId(audioTarget.destinationPath);
+    auto builder = nc::convert::Builder{};
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath, alignment};
+        auto audio = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::AudioClip, audioTarget, audio, nc::asset::CompressionAlgorithm::none, alignment));
+        writer.Add(audioId, audio.view());
+        auto texture = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, textureTarget, texture, nc::asset::CompressionAlgorithm::none, alignment));
+        writer.Add(textureId, texture.view());
+        writer.Finalize();
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    const auto file = nc::asset::MappedFile{packagePath};
+    const auto fileBegin = reinterpret_cast<uintptr_t>(file.Data().data());
+    const auto isAligned = [fileBegin](const void* data)
+    {
+        return (reinterpret_cast<uintptr_t>(data) - fileBegin) % alignment == 0;
+    };
+
+    for (const auto& entry : package.GetEntries())
+    {
+        EXPECT_EQ(0u, entry.offset % alignment);
+    }
+
+    const auto textureView = nc::asset::ImportTextureView(file, package.GetEntry(textureId).offset);
+    EXPECT_TRUE(isAligned(textureView.pixelData.data()));
+    EXPECT_EQ(collateral::rgb_corners::numBytes, textureView.pixelData.size());
+
+    const auto audioView = nc::asset::ImportAudioClipView(file, package.GetEntry(audioId).offset);
+    EXPECT_TRUE(isAligned(audioView.leftChannel.data()));
+    EXPECT_TRUE(isAligned(audioView.rightChannel.data()));
+    EXPECT_EQ(collateral::sine::samplesPerChannel, audioView.leftChannel.size());
+}
+
+TEST_F(BuildAndImportTest, Package_changedAlignment_rebuildsEntries)
+{
+    constexpr auto alignment = size_t{64};
+    const auto packagePath = ncaTestOutDirectory / "realigned_package.ncp";
+    const auto textureTarget = nc::convert::Target{collateral::rgb_corners::pngFilePath, ncaTestOutDirectory / "rgb_png.nca"};
+    const auto audioTarget = nc::convert::Target{collateral::sine::filePath, ncaTestOutDirectory / "sine.nca"};
+    const auto textureId = nc::convert::GetAssetId(textureTarget.destinationPath);
+    const auto audioId = nc::convert::GetAssetId(audioTarget.destinationPath);
+    auto builder = nc::convert::Builder{};
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        auto texture = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, textureTarget, texture));
+        writer.Add(textureId, texture.view());
+        auto audio = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::AudioClip, audioTarget, audio));
+        writer.Add(audioId, audio.view());
+        writer.Finalize();
+    }
+
+    {
+        // Entries are newer than their sources, but padded for the default alignment.
+        auto writer = nc::convert::PackageWriter{packagePath, alignment};
+        EXPECT_FALSE(writer.TryReuse(textureId, textureTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        EXPECT_THROW(writer.CarryForwardUnreferenced(), nc::NcError);
+        auto texture = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, textureTarget, texture, nc::asset::CompressionAlgorithm::none, alignment));
+        writer.Add(textureId, texture.view());
+        auto audio = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::AudioClip, audioTarget, audio, nc::asset::CompressionAlgorithm::none, alignment));
+        writer.Add(audioId, audio.view());
+        writer.Finalize();
+    }
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath, alignment};
+        EXPECT_TRUE(writer.TryReuse(textureId, textureTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        EXPECT_TRUE(writer.TryReuse(audioId, audioTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        writer.Finalize();
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    const auto file = nc::asset::MappedFile{packagePath};
+    const auto fileBegin = reinterpret_cast<uintptr_t>(file.Data().data());
+    const auto isAligned = [fileBegin](const void* data)
+    {
+        return (reinterpret_cast<uintptr_t>(data) - fileBegin) % alignment == 0;
+    };
+
+    const auto textureView = nc::asset::ImportTextureView(file, package.GetEntry(textureId).offset);
+    EXPECT_TRUE(isAligned(textureView.pixelData.data()));
+    const auto audioView = nc::asset::ImportAudioClipView(file, package.GetEntry(audioId).offset);
+    EXPECT_TRUE(isAligned(audioView.leftChannel.data()));
+    EXPECT_TRUE(isAligned(audioView.rightChannel.data()));
+}
+
+TEST_F(BuildAndImportTest, Package_identicalAssets_shareOneNca)
+{
+    const auto packagePath = ncaTestOutDirectory / "deduplicated_package.ncp";
+    const auto textureTarget = nc::convert::Target{collateral::rgb_corners::pngFilePath, ncaTestOutDirectory / "rgb_png.nca"};
+    const auto copyTarget = nc::convert::Target{collateral::rgb_corners::pngFilePath, ncaTestOutDirectory / "rgb_png_copy.nca"};
+    const auto audioTarget = nc::convert::Target{collateral::sine::filePath, ncaTestOutDirectory / "sine.nca"};
+    const auto textureId = nc::convert::GetAssetId(textureTarget.destinationPath);
+    const auto copyId = nc::convert::GetAssetId(copyTarget.destinationPath);
+    const auto audioId = nc::convert::GetAssetId(audioTarget.destinationPath);
+    auto builder = nc::convert::Builder{};
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        auto texture = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, textureTarget, texture));
+        writer.Add(textureId, texture.view());
+        auto audio = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::AudioClip, audioTarget, audio));
+        writer.Add(audioId, audio.view());
+        auto copy = std::ostringstream{std::ios::binary};
+        ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, copyTarget, copy));
+        writer.Add(copyId, copy.view());
+        writer.Finalize();
+        EXPECT_EQ(copy.view().size(), writer.GetDeduplicatedBytes());
+    }
+
+    {
+        const auto package = nc::asset::AssetPackage{packagePath};
+        ASSERT_EQ(3u, package.GetEntries().size());
+        EXPECT_EQ(package.GetEntry(textureId).offset, package.GetEntry(copyId).offset);
+        EXPECT_NE(package.GetEntry(textureId).offset, package.GetEntry(audioId).offset);
+        EXPECT_EQ(copyId, nc::asset::ImportNcaHeader(package, copyId).assetId);
+        EXPECT_EQ(collateral::rgb_corners::numBytes, nc::asset::ImportTexture(package, copyId).pixelData.size());
+        EXPECT_EQ(collateral::rgb_corners::numBytes, nc::asset::ImportTexture(package, textureId).pixelData.size());
+        EXPECT_THROW(nc::asset::ImportTexture(package, audioId), nc::NcError);
+    }
+
+    {
+        // A reused entry no longer shares its nca, so it is stored under its own id.
+        auto writer = nc::convert::PackageWriter{packagePath};
+        EXPECT_TRUE(writer.TryReuse(copyId, copyTarget.sourcePath, nc::asset::CompressionAlgorithm::none));
+        writer.Finalize();
+        EXPECT_EQ(0u, writer.GetDeduplicatedBytes());
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    ASSERT_EQ(1u, package.GetEntries().size());
+    EXPECT_EQ(collateral::rgb_corners::numBytes, nc::asset::ImportTexture(package, copyId).pixelData.size());
+}
+
+TEST_F(BuildAndImportTest, Package_reusedIdenticalAssets_shareOneNca)
+{
+    // Large enough to be copied and compared across several chunks, with a last pixel that tells the variant apart.
+    const auto packagePath = ncaTestOutDirectory / "reused_deduplicated_package.ncp";
+    const auto sourcePath = collateral::rgb_corners::pngFilePath;
+    auto texture = nc::asset::Texture{.width = 256, .height = 256, .pixelData = std::vector<unsigned char>(256 * 256 * 4)};
+    for (auto i = size_t{0}; i < texture.pixelData.size(); ++i)
+    {
+        texture.pixelData[i] = static_cast<unsigned char>((i * 7) & 0xFF);
+    }
+
+    auto variant = texture;
+    variant.pixelData.back() ^= 0xFF;
+    const auto serialize = [](const nc::asset::Texture& asset, size_t assetId)
+    {
+        auto stream = std::ostringstream{std::ios::binary};
+        nc::convert::Serialize(stream, asset, assetId);
+        return std::move(stream).str();
+    };
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        writer.Add(1u, serialize(texture, 1u));
+        writer.Add(2u, serialize(texture, 2u));
+        writer.Add(3u, serialize(variant, 3u));
+        writer.Add(4u, serialize(texture, 4u));
+        writer.Finalize();
+    }
+
+    const auto ncaSize = serialize(texture, 1u).size();
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        EXPECT_TRUE(writer.TryReuse(2u, sourcePath, nc::asset::CompressionAlgorithm::none));
+        EXPECT_TRUE(writer.TryReuse(1u, sourcePath, nc::asset::CompressionAlgorithm::none));
+        writer.CarryForwardUnreferenced();
+        writer.Finalize();
+        EXPECT_EQ(2 * ncaSize, writer.GetDeduplicatedBytes());
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    ASSERT_EQ(4u, package.GetEntries().size());
+    EXPECT_EQ(package.GetEntry(1u).offset, package.GetEntry(2u).offset);
+    EXPECT_EQ(package.GetEntry(1u).offset, package.GetEntry(4u).offset);
+    EXPECT_NE(package.GetEntry(1u).offset, package.GetEntry(3u).offset);
+    EXPECT_EQ(2u, nc::asset::ImportNcaHeader(package, 2u).assetId);
+    EXPECT_EQ(texture.pixelData, nc::asset::ImportTexture(package, 1u).pixelData);
+    EXPECT_EQ(texture.pixelData, nc::asset::ImportTexture(package, 4u).pixelData);
+    EXPECT_EQ(variant.pixelData, nc::asset::ImportTexture(package, 3u).pixelData);
+}
+
+#ifdef NC_TOOLS_ZSTD
+TEST_F(BuildAndImportTest, Package_zstd_registersEmbeddedDictionary)
+{
+    namespace test_data = collateral::rgb_corners;
+    const auto packagePath = ncaTestOutDirectory / "zstd_package.ncp";
+    const auto target = nc::convert::Target{test_data::pngFilePath, ncaTestOutDirectory / "rgb_png_zstd.nca"};
+    const auto textureId = nc::convert::GetAssetId(target.destinationPath);
+    auto builder = nc::convert::Builder{};
+    auto nca = std::ostringstream{std::ios::binary};
+    ASSERT_TRUE(builder.Build(nc::asset::AssetType::Texture, target, nca));
+
+    // Stand in for a manifest's worth of similar textures.
+    const auto blob = nca.view().substr(nc::asset::NcaHeader::binarySize);
+    auto samples = std::vector<std::string>{};
+    for (auto i = 0u; i < 32u; ++i)
+    {
+        auto& sample = samples.emplace_back();
+        for (auto copy = 0u; copy < 4u; ++copy)
+        {
+            sample.append(blob);
+            sample[sample.size() - 1 - i] = static_cast<char>(i * 7u + copy);
+        }
+    }
+
+    auto sampleBytes = std::vector<std::span<const std::byte>>{};
+    for (const auto& sample : samples)
+    {
+        sampleBytes.push_back(std::as_bytes(std::span{sample.data(), sample.size()}));
+    }
+
+    const auto dictionary = nc::convert::TrainDictionary(sampleBytes);
+    ASSERT_TRUE(dictionary.has_value());
+
+    {
+        auto writer = nc::convert::PackageWriter{packagePath};
+        auto compressed = std::ostringstream{std::ios::binary};
+        nc::convert::Compress(compressed, nca.view(), nc::asset::CompressionAlgorithm::zstd, &dictionary.value());
+        writer.Add(textureId, compressed.view());
+        auto record = std::ostringstream{std::ios::binary};
+        nc::convert::Serialize(record, dictionary.value());
+        writer.Add(nc::asset::GetDictionaryAssetId(dictionary->GetId()), record.view());
+        writer.Finalize();
+    }
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    EXPECT_STREQ("ZSTD", nc::asset::ImportNcaHeader(package, textureId).compressionAlgorithm);
+
+    const auto texture = nc::asset::ImportTexture(package, textureId);
+    EXPECT_EQ(test_data::width, texture.width);
+    EXPECT_EQ(test_data::height, texture.height);
+    ASSERT_EQ(test_data::numBytes, texture.pixelData.size());
+    for (auto pixelIndex = 0u; pixelIndex < test_data::numPixels; ++pixelIndex)
+    {
+        EXPECT_EQ(test_data::pixels[pixelIndex], ReadPixel(texture.pixelData.data(), pixelIndex * 4));
+    }
+}
+#endif
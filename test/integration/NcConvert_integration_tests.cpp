@@ -4,7 +4,15 @@
 
 #include "fmt/format.h"
 
+#include <array>
+#include <cstdint>
 #include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
 
 #ifndef NC_CONVERT_EXECUTABLE_PATH
 #error NC_CONVERT_EXECUTABLE_PATH must be defined for nc-convert integration tests
@@ -38,6 +46,12 @@ auto BuildSingleTargetCommand(std::string_view type, std::string_view sourceName
     );
 }
 
+auto ReadFileBytes(const std::filesystem::path& path) -> std::string
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    return std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
 class NcConvertIntegration : public ::testing::Test
 {
     public:
@@ -159,6 +173,42 @@ TEST_F(NcConvertIntegration, SingleTarget_noName_fails)
     EXPECT_EQ(RunCmd(cmd), ResultCode::ArgumentError);
 }
 
+TEST_F(NcConvertIntegration, SingleTarget_package_succeeds)
+{
+    const auto packagePath = ncaTestOutDirectory / "package.ncp";
+    const auto textureCmd = fmt::format(R"({} -p "{}")", BuildSingleTargetCommand("texture", "rgb_corners_4x8.png", "myTexture"), packagePath.string());
+    ASSERT_EQ(RunCmd(textureCmd), ResultCode::Success);
+    EXPECT_TRUE(std::filesystem::exists(packagePath));
+    EXPECT_FALSE(std::filesystem::exists(ncaTestOutDirectory / "myTexture.nca"));
+
+    const auto audioCmd = fmt::format(R"({} -p "{}")", BuildSingleTargetCommand("audio-clip", "sine_c_e.wav", "myAudioClip"), packagePath.string());
+    ASSERT_EQ(RunCmd(audioCmd), ResultCode::Success);
+    EXPECT_TRUE(std::filesystem::exists(packagePath));
+    EXPECT_FALSE(std::filesystem::exists(ncaTestOutDirectory / "myAudioClip.nca"));
+}
+
+TEST_F(NcConvertIntegration, SingleTarget_package_doesNotCreateOutputDirectory)
+{
+    const auto outputDirectory = ncaTestOutDirectory / "unused";
+    const auto packagePath = ncaTestOutDirectory / "packages" / "package.ncp";
+    const auto source = (collateral::collateralDirectory / "rgb_corners_4x8.png").string();
+    const auto cmd = fmt::format(R"({} -t texture -s "{}" -n myTexture -o "{}" -p "{}")",
+        exeName, source, outputDirectory.string(), packagePath.string()
+    );
+
+    ASSERT_EQ(RunCmd(cmd), ResultCode::Success);
+    EXPECT_TRUE(std::filesystem::exists(packagePath));
+    EXPECT_FALSE(std::filesystem::exists(outputDirectory));
+}
+
+TEST_F(NcConvertIntegration, SingleTarget_loadTraceWithoutPackage_fails)
+{
+    const auto tracePath = ncaTestOutDirectory / "startup.trace";
+    const auto cmd = fmt::format(R"({} -l "{}")", BuildSingleTargetCommand("texture", "rgb_corners_4x8.png", "myTexture"), tracePath.string());
+    EXPECT_EQ(RunCmd(cmd), ResultCode::ArgumentError);
+    EXPECT_FALSE(std::filesystem::exists(ncaTestOutDirectory / "myTexture.nca"));
+}
+
 TEST_F(NcConvertIntegration, Manifest_succeeds)
 {
     const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
@@ -179,6 +229,179 @@ TEST_F(NcConvertIntegration, Manifest_succeeds)
     EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "wiggle.nca"));
 }
 
+TEST_F(NcConvertIntegration, Manifest_parallel_succeeds)
+{
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    const auto cmd = fmt::format(R"({} -m "{}" -j 4)", exeName, manifestPath);
+    const auto result = RunCmd(cmd);
+    ASSERT_EQ(result, ResultCode::Success);
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "myAudioClip.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "myConcaveCollider.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "myCubeMap.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "myHullCollider.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "myMesh.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "myMultiOutputMesh.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "myTexture.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "cube1.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "cube1a.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "cube2.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "cube3.nca"));
+    EXPECT_TRUE(std::filesystem::exists(ncaTestOutDirectory / "wiggle.nca"));
+}
+
+TEST_F(NcConvertIntegration, Manifest_parallel_matchesSerialOutput)
+{
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    const auto logPath = collateral::collateralDirectory / "parallel_test.log";
+    const auto packagePath = collateral::collateralDirectory / "parallel_test.ncp";
+    const auto readLog = [&logPath]()
+    {
+        // Only the job count line differs between a serial and a parallel build.
+        auto log = std::istringstream{ReadFileBytes(logPath)};
+        auto out = std::string{};
+        for (auto line = std::string{}; std::getline(log, line);)
+        {
+            if (!line.starts_with("Building with up to"))
+            {
+                out += line + '\n';
+            }
+        }
+
+        std::filesystem::remove(logPath);
+        return out;
+    };
+
+    const auto buildFiles = [&](size_t jobCount)
+    {
+        std::filesystem::remove_all(ncaTestOutDirectory);
+        std::filesystem::create_directory(ncaTestOutDirectory);
+        const auto cmd = fmt::format(R"({} -m "{}" -j {} > "{}")", exeName, manifestPath, jobCount, logPath.string());
+        EXPECT_EQ(RunCmd(cmd), ResultCode::Success);
+        auto ncas = std::map<std::string, std::string>{};
+        for (const auto& entry : std::filesystem::directory_iterator{ncaTestOutDirectory})
+        {
+            ncas.emplace(entry.path().filename().string(), ReadFileBytes(entry.path()));
+        }
+
+        return std::pair{readLog(), ncas};
+    };
+
+    const auto buildPackage = [&](size_t jobCount)
+    {
+        std::filesystem::remove(packagePath);
+        std::filesystem::remove(packagePath.string() + ".settings");
+        const auto cmd = fmt::format(R"({} -m "{}" -p "{}" -j {} > "{}")", exeName, manifestPath, packagePath.string(), jobCount, logPath.string());
+        EXPECT_EQ(RunCmd(cmd), ResultCode::Success);
+
+        // Entries record when they were written, so each entry's lastUpdated is cleared before comparing.
+        auto package = ReadFileBytes(packagePath);
+        constexpr auto headerSize = size_t{20};
+        constexpr auto entrySize = size_t{24};
+        constexpr auto lastUpdatedOffset = size_t{16};
+        auto assetCount = uint64_t{};
+        std::memcpy(&assetCount, package.data() + headerSize - sizeof(assetCount), sizeof(assetCount));
+        for (auto i = size_t{0}; i < assetCount; ++i)
+        {
+            std::memset(package.data() + headerSize + i * entrySize + lastUpdatedOffset, 0, sizeof(int64_t));
+        }
+
+        std::filesystem::remove(packagePath);
+        std::filesystem::remove(packagePath.string() + ".settings");
+        return std::pair{readLog(), package};
+    };
+
+    const auto serialFiles = buildFiles(1);
+    const auto parallelFiles = buildFiles(4);
+    EXPECT_FALSE(serialFiles.first.empty());
+    EXPECT_EQ(serialFiles.first, parallelFiles.first);
+    EXPECT_FALSE(serialFiles.second.empty());
+    EXPECT_EQ(serialFiles.second, parallelFiles.second);
+
+    const auto serialPackage = buildPackage(1);
+    const auto parallelPackage = buildPackage(4);
+    EXPECT_EQ(serialPackage.first, parallelPackage.first);
+    EXPECT_FALSE(serialPackage.second.empty());
+    EXPECT_EQ(serialPackage.second, parallelPackage.second);
+}
+
+TEST_F(NcConvertIntegration, Manifest_parallel_excessiveJobCount_fails)
+{
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    const auto cmd = fmt::format(R"({} -m "{}" -j 100000000)", exeName, manifestPath);
+    EXPECT_EQ(RunCmd(cmd), ResultCode::RuntimeError);
+    EXPECT_FALSE(std::filesystem::exists(ncaTestOutDirectory / "myTexture.nca"));
+}
+
+TEST_F(NcConvertIntegration, Manifest_parallel_invalidJobCount_fails)
+{
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    const auto cmd = fmt::format(R"({} -m "{}" -j four)", exeName, manifestPath);
+    EXPECT_EQ(RunCmd(cmd), ResultCode::ArgumentError);
+}
+
+TEST_F(NcConvertIntegration, Manifest_parallel_outOfRangeJobCount_fails)
+{
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    const auto cmd = fmt::format(R"({} -m "{}" -j 99999999999999999999999)", exeName, manifestPath);
+    EXPECT_EQ(RunCmd(cmd), ResultCode::ArgumentError);
+}
+
+TEST_F(NcConvertIntegration, Manifest_outOfRangeAlignment_fails)
+{
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    const auto cmd = fmt::format(R"({} -m "{}" -a 99999999999999999999999)", exeName, manifestPath);
+    EXPECT_EQ(RunCmd(cmd), ResultCode::ArgumentError);
+}
+
+TEST_F(NcConvertIntegration, Manifest_changedCompression_rebuilds)
+{
+    const auto readCompression = [](const std::filesystem::path& ncaPath)
+    {
+        // The codec follows the 4 byte magic number in the nca header.
+        auto file = std::ifstream{ncaPath, std::ios::binary};
+        auto header = std::array<char, 8>{};
+        file.read(header.data(), header.size());
+        return std::string{header.data() + 4, ::strnlen(header.data() + 4, 4)};
+    };
+
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    ASSERT_EQ(RunCmd(fmt::format(R"({} -m "{}")", exeName, manifestPath)), ResultCode::Success);
+    EXPECT_EQ("NONE", readCompression(ncaTestOutDirectory / "myTexture.nca"));
+
+    ASSERT_EQ(RunCmd(fmt::format(R"({} -m "{}" -c texture=lz4)", exeName, manifestPath)), ResultCode::Success);
+    EXPECT_EQ("LZ4", readCompression(ncaTestOutDirectory / "myTexture.nca"));
+    EXPECT_EQ("NONE", readCompression(ncaTestOutDirectory / "myAudioClip.nca"));
+
+    ASSERT_EQ(RunCmd(fmt::format(R"({} -m "{}")", exeName, manifestPath)), ResultCode::Success);
+    EXPECT_EQ("NONE", readCompression(ncaTestOutDirectory / "myTexture.nca"));
+}
+
+TEST_F(NcConvertIntegration, Manifest_changedAlignment_rebuilds)
+{
+    // A texture blob's pixel array prefix follows its width and height: a u64 count, then a u32 padding size.
+    constexpr auto paddingOffset = size_t{24 + 8 + 8};
+    constexpr auto pixelOffset = paddingOffset + sizeof(uint32_t);
+    const auto readPixelDataOffset = [](const std::filesystem::path& ncaPath)
+    {
+        auto file = std::ifstream{ncaPath, std::ios::binary};
+        auto padding = uint32_t{};
+        file.seekg(paddingOffset);
+        file.read(reinterpret_cast<char*>(&padding), sizeof(padding));
+        return pixelOffset + padding;
+    };
+
+    const auto manifestPath = (collateral::collateralDirectory / "manifest.json").string();
+    ASSERT_EQ(RunCmd(fmt::format(R"({} -m "{}")", exeName, manifestPath)), ResultCode::Success);
+    EXPECT_NE(0u, readPixelDataOffset(ncaTestOutDirectory / "myTexture.nca") % 64);
+
+    ASSERT_EQ(RunCmd(fmt::format(R"({} -m "{}" -a 64)", exeName, manifestPath)), ResultCode::Success);
+    EXPECT_EQ(0u, readPixelDataOffset(ncaTestOutDirectory / "myTexture.nca") % 64);
+
+    ASSERT_EQ(RunCmd(fmt::format(R"({} -m "{}")", exeName, manifestPath)), ResultCode::Success);
+    EXPECT_EQ(0u, readPixelDataOffset(ncaTestOutDirectory / "myTexture.nca") % 16);
+    EXPECT_NE(0u, readPixelDataOffset(ncaTestOutDirectory / "myTexture.nca") % 64);
+}
+
 TEST_F(NcConvertIntegration, Manifest_subResourceMeshNotPresent_manifestFails)
 {
     // Added a mesh entry called "idontexist" in the manifest.
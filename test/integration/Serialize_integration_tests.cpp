@@ -3,10 +3,16 @@
 #include "builder/Serialize.h"
 #include "utility/BlobSize.h"
 #include "ncasset/Assets.h"
+#include "ncasset/AssetViews.h"
+#include "ncasset/PmrAssets.h"
 
 #include "ncmath/Math.h"
+#include "ncutility/NcError.h"
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
+#include <memory_resource>
 #include <sstream>
 
 namespace nc::asset
@@ -476,3 +482,822 @@ TEST(SerializationTest, SkeletalAnimation_roundTrip_succeeds)
     EXPECT_FLOAT_EQ(secondBoneFrames.scaleFrames.at(2).scale.y, 5.2f);
     EXPECT_FLOAT_EQ(secondBoneFrames.scaleFrames.at(2).scale.z, 5.2f);
 }
+
+auto ToBytes(const std::stringstream& stream) -> std::vector<std::byte>
+{
+    const auto str = stream.str();
+    auto out = std::vector<std::byte>(str.size());
+    std::memcpy(out.data(), str.data(), str.size());
+    return out;
+}
+
+TEST(SerializationTest, MeshView_referencesSerializedData)
+{
+    constexpr auto assetId = 1234ull;
+    const auto expectedAsset = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 2.0f, 3.0f},
+        .maxExtent = 3.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>{
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(1.0f)},
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(2.0f)},
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(3.0f)}
+        },
+        .indices = std::vector<uint32_t>{0, 1, 2},
+        .bonesData = std::nullopt
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, expectedAsset, assetId);
+    const auto bytes = ToBytes(stream);
+    const auto [actualHeader, actualView] = nc::asset::DeserializeMeshView(bytes);
+
+    EXPECT_STREQ("MESH", actualHeader.magicNumber);
+    EXPECT_EQ(assetId, actualHeader.assetId);
+    EXPECT_EQ(expectedAsset.extents, actualView.extents);
+    EXPECT_EQ(expectedAsset.maxExtent, actualView.maxExtent);
+    ASSERT_EQ(expectedAsset.vertices.size(), actualView.vertices.size());
+    ASSERT_EQ(expectedAsset.indices.size(), actualView.indices.size());
+    EXPECT_FALSE(actualView.bonesData.has_value());
+
+    const auto dataBegin = bytes.data();
+    const auto dataEnd = bytes.data() + bytes.size();
+    const auto vertexBegin = reinterpret_cast<const std::byte*>(actualView.vertices.data());
+    EXPECT_TRUE(vertexBegin > dataBegin && vertexBegin < dataEnd);
+
+    for(auto i = 0u; i < expectedAsset.vertices.size(); ++i)
+    {
+        EXPECT_EQ(expectedAsset.vertices[i], actualView.vertices[i]);
+    }
+
+    EXPECT_TRUE(std::equal(expectedAsset.indices.cbegin(),
+                           expectedAsset.indices.cend(),
+                           actualView.indices.begin()));
+}
+
+TEST(SerializationTest, TextureView_truncatedData_throws)
+{
+    const auto expectedAsset = nc::asset::Texture{
+        .width = 1, .height = 1,
+        .pixelData = std::vector<unsigned char>{0xA1, 0xA2, 0xA3, 0xA4}
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, expectedAsset, 1234ull);
+    auto bytes = ToBytes(stream);
+
+    const auto [header, view] = nc::asset::DeserializeTextureView(bytes);
+    EXPECT_EQ(expectedAsset.width, view.width);
+    EXPECT_EQ(expectedAsset.height, view.height);
+    EXPECT_TRUE(std::equal(expectedAsset.pixelData.cbegin(),
+                           expectedAsset.pixelData.cend(),
+                           view.pixelData.begin()));
+
+    bytes.pop_back();
+    EXPECT_THROW(nc::asset::DeserializeTextureView(bytes), nc::NcError);
+}
+
+/** Fails any allocation that does not go through an explicitly provided resource. */
+class NullDefaultResource
+{
+    public:
+        NullDefaultResource()
+            : m_previous{std::pmr::set_default_resource(std::pmr::null_memory_resource())}
+        {
+        }
+
+        ~NullDefaultResource()
+        {
+            std::pmr::set_default_resource(m_previous);
+        }
+
+    private:
+        std::pmr::memory_resource* m_previous;
+};
+
+TEST(SerializationTest, Mesh_pmr_allocatesFromResource)
+{
+    auto expectedAsset = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 2.0f, 3.0f},
+        .maxExtent = 3.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>{
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(1.0f)},
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(2.0f)},
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(3.0f)}
+        },
+        .indices = std::vector<uint32_t>{0, 1, 2},
+        .bonesData = nc::asset::BonesData{}
+    };
+
+    auto& bones = expectedAsset.bonesData.value();
+    bones.boneMapping.emplace("A bone name long enough to avoid small string optimization", 0u);
+    bones.vertexSpaceToBoneSpace.push_back(nc::asset::VertexSpaceToBoneSpace{
+        "A bone name long enough to avoid small string optimization", DirectX::XMMATRIX{}
+    });
+    bones.boneSpaceToParentSpace.push_back(nc::asset::BoneSpaceToParentSpace{
+        "A bone name long enough to avoid small string optimization", DirectX::XMMATRIX{}, 0u, 0u
+    });
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, expectedAsset, 1234ull);
+
+    auto buffer = std::array<std::byte, 4096>{};
+    auto arena = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    auto guard = NullDefaultResource{};
+    const auto [actualHeader, actualAsset] = nc::asset::DeserializeMesh(stream, &arena);
+
+    EXPECT_STREQ("MESH", actualHeader.magicNumber);
+    EXPECT_EQ(expectedAsset.extents, actualAsset.extents);
+    EXPECT_EQ(&arena, actualAsset.vertices.get_allocator().resource());
+    ASSERT_EQ(expectedAsset.vertices.size(), actualAsset.vertices.size());
+    EXPECT_EQ(expectedAsset.vertices[2], actualAsset.vertices[2]);
+    EXPECT_TRUE(std::equal(expectedAsset.indices.cbegin(),
+                           expectedAsset.indices.cend(),
+                           actualAsset.indices.cbegin()));
+
+    ASSERT_TRUE(actualAsset.bonesData.has_value());
+    const auto& actualBones = actualAsset.bonesData.value();
+    EXPECT_EQ(&arena, actualBones.boneSpaceToParentSpace.get_allocator().resource());
+    EXPECT_EQ(&arena, actualBones.boneSpaceToParentSpace.at(0).boneName.get_allocator().resource());
+    EXPECT_EQ(std::string_view{bones.vertexSpaceToBoneSpace.at(0).boneName}, actualBones.vertexSpaceToBoneSpace.at(0).boneName);
+    EXPECT_EQ(1u, actualBones.boneMapping.size());
+}
+
+TEST(SerializationTest, SkeletalAnimation_pmr_allocatesFromResource)
+{
+    const auto expectedAsset = nc::asset::SkeletalAnimation{
+        .name = "An animation name long enough to avoid small string optimization",
+        .durationInTicks = 128,
+        .ticksPerSecond = 64,
+        .framesPerBone = std::unordered_map<std::string, nc::asset::SkeletalAnimationFrames>{
+            {"Bone0", nc::asset::SkeletalAnimationFrames{
+                std::vector<nc::asset::PositionFrame>{nc::asset::PositionFrame{1, nc::Vector3{0.1f, 0.2f, 0.3f}}},
+                std::vector<nc::asset::RotationFrame>{},
+                std::vector<nc::asset::ScaleFrame>{nc::asset::ScaleFrame{2, nc::Vector3{2.0f, 2.0f, 2.0f}}}
+            }}
+        }
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, expectedAsset, 1234ull);
+
+    auto buffer = std::array<std::byte, 4096>{};
+    auto arena = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    auto guard = NullDefaultResource{};
+    const auto [actualHeader, actualAsset] = nc::asset::DeserializeSkeletalAnimation(stream, &arena);
+
+    EXPECT_EQ(std::string_view{expectedAsset.name}, actualAsset.name);
+    EXPECT_EQ(&arena, actualAsset.name.get_allocator().resource());
+    EXPECT_EQ(128u, actualAsset.durationInTicks);
+    ASSERT_EQ(1u, actualAsset.framesPerBone.size());
+
+    const auto& frames = actualAsset.framesPerBone.begin()->second;
+    EXPECT_EQ("Bone0", actualAsset.framesPerBone.begin()->first);
+    EXPECT_EQ(&arena, frames.positionFrames.get_allocator().resource());
+    ASSERT_EQ(1u, frames.positionFrames.size());
+    EXPECT_FLOAT_EQ(0.2f, frames.positionFrames.at(0).position.y);
+    EXPECT_TRUE(frames.rotationFrames.empty());
+    EXPECT_FLOAT_EQ(2.0f, frames.scaleFrames.at(0).scale.z);
+}
+
+TEST(SerializationTest, Texture_deserializeIntoExisting_reusesCapacity)
+{
+    const auto small = nc::asset::Texture{
+        .width = 1, .height = 1,
+        .pixelData = std::vector<unsigned char>{0xA1, 0xA2, 0xA3, 0xA4}
+    };
+
+    const auto large = nc::asset::Texture{
+        .width = 2, .height = 1,
+        .pixelData = std::vector<unsigned char>{0xB1, 0xB2, 0xB3, 0xB4, 0xB5, 0xB6, 0xB7, 0xB8}
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, large, 1u);
+    nc::convert::Serialize(stream, small, 2u);
+    nc::convert::Serialize(stream, large, 3u);
+
+    auto reused = nc::asset::Texture{};
+    EXPECT_EQ(1u, nc::asset::DeserializeTexture(stream, reused).assetId);
+    EXPECT_EQ(large.pixelData, reused.pixelData);
+    const auto* buffer = reused.pixelData.data();
+
+    EXPECT_EQ(2u, nc::asset::DeserializeTexture(stream, reused).assetId);
+    EXPECT_EQ(small.width, reused.width);
+    EXPECT_EQ(small.pixelData, reused.pixelData);
+    EXPECT_EQ(buffer, reused.pixelData.data());
+
+    EXPECT_EQ(3u, nc::asset::DeserializeTexture(stream, reused).assetId);
+    EXPECT_EQ(large.pixelData, reused.pixelData);
+    EXPECT_EQ(buffer, reused.pixelData.data());
+}
+
+TEST(SerializationTest, Mesh_deserializeIntoExisting_replacesContents)
+{
+    auto withBones = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 1.0f, 1.0f},
+        .maxExtent = 1.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(3),
+        .indices = std::vector<uint32_t>{0, 1, 2},
+        .bonesData = nc::asset::BonesData{}
+    };
+
+    withBones.bonesData->boneMapping.emplace("Bone0", 0u);
+    withBones.bonesData->vertexSpaceToBoneSpace.push_back(nc::asset::VertexSpaceToBoneSpace{"Bone0", DirectX::XMMATRIX{}});
+
+    const auto withoutBones = nc::asset::Mesh{
+        .extents = nc::Vector3{2.0f, 2.0f, 2.0f},
+        .maxExtent = 2.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(2),
+        .indices = std::vector<uint32_t>{1, 0},
+        .bonesData = std::nullopt
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, withBones, 1u);
+    nc::convert::Serialize(stream, withoutBones, 2u);
+
+    auto reused = nc::asset::Mesh{};
+    nc::asset::DeserializeMesh(stream, reused);
+    ASSERT_TRUE(reused.bonesData.has_value());
+    EXPECT_EQ(1u, reused.bonesData->vertexSpaceToBoneSpace.size());
+    EXPECT_EQ("Bone0", reused.bonesData->vertexSpaceToBoneSpace.at(0).boneName);
+    const auto* indexBuffer = reused.indices.data();
+
+    nc::asset::DeserializeMesh(stream, reused);
+    EXPECT_EQ(withoutBones.extents, reused.extents);
+    EXPECT_EQ(2u, reused.vertices.size());
+    EXPECT_EQ(withoutBones.indices, reused.indices);
+    EXPECT_EQ(indexBuffer, reused.indices.data());
+    EXPECT_FALSE(reused.bonesData.has_value());
+}
+
+TEST(SerializationTest, SkeletalAnimation_deserializeIntoExisting_reusesBoneNodes)
+{
+    const auto makeFrames = [](size_t count)
+    {
+        return nc::asset::SkeletalAnimationFrames{
+            std::vector<nc::asset::PositionFrame>(count),
+            std::vector<nc::asset::RotationFrame>(count),
+            std::vector<nc::asset::ScaleFrame>(count)
+        };
+    };
+
+    const auto first = nc::asset::SkeletalAnimation{
+        .name = "Walk",
+        .durationInTicks = 10,
+        .ticksPerSecond = 30.0f,
+        .framesPerBone = std::unordered_map<std::string, nc::asset::SkeletalAnimationFrames>{
+            {"Root", makeFrames(8)},
+            {"Arm", makeFrames(4)}
+        }
+    };
+
+    const auto second = nc::asset::SkeletalAnimation{
+        .name = "Run",
+        .durationInTicks = 5,
+        .ticksPerSecond = 30.0f,
+        .framesPerBone = std::unordered_map<std::string, nc::asset::SkeletalAnimationFrames>{
+            {"Root", makeFrames(2)},
+            {"Leg", makeFrames(3)}
+        }
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, first, 1u);
+    nc::convert::Serialize(stream, second, 2u);
+
+    auto reused = nc::asset::SkeletalAnimation{};
+    nc::asset::DeserializeSkeletalAnimation(stream, reused);
+    const auto* rootFrames = &reused.framesPerBone.at("Root");
+    const auto* rootPositions = rootFrames->positionFrames.data();
+
+    nc::asset::DeserializeSkeletalAnimation(stream, reused);
+    EXPECT_EQ(second.name, reused.name);
+    ASSERT_EQ(2u, reused.framesPerBone.size());
+    EXPECT_EQ(3u, reused.framesPerBone.at("Leg").positionFrames.size());
+    EXPECT_FALSE(reused.framesPerBone.contains("Arm"));
+    EXPECT_EQ(rootFrames, &reused.framesPerBone.at("Root"));
+    EXPECT_EQ(rootPositions, reused.framesPerBone.at("Root").positionFrames.data());
+    EXPECT_EQ(2u, reused.framesPerBone.at("Root").positionFrames.size());
+}
+
+TEST(SerializationTest, BlobSize_matchesSerializedBytes)
+{
+    auto mesh = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 1.0f, 1.0f},
+        .maxExtent = 1.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(5),
+        .indices = std::vector<uint32_t>{0, 1, 2, 2, 3, 4},
+        .bonesData = nc::asset::BonesData{}
+    };
+
+    mesh.bonesData->boneMapping.emplace("Root", 0u);
+    mesh.bonesData->boneMapping.emplace("Child", 1u);
+    mesh.bonesData->vertexSpaceToBoneSpace.push_back(nc::asset::VertexSpaceToBoneSpace{"Root", DirectX::XMMATRIX{}});
+    mesh.bonesData->boneSpaceToParentSpace.push_back(nc::asset::BoneSpaceToParentSpace{"Root", DirectX::XMMATRIX{}, 1u, 1u});
+    mesh.bonesData->boneSpaceToParentSpace.push_back(nc::asset::BoneSpaceToParentSpace{"Child", DirectX::XMMATRIX{}, 0u, 0u});
+
+    const auto audioClip = nc::asset::AudioClip{
+        .samplesPerChannel = 3,
+        .leftChannel = std::vector<double>{0.1, 0.2, 0.3},
+        .rightChannel = std::vector<double>{0.4, 0.5, 0.6}
+    };
+
+    const auto animation = nc::asset::SkeletalAnimation{
+        .name = "Walk",
+        .durationInTicks = 10,
+        .ticksPerSecond = 30.0f,
+        .framesPerBone = std::unordered_map<std::string, nc::asset::SkeletalAnimationFrames>{
+            {"Root", nc::asset::SkeletalAnimationFrames{
+                std::vector<nc::asset::PositionFrame>(2),
+                std::vector<nc::asset::RotationFrame>(3),
+                std::vector<nc::asset::ScaleFrame>(1)
+            }}
+        }
+    };
+
+    const auto serializedBlobSize = [](const auto& asset, size_t alignment)
+    {
+        auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+        nc::convert::Serialize(stream, asset, 1u, nc::asset::CompressionAlgorithm::none, alignment);
+        return stream.str().size() - nc::asset::NcaHeader::binarySize;
+    };
+
+    for (const auto alignment : {size_t{1}, size_t{16}, size_t{64}})
+    {
+        auto meshCopy = mesh;
+        EXPECT_EQ(serializedBlobSize(meshCopy, alignment), nc::convert::GetBlobSize(meshCopy, alignment));
+        meshCopy.bonesData = std::nullopt;
+        EXPECT_EQ(serializedBlobSize(meshCopy, alignment), nc::convert::GetBlobSize(meshCopy, alignment));
+        EXPECT_EQ(serializedBlobSize(audioClip, alignment), nc::convert::GetBlobSize(audioClip, alignment));
+        EXPECT_EQ(serializedBlobSize(animation, alignment), nc::convert::GetBlobSize(animation, alignment));
+    }
+}
+
+TEST(SerializationTest, MeshView_alignment_alignsArraysFromNcaStart)
+{
+    constexpr auto alignment = size_t{64};
+    const auto mesh = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 1.0f, 1.0f},
+        .maxExtent = 1.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(3),
+        .indices = std::vector<uint32_t>{0, 1, 2},
+        .bonesData = std::nullopt
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, mesh, 1u, nc::asset::CompressionAlgorithm::none, alignment);
+    const auto bytes = ToBytes(stream);
+    const auto [header, view] = nc::asset::DeserializeMeshView(bytes);
+    const auto offsetOf = [&bytes](const void* data)
+    {
+        return static_cast<size_t>(static_cast<const std::byte*>(data) - bytes.data());
+    };
+
+    EXPECT_EQ(0u, offsetOf(view.vertices.data()) % alignment);
+    EXPECT_EQ(0u, offsetOf(view.indices.data()) % alignment);
+    EXPECT_EQ(mesh.indices.size(), view.indices.size());
+}
+
+TEST(SerializationTest, Serialize_invalidAlignment_throws)
+{
+    const auto texture = nc::asset::Texture{
+        .width = 1, .height = 1,
+        .pixelData = std::vector<unsigned char>(4)
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    EXPECT_THROW(nc::convert::Serialize(stream, texture, 1u, nc::asset::CompressionAlgorithm::none, 3), nc::NcError);
+    EXPECT_THROW(nc::convert::Serialize(stream, texture, 1u, nc::asset::CompressionAlgorithm::none, 8192), nc::NcError);
+}
+
+TEST(SerializationTest, Mesh_fromBytes_roundTrip_succeeds)
+{
+    auto expectedAsset = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 2.0f, 3.0f},
+        .maxExtent = 3.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>{
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(1.0f)},
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(2.0f)}
+        },
+        .indices = std::vector<uint32_t>{0, 1, 1},
+        .bonesData = nc::asset::BonesData{}
+    };
+
+    expectedAsset.bonesData->boneMapping.emplace("Root", 0u);
+    expectedAsset.bonesData->boneSpaceToParentSpace.push_back(nc::asset::BoneSpaceToParentSpace{"Root", DirectX::XMMATRIX{}, 0u, 0u});
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, expectedAsset, 1234ull);
+    const auto bytes = ToBytes(stream);
+
+    EXPECT_EQ(1234ull, nc::asset::DeserializeHeader(bytes).assetId);
+    const auto [actualHeader, actualAsset] = nc::asset::DeserializeMesh(bytes);
+    EXPECT_STREQ("MESH", actualHeader.magicNumber);
+    EXPECT_EQ(expectedAsset.extents, actualAsset.extents);
+    ASSERT_EQ(expectedAsset.vertices.size(), actualAsset.vertices.size());
+    EXPECT_EQ(expectedAsset.vertices[1], actualAsset.vertices[1]);
+    EXPECT_EQ(expectedAsset.indices, actualAsset.indices);
+    ASSERT_TRUE(actualAsset.bonesData.has_value());
+    EXPECT_EQ(0u, actualAsset.bonesData->boneMapping.at("Root"));
+    EXPECT_EQ("Root", actualAsset.bonesData->boneSpaceToParentSpace.at(0).boneName);
+
+    auto buffer = std::array<std::byte, 1024>{};
+    auto arena = std::pmr::monotonic_buffer_resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+    const auto pmrMesh = nc::asset::DeserializeMesh(bytes, &arena).asset;
+    EXPECT_EQ(expectedAsset.indices.size(), pmrMesh.indices.size());
+
+    auto reused = nc::asset::Mesh{};
+    nc::asset::DeserializeMesh(bytes, reused);
+    EXPECT_EQ(expectedAsset.indices, reused.indices);
+}
+
+TEST(SerializationTest, Texture_fromBytes_invalidData_throws)
+{
+    const auto expectedAsset = nc::asset::Texture{
+        .width = 1, .height = 1,
+        .pixelData = std::vector<unsigned char>{0xA1, 0xA2, 0xA3, 0xA4}
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, expectedAsset, 1234ull);
+    auto bytes = ToBytes(stream);
+    EXPECT_EQ(expectedAsset.pixelData, nc::asset::DeserializeTexture(bytes).asset.pixelData);
+    EXPECT_THROW(nc::asset::DeserializeMesh(bytes), nc::NcError);
+
+    // Pixel count is stored after the 24 byte header, width and height.
+    auto corrupted = bytes;
+    const auto hugeCount = std::numeric_limits<size_t>::max() / 2;
+    std::memcpy(corrupted.data() + 32, &hugeCount, sizeof(hugeCount));
+    EXPECT_THROW(nc::asset::DeserializeTexture(corrupted), nc::NcError);
+
+    bytes.pop_back();
+    EXPECT_THROW(nc::asset::DeserializeTexture(bytes), nc::NcError);
+    EXPECT_THROW(nc::asset::DeserializeHeader(std::span{bytes}.first(10)), nc::NcError);
+}
+
+TEST(SerializationTest, Texture_region_readsOnlyRequestedPixels)
+{
+    // 5x4 texture where every channel of a pixel holds its index.
+    auto texture = nc::asset::Texture{.width = 5, .height = 4, .pixelData = {}};
+    for (auto i = 0u; i < texture.width * texture.height; ++i)
+    {
+        texture.pixelData.insert(texture.pixelData.end(), 4, static_cast<unsigned char>(i));
+    }
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, texture, 1234ull);
+    nc::convert::Serialize(stream, texture, 5678ull);
+    const auto bytes = ToBytes(stream);
+
+    const auto expectedRegion = std::vector<unsigned char>{
+        6, 6, 6, 6, 7, 7, 7, 7, 8, 8, 8, 8,
+        11, 11, 11, 11, 12, 12, 12, 12, 13, 13, 13, 13
+    };
+
+    stream.seekg(0);
+    const auto [header, region] = nc::asset::DeserializeTextureRegion(stream, nc::asset::TextureRegion{1, 1, 3, 2});
+    EXPECT_EQ(1234ull, header.assetId);
+    EXPECT_EQ(3u, region.width);
+    EXPECT_EQ(2u, region.height);
+    EXPECT_EQ(expectedRegion, region.pixelData);
+
+    // The stream is left at the end of the asset, so the next one can be read.
+    const auto rows = nc::asset::DeserializeTextureRows(stream, 2, 2);
+    EXPECT_EQ(5678ull, rows.header.assetId);
+    EXPECT_EQ(5u, rows.asset.width);
+    EXPECT_EQ(2u, rows.asset.height);
+    EXPECT_TRUE(std::equal(rows.asset.pixelData.cbegin(), rows.asset.pixelData.cend(), texture.pixelData.cbegin() + 40));
+
+    const auto fromBytes = nc::asset::DeserializeTextureRegion(bytes, nc::asset::TextureRegion{1, 1, 3, 2}).asset;
+    EXPECT_EQ(expectedRegion, fromBytes.pixelData);
+    EXPECT_EQ(texture.pixelData, nc::asset::DeserializeTextureRows(bytes, 0, 4).asset.pixelData);
+    EXPECT_TRUE(nc::asset::DeserializeTextureRegion(bytes, nc::asset::TextureRegion{5, 4, 0, 0}).asset.pixelData.empty());
+    EXPECT_THROW(nc::asset::DeserializeTextureRegion(bytes, nc::asset::TextureRegion{3, 0, 3, 1}), nc::NcError);
+    EXPECT_THROW(nc::asset::DeserializeTextureRows(bytes, 3, 2), nc::NcError);
+}
+
+TEST(SerializationTest, Mesh_lz4_roundTrip_succeeds)
+{
+    auto expectedAsset = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 2.0f, 3.0f},
+        .maxExtent = 3.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(1000, nc::asset::MeshVertex{.position = nc::Vector3::Splat(1.0f)}),
+        .indices = std::vector<uint32_t>(3000, 7u),
+        .bonesData = std::nullopt
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, expectedAsset, 1234ull, nc::asset::CompressionAlgorithm::lz4);
+    const auto bytes = ToBytes(stream);
+
+    const auto header = nc::asset::DeserializeHeader(bytes);
+    EXPECT_STREQ("LZ4", header.compressionAlgorithm);
+    EXPECT_EQ(bytes.size() - nc::asset::NcaHeader::binarySize, header.size);
+    EXPECT_LT(header.size, nc::convert::GetBlobSize(expectedAsset) / 10);
+
+    stream.seekg(0);
+    const auto fromStream = nc::asset::DeserializeMesh(stream).asset;
+    EXPECT_EQ(expectedAsset.vertices, fromStream.vertices);
+    EXPECT_EQ(expectedAsset.indices, fromStream.indices);
+    EXPECT_FALSE(fromStream.bonesData.has_value());
+
+    const auto fromBytes = nc::asset::DeserializeMesh(bytes).asset;
+    EXPECT_EQ(expectedAsset.vertices, fromBytes.vertices);
+    EXPECT_EQ(expectedAsset.indices, fromBytes.indices);
+
+    // Views reference blob data in place, so compressed assets cannot be viewed.
+    EXPECT_THROW(nc::asset::DeserializeMeshView(bytes), nc::NcError);
+
+    auto truncated = bytes;
+    truncated.resize(truncated.size() - 1);
+    EXPECT_THROW(nc::asset::DeserializeMesh(truncated), nc::NcError);
+}
+
+TEST(SerializationTest, Texture_lz4_regionAndRows_succeeds)
+{
+    auto texture = nc::asset::Texture{.width = 64, .height = 32, .pixelData = std::vector<unsigned char>(64 * 32 * 4)};
+    for (auto i = size_t{0}; i < texture.pixelData.size(); ++i)
+    {
+        texture.pixelData[i] = static_cast<unsigned char>(i / 256);
+    }
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, texture, 1234ull, nc::asset::CompressionAlgorithm::lz4);
+    nc::convert::Serialize(stream, texture, 5678ull);
+
+    stream.seekg(0);
+    EXPECT_EQ(texture.pixelData, nc::asset::DeserializeTexture(stream).asset.pixelData);
+    EXPECT_EQ(5678ull, nc::asset::DeserializeTexture(stream).header.assetId);
+
+    const auto bytes = ToBytes(stream);
+    const auto rows = nc::asset::DeserializeTextureRows(bytes, 4, 2).asset;
+    EXPECT_TRUE(std::equal(rows.pixelData.cbegin(), rows.pixelData.cend(), texture.pixelData.cbegin() + 4 * 64 * 4));
+    const auto region = nc::asset::DeserializeTextureRegion(bytes, nc::asset::TextureRegion{1, 2, 1, 1}).asset;
+    EXPECT_TRUE(std::equal(region.pixelData.cbegin(), region.pixelData.cend(), texture.pixelData.cbegin() + (2 * 64 + 1) * 4));
+}
+
+TEST(SerializationTest, Mesh_sections_readIndependently)
+{
+    auto mesh = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 2.0f, 3.0f},
+        .maxExtent = 3.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>{
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(1.0f)},
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(2.0f)},
+            nc::asset::MeshVertex{.position = nc::Vector3::Splat(3.0f)}
+        },
+        .indices = std::vector<uint32_t>{0, 1, 2, 2, 1, 0},
+        .bonesData = nc::asset::BonesData{}
+    };
+
+    mesh.bonesData->boneMapping.emplace("Root", 0u);
+    mesh.bonesData->boneSpaceToParentSpace.push_back(nc::asset::BoneSpaceToParentSpace{
+        .boneName = "Root",
+        .transformationMatrix = DirectX::XMMATRIX
+        {
+            1, 0, 0, 0,
+            0, 1, 0, 0,
+            0, 0, 1, 0,
+            0, 0, 0, 1
+        },
+        .numChildren = 0u,
+        .indexOfFirstChild = 0u
+    });
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, mesh, 1234ull);
+    nc::convert::Serialize(stream, mesh, 5678ull, nc::asset::CompressionAlgorithm::lz4);
+    nc::convert::Serialize(stream, mesh, 9012ull);
+
+    // Partial reads leave the stream at the end of the asset, so the next one can follow.
+    stream.seekg(0);
+    const auto withoutBones = nc::asset::DeserializeMeshWithoutBones(stream).asset;
+    EXPECT_EQ(mesh.vertices, withoutBones.vertices);
+    EXPECT_EQ(mesh.indices, withoutBones.indices);
+    EXPECT_FALSE(withoutBones.bonesData.has_value());
+    EXPECT_EQ(mesh.indices, nc::asset::DeserializeMeshIndices(stream).asset);
+    const auto [header, bones] = nc::asset::DeserializeMeshBones(stream);
+    EXPECT_EQ(9012ull, header.assetId);
+    ASSERT_TRUE(bones.has_value());
+    EXPECT_EQ(0u, bones->boneMapping.at("Root"));
+    EXPECT_EQ("Root", bones->boneSpaceToParentSpace.at(0).boneName);
+
+    const auto bytes = ToBytes(stream);
+    EXPECT_EQ(mesh.indices, nc::asset::DeserializeMeshIndices(bytes).asset);
+    EXPECT_TRUE(nc::asset::DeserializeMeshBones(bytes).asset.has_value());
+    EXPECT_FALSE(nc::asset::DeserializeMeshWithoutBones(bytes).asset.bonesData.has_value());
+
+    mesh.bonesData.reset();
+    auto noBones = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(noBones, mesh, 1234ull);
+    EXPECT_FALSE(nc::asset::DeserializeMeshBones(noBones).asset.has_value());
+}
+
+TEST(SerializationTest, Mesh_bytesAfterBones_partialReadsSkipToEnd)
+{
+    auto mesh = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 2.0f, 3.0f},
+        .maxExtent = 3.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(2),
+        .indices = std::vector<uint32_t>{0, 1, 0},
+        .bonesData = nc::asset::BonesData{}
+    };
+
+    mesh.bonesData->boneMapping.emplace("Root", 0u);
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, mesh, 1u);
+
+    // Grow the blob so bytes follow the bones section, as a newer writer might add a section there.
+    constexpr auto extraBytes = size_t{8};
+    auto padded = ToBytes(stream);
+    auto header = nc::asset::NcaHeader{};
+    std::memcpy(&header.size, padded.data() + nc::asset::NcaHeader::binarySize - sizeof(header.size), sizeof(header.size));
+    header.size += extraBytes;
+    std::memcpy(padded.data() + nc::asset::NcaHeader::binarySize - sizeof(header.size), &header.size, sizeof(header.size));
+    const auto tableOffset = nc::asset::NcaHeader::binarySize + nc::asset::MeshSectionTable::blobOffset;
+    auto sections = nc::asset::MeshSectionTable{};
+    std::memcpy(&sections, padded.data() + tableOffset, sizeof(sections));
+    sections.end += extraBytes;
+    std::memcpy(padded.data() + tableOffset, &sections, sizeof(sections));
+    padded.resize(padded.size() + extraBytes, std::byte{0xFF});
+
+    auto next = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(next, mesh, 2u);
+    const auto nextBytes = ToBytes(next);
+
+    auto combined = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    for (auto i = 0; i < 2; ++i)
+    {
+        combined.write(reinterpret_cast<const char*>(padded.data()), static_cast<std::streamsize>(padded.size()));
+    }
+
+    combined.write(reinterpret_cast<const char*>(nextBytes.data()), static_cast<std::streamsize>(nextBytes.size()));
+    combined.seekg(0);
+    EXPECT_TRUE(nc::asset::DeserializeMeshBones(combined).asset.has_value());
+    EXPECT_TRUE(nc::asset::DeserializeMesh(combined).asset.bonesData.has_value());
+    EXPECT_EQ(2u, nc::asset::DeserializeMeshIndices(combined).header.assetId);
+}
+
+TEST(SerializationTest, Mesh_invalidSectionTable_throws)
+{
+    const auto mesh = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 2.0f, 3.0f},
+        .maxExtent = 3.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(2),
+        .indices = std::vector<uint32_t>{0, 1, 0},
+        .bonesData = std::nullopt
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, mesh, 1234ull);
+    const auto bytes = ToBytes(stream);
+    const auto tableOffset = nc::asset::NcaHeader::binarySize + nc::asset::MeshSectionTable::blobOffset;
+
+    // Indices placed before the end of the vertex section.
+    auto overlapping = bytes;
+    auto sections = nc::asset::MeshSectionTable{};
+    std::memcpy(&sections, overlapping.data() + tableOffset, sizeof(sections));
+    sections.indices -= 1;
+    std::memcpy(overlapping.data() + tableOffset, &sections, sizeof(sections));
+    EXPECT_THROW(nc::asset::DeserializeMesh(overlapping), nc::NcError);
+    EXPECT_THROW(nc::asset::DeserializeMeshView(overlapping), nc::NcError);
+
+    // Sections out of order.
+    auto unordered = bytes;
+    sections.indices = sections.bones + 1;
+    std::memcpy(unordered.data() + tableOffset, &sections, sizeof(sections));
+    EXPECT_THROW(nc::asset::DeserializeMeshIndices(unordered), nc::NcError);
+
+    // Section past the end of the blob.
+    auto pastEnd = bytes;
+    sections = nc::asset::MeshSectionTable{};
+    sections.indices = sections.bones = sections.end = bytes.size();
+    std::memcpy(pastEnd.data() + tableOffset, &sections, sizeof(sections));
+    EXPECT_THROW(nc::asset::DeserializeMeshIndices(pastEnd), nc::NcError);
+}
+
+TEST(SerializationTest, Mesh_vertices_convertIntoLayout)
+{
+    auto mesh = nc::asset::Mesh{
+        .extents = nc::Vector3{1.0f, 1.0f, 1.0f},
+        .maxExtent = 1.0f,
+        .vertices = std::vector<nc::asset::MeshVertex>(600),
+        .indices = std::vector<uint32_t>{0, 1, 2},
+        .bonesData = std::nullopt
+    };
+
+    for (auto i = size_t{0}; i < mesh.vertices.size(); ++i)
+    {
+        const auto value = static_cast<float>(i);
+        mesh.vertices[i].position = nc::Vector3{value, -value, value * 0.5f};
+        mesh.vertices[i].uv = nc::Vector2{value / 600.0f, 1.0f - value / 600.0f};
+        mesh.vertices[i].boneIds = {static_cast<uint32_t>(i), 0u, 0u, 0u};
+    }
+
+    const auto layout = nc::asset::MakeSplitLayout({
+        {nc::asset::VertexAttribute::Position, nc::asset::VertexFormat::Float32x3},
+        {nc::asset::VertexAttribute::Uv, nc::asset::VertexFormat::Float16x2},
+        {nc::asset::VertexAttribute::BoneIds, nc::asset::VertexFormat::Uint16x4}
+    });
+
+    auto expected = std::vector<std::vector<std::byte>>{};
+    for (auto i = size_t{0}; i < layout.strides.size(); ++i)
+    {
+        expected.emplace_back(nc::asset::GetVertexStreamSize(layout, i, mesh.vertices.size()));
+    }
+
+    const auto expectedStreams = std::vector<std::span<std::byte>>{expected[0], expected[1], expected[2]};
+    nc::asset::ConvertVertices(mesh.vertices, layout, expectedStreams);
+
+    auto actual = std::vector<std::vector<std::byte>>(layout.strides.size());
+    const auto allocate = [&actual](size_t stream, size_t size)
+    {
+        actual.at(stream).assign(size, std::byte{0xFF});
+        return std::span<std::byte>{actual[stream]};
+    };
+
+    for (const auto compression : {nc::asset::CompressionAlgorithm::none, nc::asset::CompressionAlgorithm::lz4})
+    {
+        auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+        nc::convert::Serialize(stream, mesh, 1u, compression);
+        nc::convert::Serialize(stream, mesh, 2u);
+
+        stream.seekg(0);
+        EXPECT_EQ(mesh.vertices.size(), nc::asset::DeserializeMeshVertices(stream, layout, allocate).asset);
+        EXPECT_EQ(expected, actual);
+
+        // The stream is left at the end of the blob.
+        EXPECT_EQ(2u, nc::asset::DeserializeMeshIndices(stream).header.assetId);
+
+        const auto bytes = ToBytes(stream);
+        EXPECT_EQ(mesh.vertices.size(), nc::asset::DeserializeMeshVertices(bytes, layout, allocate).asset);
+        EXPECT_EQ(expected, actual);
+
+        // Misaligned data is copied a block at a time instead of being converted in place.
+        auto shifted = std::vector<std::byte>(bytes.size() + 1);
+        std::memcpy(shifted.data() + 1, bytes.data(), bytes.size());
+        EXPECT_EQ(mesh.vertices.size(), nc::asset::DeserializeMeshVertices(std::span{shifted}.subspan(1), layout, allocate).asset);
+        EXPECT_EQ(expected, actual);
+    }
+
+    const auto tooSmall = [](size_t, size_t size)
+    {
+        static auto buffer = std::vector<std::byte>{};
+        buffer.resize(size - 1);
+        return std::span<std::byte>{buffer};
+    };
+
+    auto stream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(stream, mesh, 1u);
+    EXPECT_THROW(nc::asset::DeserializeMeshVertices(stream, layout, tooSmall), nc::NcError);
+}
+
+TEST(SerializationTest, Any_dispatchesOnMagicNumber)
+{
+    const auto texture = nc::asset::Texture{
+        .width = 1, .height = 1,
+        .pixelData = std::vector<unsigned char>{0xA1, 0xA2, 0xA3, 0xA4}
+    };
+
+    const auto animation = nc::asset::SkeletalAnimation{
+        .name = "Test",
+        .durationInTicks = 128,
+        .ticksPerSecond = 64,
+        .framesPerBone = {}
+    };
+
+    auto textureStream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(textureStream, texture, 1ull, nc::asset::CompressionAlgorithm::lz4);
+    const auto textureBytes = ToBytes(textureStream);
+
+    auto animationStream = std::stringstream{std::ios::in | std::ios::out | std::ios::binary};
+    nc::convert::Serialize(animationStream, animation, 2ull);
+    const auto animationBytes = ToBytes(animationStream);
+
+    textureStream.seekg(0);
+    const auto [textureHeader, textureAsset] = nc::asset::DeserializeAny(textureStream);
+    EXPECT_EQ(1ull, textureHeader.assetId);
+    ASSERT_TRUE(std::holds_alternative<nc::asset::Texture>(textureAsset));
+    EXPECT_EQ(texture.pixelData, std::get<nc::asset::Texture>(textureAsset).pixelData);
+    EXPECT_EQ(texture.pixelData, std::get<nc::asset::Texture>(nc::asset::DeserializeAny(textureBytes).asset).pixelData);
+
+    animationStream.seekg(0);
+    const auto [animationHeader, animationAsset] = nc::asset::DeserializeAny(animationStream);
+    EXPECT_STREQ("SKEL", animationHeader.magicNumber);
+    ASSERT_TRUE(std::holds_alternative<nc::asset::SkeletalAnimation>(animationAsset));
+    EXPECT_EQ(animation.name, std::get<nc::asset::SkeletalAnimation>(animationAsset).name);
+    EXPECT_EQ(animation.durationInTicks, std::get<nc::asset::SkeletalAnimation>(nc::asset::DeserializeAny(animationBytes).asset).durationInTicks);
+
+    auto shader = animationBytes;
+    std::memcpy(shader.data(), nc::asset::MagicNumber::shader.data(), 4);
+    EXPECT_THROW(nc::asset::DeserializeAny(shader), nc::NcError);
+
+    auto unknown = animationBytes;
+    std::memcpy(unknown.data(), "ABCD", 4);
+    EXPECT_THROW(nc::asset::DeserializeAny(unknown), nc::NcError);
+
+    auto truncated = animationBytes;
+    truncated.pop_back();
+    EXPECT_THROW(nc::asset::DeserializeAny(truncated), nc::NcError);
+}
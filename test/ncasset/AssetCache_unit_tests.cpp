@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include "TestAssets.h"
+#include "ncasset/AssetCache.h"
+#include "ncasset/Assets.h"
+#include "ncutility/NcError.h"
+
+#include <thread>
+
+namespace
+{
+const auto packagePath = std::filesystem::path{"./AssetCache_unit_tests.ncp"};
+
+auto NcaPath(size_t assetId) -> std::filesystem::path
+{
+    return std::filesystem::path{"./AssetCache_unit_tests_" + std::to_string(assetId) + ".nca"};
+}
+
+auto MakeSquareTexture(uint32_t width, size_t assetId) -> nc::asset::Texture
+{
+    return nc::asset::Texture{
+        .width = width,
+        .height = width,
+        .pixelData = std::vector<unsigned char>(width * width * 4, static_cast<unsigned char>(assetId))
+    };
+}
+
+/** Write a square texture to an .nca file, returning its blob size. */
+auto WriteNca(size_t assetId, uint32_t width = 16) -> size_t
+{
+    const auto nca = SerializeNca(MakeSquareTexture(width, assetId), assetId);
+    WriteFile(NcaPath(assetId), nca);
+    return nca.size() - nc::asset::NcaHeader::binarySize;
+}
+} // anonymous namespace
+
+TEST(AssetCacheTest, Get_repeatedRequest_returnsCachedHandle)
+{
+    const auto blobSize = WriteNca(1u);
+    auto cache = nc::asset::AssetCache{1024 * 1024};
+    const auto first = cache.Get<nc::asset::Texture>(NcaPath(1u));
+    const auto second = cache.Get<nc::asset::Texture>(NcaPath(1u));
+
+    EXPECT_EQ(first.get(), second.get());
+    EXPECT_EQ(16u, first->width);
+    EXPECT_TRUE(cache.Contains(1u));
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.hits);
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(0u, stats.evictions);
+    EXPECT_EQ(blobSize, stats.bytes);
+    EXPECT_EQ(1u, stats.entries);
+
+    std::filesystem::remove(NcaPath(1u));
+}
+
+TEST(AssetCacheTest, Get_overBudget_evictsLeastRecentlyUsed)
+{
+    const auto blobSize = WriteNca(1u);
+    WriteNca(2u);
+    WriteNca(3u);
+
+    auto cache = nc::asset::AssetCache{blobSize * 2};
+    cache.Get<nc::asset::Texture>(NcaPath(1u));
+    const auto evicted = cache.Get<nc::asset::Texture>(NcaPath(2u));
+    cache.Get<nc::asset::Texture>(NcaPath(1u));
+    cache.Get<nc::asset::Texture>(NcaPath(3u));
+
+    EXPECT_TRUE(cache.Contains(1u));
+    EXPECT_FALSE(cache.Contains(2u));
+    EXPECT_TRUE(cache.Contains(3u));
+    EXPECT_EQ(2u, evicted->pixelData[0]);
+
+    auto stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.evictions);
+    EXPECT_EQ(blobSize * 2, stats.bytes);
+
+    cache.SetByteBudget(blobSize);
+    EXPECT_FALSE(cache.Contains(1u));
+    EXPECT_TRUE(cache.Contains(3u));
+    EXPECT_TRUE(cache.Erase(3u));
+    EXPECT_FALSE(cache.Erase(3u));
+
+    stats = cache.GetStats();
+    EXPECT_EQ(2u, stats.evictions);
+    EXPECT_EQ(0u, stats.bytes);
+    EXPECT_EQ(0u, stats.entries);
+
+    for (auto id : {1u, 2u, 3u})
+    {
+        std::filesystem::remove(NcaPath(id));
+    }
+}
+
+TEST(AssetCacheTest, Get_concurrentRequests_loadOnce)
+{
+    const auto nca = SerializeNca(MakeSquareTexture(512, 7u), 7u);
+    WritePackage(packagePath, {{7u, nca}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+    auto cache = nc::asset::AssetCache{nca.size()};
+
+    auto handles = std::vector<nc::asset::AssetHandle<nc::asset::Texture>>(8);
+    auto threads = std::vector<std::thread>{};
+    for (auto& handle : handles)
+    {
+        threads.emplace_back([&]() { handle = cache.Get<nc::asset::Texture>(package, 7u); });
+    }
+
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    for (const auto& handle : handles)
+    {
+        EXPECT_EQ(handles[0].get(), handle.get());
+    }
+
+    const auto stats = cache.GetStats();
+    EXPECT_EQ(1u, stats.misses);
+    EXPECT_EQ(7u, stats.hits);
+
+    std::filesystem::remove(packagePath);
+}
+
+TEST(AssetCacheTest, Get_failedOrOversizedLoad_isNotCached)
+{
+    const auto blobSize = WriteNca(1u);
+    auto cache = nc::asset::AssetCache{blobSize - 1};
+    EXPECT_THROW(cache.Get<nc::asset::Texture>(NcaPath(2u)), nc::NcError);
+    EXPECT_THROW(cache.Get<nc::asset::Mesh>(NcaPath(1u)), nc::NcError);
+    EXPECT_FALSE(cache.Contains(1u));
+
+    const auto texture = cache.Get<nc::asset::Texture>(NcaPath(1u));
+    EXPECT_EQ(16u, texture->height);
+    EXPECT_FALSE(cache.Contains(1u));
+    EXPECT_EQ(1u, cache.GetStats().evictions);
+
+    cache.SetByteBudget(blobSize);
+    cache.Get<nc::asset::Texture>(NcaPath(1u));
+    EXPECT_THROW(cache.Get<nc::asset::Mesh>(NcaPath(1u)), nc::NcError);
+
+    std::filesystem::remove(NcaPath(1u));
+}
@@ -0,0 +1,105 @@
+#include "gtest/gtest.h"
+#include "TestAssets.h"
+#include "ncasset/AssetIndex.h"
+#include "ncasset/ThreadPool.h"
+#include "ncutility/NcError.h"
+
+#include <fstream>
+
+namespace
+{
+const auto rootDir = std::filesystem::path{"./AssetIndex_unit_tests"};
+const auto indexPath = std::filesystem::path{"./AssetIndex_unit_tests.ncix"};
+
+void WriteNca(const std::filesystem::path& relativePath, size_t assetId, size_t blobSize)
+{
+    const auto path = rootDir / relativePath;
+    std::filesystem::create_directories(path.parent_path());
+    WriteFile(path, SerializeFillerNca(assetId, blobSize));
+}
+} // anonymous namespace
+
+class AssetIndexTest : public ::testing::Test
+{
+    public:
+        AssetIndexTest()
+        {
+            WriteNca("a.nca", 1u, 4u);
+            WriteNca("sub/b.nca", 2u, 8u);
+            WriteNca("sub/deeper/c.nca", 3u, 16u);
+
+            auto ignored = std::ofstream{rootDir / "sub/notes.txt"};
+            ignored << "not an asset";
+        }
+
+        ~AssetIndexTest()
+        {
+            std::filesystem::remove_all(rootDir);
+            std::filesystem::remove(indexPath);
+        }
+
+        nc::asset::ThreadPool pool{2};
+};
+
+TEST_F(AssetIndexTest, Refresh_readsAllNcaHeaders)
+{
+    auto index = nc::asset::AssetIndex{rootDir};
+    EXPECT_EQ(3u, index.Refresh(pool));
+    ASSERT_EQ(3u, index.GetEntries().size());
+
+    const auto* entry = index.Find(2u);
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(std::filesystem::path{"sub/b.nca"}, entry->path);
+    EXPECT_EQ(8u, entry->header.size);
+    EXPECT_EQ(nc::asset::NcaHeader::binarySize + 8u, entry->fileSize);
+    EXPECT_EQ(rootDir / "sub/deeper/c.nca", index.GetPath(3u));
+    EXPECT_EQ(nullptr, index.Find(4u));
+    EXPECT_THROW(index.GetPath(4u), nc::NcError);
+}
+
+TEST_F(AssetIndexTest, Load_savedIndex_skipsUnchangedFiles)
+{
+    {
+        auto index = nc::asset::AssetIndex{rootDir};
+        index.Refresh(pool);
+        index.Save(indexPath);
+    }
+
+    auto index = nc::asset::AssetIndex{rootDir};
+    ASSERT_TRUE(index.Load(indexPath));
+    EXPECT_EQ(3u, index.GetEntries().size());
+    EXPECT_EQ(0u, index.Refresh(pool));
+    EXPECT_EQ(3u, index.GetEntries().size());
+}
+
+TEST_F(AssetIndexTest, Refresh_modifiedAndRemovedFiles_updatesEntries)
+{
+    auto index = nc::asset::AssetIndex{rootDir};
+    index.Refresh(pool);
+
+    WriteNca("a.nca", 10u, 32u);
+    std::filesystem::remove(rootDir / "sub/b.nca");
+    WriteNca("d.nca", 4u, 4u);
+
+    EXPECT_EQ(2u, index.Refresh(pool));
+    EXPECT_EQ(3u, index.GetEntries().size());
+    EXPECT_EQ(nullptr, index.Find(1u));
+    EXPECT_EQ(nullptr, index.Find(2u));
+    ASSERT_NE(nullptr, index.Find(10u));
+    EXPECT_EQ(32u, index.Find(10u)->header.size);
+    EXPECT_NE(nullptr, index.Find(4u));
+}
+
+TEST_F(AssetIndexTest, Load_invalidFile_returnsFalse)
+{
+    auto index = nc::asset::AssetIndex{rootDir};
+    EXPECT_FALSE(index.Load(indexPath));
+
+    {
+        auto file = std::ofstream{indexPath, std::ios::binary};
+        file << "garbage";
+    }
+
+    EXPECT_FALSE(index.Load(indexPath));
+    EXPECT_TRUE(index.GetEntries().empty());
+}
@@ -0,0 +1,234 @@
+#include "gtest/gtest.h"
+#include "TestAssets.h"
+#include "ncasset/AssetPackage.h"
+#include "ncasset/Import.h"
+#include "ncasset/LoadTrace.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <random>
+
+namespace
+{
+const auto packagePath = std::filesystem::path{"./AssetPackage_unit_tests.ncp"};
+} // anonymous namespace
+
+class AssetPackageTest : public ::testing::Test
+{
+    public:
+        ~AssetPackageTest()
+        {
+            std::filesystem::remove(packagePath);
+        }
+};
+
+TEST_F(AssetPackageTest, Construct_loadsLookUpTable)
+{
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+    EXPECT_EQ(2u, package.GetHeader().assetCount);
+    EXPECT_EQ(2u, package.GetEntries().size());
+    EXPECT_TRUE(package.Contains(10u));
+    EXPECT_TRUE(package.Contains(20u));
+    EXPECT_FALSE(package.Contains(30u));
+    EXPECT_THROW(package.GetEntry(30u), nc::NcError);
+}
+
+TEST_F(AssetPackageTest, Construct_manyEntries_findsEveryId)
+{
+    auto assets = std::vector<std::pair<size_t, nc::asset::Texture>>{};
+    auto rng = std::mt19937_64{7u};
+    for (auto i = 0; i < 5000; ++i)
+    {
+        assets.emplace_back(rng(), MakeTexture(static_cast<unsigned char>(i)));
+    }
+
+    WritePackage(packagePath, assets);
+    const auto package = nc::asset::AssetPackage{packagePath};
+    for (const auto& [id, texture] : assets)
+    {
+        ASSERT_EQ(id, package.GetEntry(id).assetId);
+    }
+
+    EXPECT_EQ(assets[1234].second.pixelData, nc::asset::ImportTexture(package, assets[1234].first).pixelData);
+    for (auto i = 0; i < 1000; ++i)
+    {
+        EXPECT_FALSE(package.Contains(rng()));
+    }
+}
+
+TEST(LutHashTest, BuildLutHash_placesEntriesInSlots)
+{
+    auto entries = std::vector<nc::asset::LutEntry>{};
+    for (auto id = size_t{1}; id <= 101; ++id)
+    {
+        entries.push_back(nc::asset::LutEntry{id * 31, id, 0});
+    }
+
+    const auto seeds = nc::asset::BuildLutHash(entries);
+    EXPECT_EQ(nc::asset::GetLutBucketCount(entries.size()), seeds.size());
+    for (auto i = size_t{0}; i < entries.size(); ++i)
+    {
+        EXPECT_EQ(i, nc::asset::GetLutSlot(entries[i].assetId, seeds, entries.size()));
+        EXPECT_EQ(entries[i].assetId, entries[i].offset * 31);
+    }
+
+    entries.push_back(entries.front());
+    EXPECT_THROW(nc::asset::BuildLutHash(entries), nc::NcError);
+
+    auto empty = std::vector<nc::asset::LutEntry>{};
+    EXPECT_TRUE(nc::asset::BuildLutHash(empty).empty());
+}
+
+TEST_F(AssetPackageTest, ImportById_readsCorrectAsset)
+{
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+
+    const auto second = nc::asset::ImportTexture(package, 20u);
+    const auto first = nc::asset::ImportTexture(package, 10u);
+    EXPECT_EQ(MakeTexture(1).pixelData, first.pixelData);
+    EXPECT_EQ(MakeTexture(2).pixelData, second.pixelData);
+    EXPECT_EQ(20u, nc::asset::ImportNcaHeader(package, 20u).assetId);
+    EXPECT_THROW(nc::asset::ImportMesh(package, 10u), nc::NcError);
+}
+
+TEST_F(AssetPackageTest, ValidateHeader_otherAssetId_throws)
+{
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+    auto header = nc::asset::NcaHeader{};
+    header.assetId = 10u;
+
+    EXPECT_NO_THROW(package.ValidateHeader(10u, header));
+    EXPECT_THROW(package.ValidateHeader(20u, header), nc::NcError);
+    header.assetId = 30u;
+    EXPECT_THROW(package.ValidateHeader(10u, header), nc::NcError);
+}
+
+TEST_F(AssetPackageTest, ImportView_usesLookUpTableOffset)
+{
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+    const auto mapped = nc::asset::MappedFile{packagePath};
+
+    const auto view = nc::asset::ImportTextureView(mapped, package.GetEntry(20u).offset);
+    ASSERT_EQ(4u, view.pixelData.size());
+    EXPECT_EQ(2u, view.pixelData[0]);
+}
+
+TEST_F(AssetPackageTest, Construct_invalidMagicNumber_throws)
+{
+    {
+        auto file = std::ofstream{packagePath, std::ios::binary};
+        file << "NOPE00.01.00" << std::string(8, '\0');
+    }
+
+    EXPECT_THROW(nc::asset::AssetPackage{packagePath}, nc::NcError);
+}
+
+TEST_F(AssetPackageTest, Construct_entryOutsideHashSlot_throws)
+{
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}});
+    {
+        // Swap the two entries so neither is in the slot its id hashes to.
+        auto file = std::fstream{packagePath, std::ios::binary | std::ios::in | std::ios::out};
+        auto entries = std::array<char, 2 * nc::asset::LutEntry::binarySize>{};
+        file.seekg(nc::asset::NcpHeader::binarySize);
+        file.read(entries.data(), entries.size());
+        std::rotate(entries.begin(), entries.begin() + nc::asset::LutEntry::binarySize, entries.end());
+        file.seekp(nc::asset::NcpHeader::binarySize);
+        file.write(entries.data(), entries.size());
+    }
+
+    EXPECT_THROW(nc::asset::AssetPackage{packagePath}, nc::NcError);
+}
+
+TEST_F(AssetPackageTest, Construct_truncatedLookUpTable_throws)
+{
+    {
+        auto header = nc::asset::NcpHeader{};
+        header.assetCount = 3;
+        auto file = std::ofstream{packagePath, std::ios::binary};
+        nc::asset::Serialize(file, header);
+        nc::asset::Serialize(file, nc::asset::LutEntry{});
+    }
+
+    EXPECT_THROW(nc::asset::AssetPackage{packagePath}, nc::NcError);
+}
+
+TEST_F(AssetPackageTest, ImportIntoExisting_reusesObject)
+{
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+
+    auto texture = nc::asset::Texture{};
+    nc::asset::ImportTexture(package, 10u, texture);
+    EXPECT_EQ(MakeTexture(1).pixelData, texture.pixelData);
+
+    const auto* buffer = texture.pixelData.data();
+    nc::asset::ImportTexture(package, 20u, texture);
+    EXPECT_EQ(MakeTexture(2).pixelData, texture.pixelData);
+    EXPECT_EQ(buffer, texture.pixelData.data());
+    auto mesh = nc::asset::Mesh{};
+    EXPECT_THROW(nc::asset::ImportMesh(package, 10u, mesh), nc::NcError);
+}
+
+TEST_F(AssetPackageTest, ImportTextureRegion_readsFromPackageEntry)
+{
+    auto wide = nc::asset::Texture{.width = 3, .height = 2, .pixelData = std::vector<unsigned char>(24)};
+    for (auto i = size_t{0}; i < wide.pixelData.size(); ++i)
+    {
+        wide.pixelData[i] = static_cast<unsigned char>(i);
+    }
+
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, wide}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+
+    const auto region = nc::asset::ImportTextureRegion(package, 20u, nc::asset::TextureRegion{2, 0, 1, 2});
+    EXPECT_EQ((std::vector<unsigned char>{8, 9, 10, 11, 20, 21, 22, 23}), region.pixelData);
+
+    const auto rows = nc::asset::ImportTextureRows(package, 20u, 1, 1);
+    EXPECT_EQ(3u, rows.width);
+    EXPECT_TRUE(std::equal(rows.pixelData.cbegin(), rows.pixelData.cend(), wide.pixelData.cbegin() + 12));
+
+    EXPECT_EQ(MakeTexture(1).pixelData, nc::asset::ImportTexture(package, 10u).pixelData);
+    EXPECT_THROW(nc::asset::ImportTextureRows(package, 10u, 1, 1), nc::NcError);
+}
+
+TEST_F(AssetPackageTest, LoadTrace_recordsFirstLookupOrder)
+{
+    WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}, {30u, MakeTexture(3)}});
+    const auto package = nc::asset::AssetPackage{packagePath};
+    nc::asset::ImportTexture(package, 10u);
+
+    nc::asset::BeginLoadTrace();
+    nc::asset::ImportTexture(package, 30u);
+    nc::asset::ImportTexture(package, 10u);
+    nc::asset::ImportTexture(package, 30u);
+    EXPECT_THROW(package.GetEntry(40u), nc::NcError);
+    const auto trace = nc::asset::EndLoadTrace();
+    nc::asset::ImportTexture(package, 20u);
+
+    EXPECT_EQ((std::vector<size_t>{30u, 10u}), trace);
+    EXPECT_TRUE(nc::asset::EndLoadTrace().empty());
+}
+
+TEST(LoadTraceTest, WriteLoadTrace_roundTrips)
+{
+    const auto tracePath = std::filesystem::path{"./LoadTrace_unit_tests.trace"};
+    const auto ids = std::vector<size_t>{18446744073709551615u, 0u, 42u};
+    nc::asset::WriteLoadTrace(tracePath, ids);
+    EXPECT_EQ(ids, nc::asset::ReadLoadTrace(tracePath));
+
+    {
+        auto file = std::ofstream{tracePath, std::ios::trunc};
+        file << "42\nnot-an-id\n";
+    }
+
+    EXPECT_THROW(nc::asset::ReadLoadTrace(tracePath), nc::NcError);
+    std::filesystem::remove(tracePath);
+    EXPECT_THROW(nc::asset::ReadLoadTrace(tracePath), nc::NcError);
+}
@@ -0,0 +1,162 @@
+#include "gtest/gtest.h"
+#include "TestAssets.h"
+#include "ncasset/AssetWatcher.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <tuple>
+
+namespace
+{
+const auto watchDirectory = std::filesystem::path{"./AssetWatcher_unit_tests"};
+const auto movedDirectory = std::filesystem::path{"./AssetWatcher_unit_tests_moved"};
+const auto packagePath = watchDirectory / "package.ncp";
+
+/** Write the package with a filler nca for each (asset id, last updated) entry. */
+void WriteWatchedPackage(const std::vector<std::pair<size_t, int64_t>>& assets)
+{
+    auto entries = std::vector<TestPackageEntry>{};
+    for (const auto& [id, lastUpdated] : assets)
+    {
+        entries.push_back(TestPackageEntry{id, SerializeFillerNca(id, 8), lastUpdated});
+    }
+
+    WritePackage(packagePath, entries);
+}
+
+auto Poll(nc::asset::AssetWatcher& watcher) -> std::vector<std::tuple<size_t, nc::asset::AssetChangeType, std::string>>
+{
+    auto changes = std::vector<std::tuple<size_t, nc::asset::AssetChangeType, std::string>>{};
+    const auto count = watcher.Poll([&changes](const nc::asset::AssetChange& change)
+    {
+        changes.emplace_back(change.assetId, change.type, change.path.filename().string());
+    });
+
+    EXPECT_EQ(changes.size(), count);
+    std::sort(changes.begin(), changes.end());
+    return changes;
+}
+} // anonymous namespace
+
+class AssetWatcherTest : public ::testing::TestWithParam<nc::asset::AssetWatchMode>
+{
+    public:
+        AssetWatcherTest()
+        {
+            std::filesystem::remove_all(watchDirectory);
+            std::filesystem::create_directories(watchDirectory);
+        }
+
+        ~AssetWatcherTest()
+        {
+            std::filesystem::remove_all(watchDirectory);
+            std::filesystem::remove_all(movedDirectory);
+        }
+
+        auto MakeWatcher() -> nc::asset::AssetWatcher
+        {
+            return nc::asset::AssetWatcher{GetParam(), std::chrono::milliseconds{0}};
+        }
+};
+
+TEST_P(AssetWatcherTest, Poll_ncaFiles_reportsChangesById)
+{
+    using enum nc::asset::AssetChangeType;
+    WriteFile(watchDirectory / "existing.nca", SerializeFillerNca(1u, 4));
+    auto watcher = MakeWatcher();
+    watcher.WatchDirectory(watchDirectory);
+    EXPECT_TRUE(Poll(watcher).empty());
+
+    WriteFile(watchDirectory / "new.nca", SerializeFillerNca(2u, 4));
+    WriteFile(watchDirectory / "existing.nca", SerializeFillerNca(1u, 16));
+    WriteFile(watchDirectory / "ignored.txt", "not an asset");
+    using Changes = decltype(Poll(watcher));
+    EXPECT_EQ((Changes{{1u, Modified, "existing.nca"}, {2u, Added, "new.nca"}}), Poll(watcher));
+    EXPECT_TRUE(Poll(watcher).empty());
+
+    // Files are only reported once their size matches their header.
+    auto partial = SerializeFillerNca(3u, 32);
+    WriteFile(watchDirectory / "partial.nca", partial.substr(0, 30));
+    EXPECT_TRUE(Poll(watcher).empty());
+    WriteFile(watchDirectory / "partial.nca", partial);
+    EXPECT_EQ((Changes{{3u, Added, "partial.nca"}}), Poll(watcher));
+
+    std::filesystem::remove(watchDirectory / "new.nca");
+    WriteFile(watchDirectory / "existing.nca", SerializeFillerNca(4u, 4));
+    EXPECT_EQ((Changes{{1u, Removed, "existing.nca"}, {2u, Removed, "new.nca"}, {4u, Added, "existing.nca"}}), Poll(watcher));
+}
+
+TEST_P(AssetWatcherTest, Poll_package_reportsChangedEntries)
+{
+    using enum nc::asset::AssetChangeType;
+    using Changes = decltype(Poll(std::declval<nc::asset::AssetWatcher&>()));
+    auto watcher = MakeWatcher();
+    watcher.WatchPackage(packagePath);
+    EXPECT_TRUE(Poll(watcher).empty());
+
+    WriteWatchedPackage({{1u, 100}, {2u, 100}});
+    EXPECT_EQ((Changes{{1u, Added, "package.ncp"}, {2u, Added, "package.ncp"}}), Poll(watcher));
+
+    WriteWatchedPackage({{1u, 100}, {2u, 200}, {3u, 200}});
+    EXPECT_EQ((Changes{{2u, Modified, "package.ncp"}, {3u, Added, "package.ncp"}}), Poll(watcher));
+
+    WriteWatchedPackage({{3u, 200}});
+    EXPECT_EQ((Changes{{1u, Removed, "package.ncp"}, {2u, Removed, "package.ncp"}}), Poll(watcher));
+
+    std::filesystem::remove(packagePath);
+    EXPECT_EQ((Changes{{3u, Removed, "package.ncp"}}), Poll(watcher));
+}
+
+TEST_P(AssetWatcherTest, Poll_recreatedDirectory_reportsNewFiles)
+{
+    using enum nc::asset::AssetChangeType;
+    using Changes = decltype(Poll(std::declval<nc::asset::AssetWatcher&>()));
+    WriteFile(watchDirectory / "existing.nca", SerializeFillerNca(1u, 4));
+    auto watcher = MakeWatcher();
+    watcher.WatchDirectory(watchDirectory);
+
+    std::filesystem::remove_all(watchDirectory);
+    EXPECT_EQ((Changes{{1u, Removed, "existing.nca"}}), Poll(watcher));
+
+    std::filesystem::create_directories(watchDirectory);
+    WriteFile(watchDirectory / "new.nca", SerializeFillerNca(2u, 4));
+    EXPECT_EQ((Changes{{2u, Added, "new.nca"}}), Poll(watcher));
+
+    WriteFile(watchDirectory / "later.nca", SerializeFillerNca(3u, 4));
+    EXPECT_EQ((Changes{{3u, Added, "later.nca"}}), Poll(watcher));
+}
+
+TEST_P(AssetWatcherTest, Poll_movedDirectory_watchesReplacement)
+{
+    using enum nc::asset::AssetChangeType;
+    using Changes = decltype(Poll(std::declval<nc::asset::AssetWatcher&>()));
+    WriteFile(watchDirectory / "existing.nca", SerializeFillerNca(1u, 4));
+    auto watcher = MakeWatcher();
+    watcher.WatchDirectory(watchDirectory);
+
+    // Files written to the moved directory are not reported under the watched path.
+    std::filesystem::rename(watchDirectory, movedDirectory);
+    std::filesystem::create_directories(watchDirectory);
+    WriteFile(movedDirectory / "moved.nca", SerializeFillerNca(2u, 4));
+    WriteFile(watchDirectory / "new.nca", SerializeFillerNca(3u, 4));
+    EXPECT_EQ((Changes{{1u, Removed, "existing.nca"}, {3u, Added, "new.nca"}}), Poll(watcher));
+
+    WriteFile(movedDirectory / "later.nca", SerializeFillerNca(4u, 4));
+    WriteFile(watchDirectory / "later.nca", SerializeFillerNca(5u, 4));
+    EXPECT_EQ((Changes{{5u, Added, "later.nca"}}), Poll(watcher));
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes, AssetWatcherTest, ::testing::Values(nc::asset::AssetWatchMode::Automatic, nc::asset::AssetWatchMode::Polling));
+
+TEST(AssetWatcherModeTest, Poll_withinInterval_doesNotScan)
+{
+    std::filesystem::create_directories(watchDirectory);
+    auto watcher = nc::asset::AssetWatcher{nc::asset::AssetWatchMode::Polling, std::chrono::hours{1}};
+    EXPECT_FALSE(watcher.IsUsingInotify());
+    watcher.WatchDirectory(watchDirectory);
+    WriteFile(watchDirectory / "asset.nca", SerializeFillerNca(1u, 4));
+    EXPECT_EQ(0u, watcher.Poll([](const nc::asset::AssetChange&) {}));
+
+    EXPECT_THROW(watcher.WatchDirectory(watchDirectory / "missing"), nc::NcError);
+    std::filesystem::remove_all(watchDirectory);
+}
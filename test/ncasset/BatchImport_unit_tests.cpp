@@ -0,0 +1,171 @@
+#include "gtest/gtest.h"
+#include "TestAssets.h"
+#include "ncasset/AssetPackage.h"
+#include "ncasset/BatchImport.h"
+#include "ncasset/BulkReader.h"
+#include "ncasset/Import.h"
+#include "ncasset/ThreadPool.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <atomic>
+#include <latch>
+#include <mutex>
+
+namespace
+{
+const auto packagePath = std::filesystem::path{"./BatchImport_unit_tests.ncp"};
+const auto ncaPath = std::filesystem::path{"./BatchImport_unit_tests.nca"};
+} // anonymous namespace
+
+class BatchImportTest : public ::testing::Test
+{
+    public:
+        BatchImportTest()
+        {
+            WritePackage(packagePath, {{10u, MakeTexture(1)}, {20u, MakeTexture(2)}, {30u, MakeTexture(3)}});
+            WriteFile(ncaPath, SerializeNca(MakeTexture(4), 40u));
+        }
+
+        ~BatchImportTest()
+        {
+            std::filesystem::remove(packagePath);
+            std::filesystem::remove(ncaPath);
+        }
+};
+
+TEST(ThreadPoolTest, Destructor_runsAllSubmittedJobs)
+{
+    auto count = std::atomic<int>{0};
+    {
+        auto pool = nc::asset::ThreadPool{3};
+        EXPECT_EQ(3u, pool.GetThreadCount());
+        for (auto i = 0; i < 100; ++i)
+        {
+            pool.Submit([&count]() { ++count; });
+        }
+    }
+
+    EXPECT_EQ(100, count.load());
+}
+
+TEST_F(BatchImportTest, ImportBatch_futures_returnedInRequestOrder)
+{
+    const auto package = nc::asset::AssetPackage{packagePath};
+    auto pool = nc::asset::ThreadPool{2};
+    const auto requests = std::vector<nc::asset::ImportRequest>{
+        {size_t{30}, nc::asset::AssetType::Texture},
+        {ncaPath, nc::asset::AssetType::Texture},
+        {size_t{10}, nc::asset::AssetType::Texture},
+        {size_t{20}, nc::asset::AssetType::Texture}
+    };
+
+    auto futures = nc::asset::ImportBatch(requests, pool, &package);
+    ASSERT_EQ(4u, futures.size());
+
+    const auto expected = std::vector<unsigned char>{3, 4, 1, 2};
+    for (auto i = size_t{0}; i < futures.size(); ++i)
+    {
+        const auto asset = futures[i].get();
+        ASSERT_TRUE(std::holds_alternative<nc::asset::Texture>(asset));
+        EXPECT_EQ(expected[i], std::get<nc::asset::Texture>(asset).pixelData.at(0));
+    }
+}
+
+TEST_F(BatchImportTest, ImportBatch_defaultPool_succeeds)
+{
+    const auto requests = std::vector<nc::asset::ImportRequest>{{ncaPath, nc::asset::AssetType::Texture}};
+    auto futures = nc::asset::ImportBatch(requests);
+    ASSERT_EQ(1u, futures.size());
+    EXPECT_EQ(4u, std::get<nc::asset::Texture>(futures[0].get()).pixelData.at(0));
+}
+
+TEST_F(BatchImportTest, ImportBatch_failures_propagateThroughFuture)
+{
+    const auto package = nc::asset::AssetPackage{packagePath};
+    auto pool = nc::asset::ThreadPool{2};
+    const auto requests = std::vector<nc::asset::ImportRequest>{
+        {size_t{99}, nc::asset::AssetType::Texture},
+        {size_t{10}, nc::asset::AssetType::Mesh},
+        {size_t{10}, nc::asset::AssetType::Shader},
+        {std::filesystem::path{"./missing.nca"}, nc::asset::AssetType::Texture}
+    };
+
+    auto futures = nc::asset::ImportBatch(requests, pool, &package);
+    for (auto& future : futures)
+    {
+        EXPECT_THROW(future.get(), nc::NcError);
+    }
+
+    auto withoutPackage = nc::asset::ImportBatch(std::span{requests}.first(1), pool);
+    EXPECT_THROW(withoutPackage[0].get(), nc::NcError);
+}
+
+TEST_F(BatchImportTest, ImportBatch_callback_receivesEveryResult)
+{
+    const auto package = nc::asset::AssetPackage{packagePath};
+    auto pool = nc::asset::ThreadPool{2};
+    const auto requests = std::vector<nc::asset::ImportRequest>{
+        {size_t{10}, nc::asset::AssetType::Texture},
+        {size_t{99}, nc::asset::AssetType::Texture},
+        {size_t{20}, nc::asset::AssetType::Texture}
+    };
+
+    auto mutex = std::mutex{};
+    auto results = std::vector<nc::asset::ImportResult>{};
+    auto done = std::latch{static_cast<std::ptrdiff_t>(requests.size())};
+    nc::asset::ImportBatch(requests, pool, [&](nc::asset::ImportResult&& result)
+    {
+        {
+            auto lock = std::lock_guard{mutex};
+            results.push_back(std::move(result));
+        }
+
+        done.count_down();
+    }, &package);
+
+    done.wait();
+    ASSERT_EQ(3u, results.size());
+    std::ranges::sort(results, {}, &nc::asset::ImportResult::requestIndex);
+    EXPECT_TRUE(results[0].asset.has_value());
+    EXPECT_FALSE(results[0].error);
+    EXPECT_FALSE(results[1].asset.has_value());
+    EXPECT_TRUE(results[1].error);
+    EXPECT_EQ(2u, std::get<nc::asset::Texture>(*results[2].asset).pixelData.at(0));
+}
+
+TEST_F(BatchImportTest, ImportBatch_bulkReader_receivesEveryResult)
+{
+    const auto package = nc::asset::AssetPackage{packagePath};
+    auto reader = nc::asset::BulkReader{4};
+    auto pool = nc::asset::ThreadPool{2};
+    const auto requests = std::vector<nc::asset::ImportRequest>{
+        {size_t{30}, nc::asset::AssetType::Texture},
+        {ncaPath, nc::asset::AssetType::Texture},
+        {std::filesystem::path{"./missing.nca"}, nc::asset::AssetType::Texture},
+        {ncaPath, nc::asset::AssetType::Mesh}
+    };
+
+    auto mutex = std::mutex{};
+    auto results = std::vector<nc::asset::ImportResult>{};
+    auto done = std::latch{static_cast<std::ptrdiff_t>(requests.size())};
+    nc::asset::ImportBatch(requests, reader, pool, [&](nc::asset::ImportResult&& result)
+    {
+        {
+            auto lock = std::lock_guard{mutex};
+            results.push_back(std::move(result));
+        }
+
+        done.count_down();
+    }, &package);
+
+    done.wait();
+    ASSERT_EQ(4u, results.size());
+    std::ranges::sort(results, {}, &nc::asset::ImportResult::requestIndex);
+    EXPECT_EQ(3u, std::get<nc::asset::Texture>(*results[0].asset).pixelData.at(0));
+    EXPECT_EQ(4u, std::get<nc::asset::Texture>(*results[1].asset).pixelData.at(0));
+    EXPECT_FALSE(results[2].asset.has_value());
+    EXPECT_THROW(std::rethrow_exception(results[2].error), nc::NcError);
+    EXPECT_FALSE(results[3].asset.has_value());
+    EXPECT_THROW(std::rethrow_exception(results[3].error), nc::NcError);
+}
@@ -0,0 +1,115 @@
+#include "gtest/gtest.h"
+#include "ncasset/BulkReader.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace
+{
+const auto testDirectory = std::filesystem::path{"./BulkReader_unit_tests"};
+
+auto MakeContents(size_t index) -> std::vector<std::byte>
+{
+    auto bytes = std::vector<std::byte>(index * 37);
+    for (auto i = size_t{0}; i < bytes.size(); ++i)
+    {
+        bytes[i] = static_cast<std::byte>((i + index) & 0xFF);
+    }
+
+    return bytes;
+}
+
+auto WriteFiles(size_t count) -> std::vector<std::filesystem::path>
+{
+    auto paths = std::vector<std::filesystem::path>{};
+    for (auto i = size_t{0}; i < count; ++i)
+    {
+        const auto bytes = MakeContents(i);
+        paths.push_back(testDirectory / (std::to_string(i) + ".nca"));
+        auto file = std::ofstream{paths.back(), std::ios::binary};
+        file.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+    }
+
+    return paths;
+}
+
+auto ReadAll(nc::asset::BulkReader& reader, std::span<const std::filesystem::path> paths) -> std::vector<nc::asset::BulkReadResult>
+{
+    auto mutex = std::mutex{};
+    auto results = std::vector<nc::asset::BulkReadResult>{};
+    reader.Read(paths, [&](nc::asset::BulkReadResult&& result)
+    {
+        auto lock = std::lock_guard{mutex};
+        results.push_back(std::move(result));
+    });
+
+    std::ranges::sort(results, {}, &nc::asset::BulkReadResult::pathIndex);
+    return results;
+}
+} // anonymous namespace
+
+class BulkReaderTest : public ::testing::TestWithParam<nc::asset::BulkReadMode>
+{
+    public:
+        BulkReaderTest()
+        {
+            std::filesystem::create_directories(testDirectory);
+        }
+
+        ~BulkReaderTest()
+        {
+            std::filesystem::remove_all(testDirectory);
+        }
+};
+
+TEST_P(BulkReaderTest, Read_moreFilesThanQueueDepth_deliversEachOnce)
+{
+    const auto paths = WriteFiles(300);
+    auto reader = nc::asset::BulkReader{8, GetParam()};
+    const auto results = ReadAll(reader, paths);
+
+    ASSERT_EQ(paths.size(), results.size());
+    for (auto i = size_t{0}; i < results.size(); ++i)
+    {
+        EXPECT_EQ(i, results[i].pathIndex);
+        EXPECT_FALSE(results[i].error);
+        EXPECT_EQ(MakeContents(i), results[i].bytes);
+    }
+
+    const auto again = ReadAll(reader, std::span{paths}.first(3));
+    ASSERT_EQ(3u, again.size());
+    EXPECT_EQ(MakeContents(2), again[2].bytes);
+}
+
+TEST_P(BulkReaderTest, Read_missingFile_reportsError)
+{
+    auto paths = WriteFiles(2);
+    paths.insert(paths.begin() + 1, testDirectory / "missing.nca");
+    auto reader = nc::asset::BulkReader{2, GetParam()};
+    const auto results = ReadAll(reader, paths);
+
+    ASSERT_EQ(3u, results.size());
+    EXPECT_FALSE(results[0].error);
+    EXPECT_TRUE(results[0].bytes.empty());
+    EXPECT_THROW(std::rethrow_exception(results[1].error), nc::NcError);
+    EXPECT_FALSE(results[2].error);
+    EXPECT_EQ(MakeContents(1), results[2].bytes);
+}
+
+TEST_P(BulkReaderTest, Read_noFiles_returnsImmediately)
+{
+    auto reader = nc::asset::BulkReader{4, GetParam()};
+    EXPECT_TRUE(ReadAll(reader, {}).empty());
+}
+
+TEST(BulkReaderModeTest, Construct_blocking_doesNotUseIoUring)
+{
+    EXPECT_FALSE(nc::asset::BulkReader(4, nc::asset::BulkReadMode::Blocking).IsUsingIoUring());
+}
+
+INSTANTIATE_TEST_SUITE_P(Modes,
+                         BulkReaderTest,
+                         ::testing::Values(nc::asset::BulkReadMode::Automatic, nc::asset::BulkReadMode::Blocking));
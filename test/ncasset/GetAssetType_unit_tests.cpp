@@ -30,6 +30,9 @@ TEST(GetAssetTypeTests, ValidMagicNumber_succeeds)
     SetMagicNumber(header, nc::asset::MagicNumber::shader);
     EXPECT_EQ(nc::asset::AssetType::Shader, nc::asset::GetAssetType(header));
 
+    SetMagicNumber(header, nc::asset::MagicNumber::skeletalAnimation);
+    EXPECT_EQ(nc::asset::AssetType::SkeletalAnimation, nc::asset::GetAssetType(header));
+
     SetMagicNumber(header, nc::asset::MagicNumber::texture);
     EXPECT_EQ(nc::asset::AssetType::Texture, nc::asset::GetAssetType(header));
 }
@@ -0,0 +1,136 @@
+#include "gtest/gtest.h"
+#include "TestAssets.h"
+#include "ncasset/IncrementalImporter.h"
+#include "ncasset/Assets.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <sstream>
+#include <thread>
+
+namespace
+{
+const auto ncaPath = std::filesystem::path{"./IncrementalImporter_unit_tests.nca"};
+const auto packagePath = std::filesystem::path{"./IncrementalImporter_unit_tests.ncp"};
+
+auto MakeStream(const std::string& bytes) -> std::unique_ptr<std::istream>
+{
+    return std::make_unique<std::istringstream>(bytes, std::ios::binary);
+}
+
+} // anonymous namespace
+
+TEST(IncrementalImporterTest, Step_byteBudget_completesAcrossSteps)
+{
+    const auto expected = MakeTexture(256, 256);
+    auto importer = nc::asset::IncrementalImporter<nc::asset::Texture>{MakeStream(SerializeNca(expected, 1u))};
+    EXPECT_EQ(0.0f, importer.GetProgress());
+
+    auto steps = 0u;
+    auto progress = 0.0f;
+    while (!importer.Step(nc::asset::ImportBudget{.bytes = 32 * 1024}))
+    {
+        EXPECT_FALSE(importer.IsComplete());
+        EXPECT_LT(progress, importer.GetProgress());
+        progress = importer.GetProgress();
+        ++steps;
+    }
+
+    // The pixels alone take eight 32 KiB steps.
+    EXPECT_GE(steps, 8u);
+    EXPECT_TRUE(importer.IsComplete());
+    EXPECT_EQ(1.0f, importer.GetProgress());
+    EXPECT_TRUE(importer.Step());
+
+    const auto actual = importer.Finish();
+    EXPECT_EQ(expected.width, actual.width);
+    EXPECT_EQ(expected.height, actual.height);
+    EXPECT_EQ(expected.pixelData, actual.pixelData);
+}
+
+TEST(IncrementalImporterTest, Step_zeroTime_readsOneSlicePerStep)
+{
+    const auto expected = MakeTexture(128, 128);
+    auto importer = nc::asset::IncrementalImporter<nc::asset::Texture>{MakeStream(SerializeNca(expected, 1u))};
+    const auto budget = nc::asset::ImportBudget{.time = std::chrono::microseconds{0}};
+
+    auto steps = 1u;
+    while (!importer.Step(budget))
+    {
+        ++steps;
+    }
+
+    EXPECT_GE(steps, 2u);
+    EXPECT_EQ(expected.pixelData, importer.Finish().pixelData);
+    EXPECT_THROW(importer.Step(nc::asset::ImportBudget{.bytes = 0}), nc::NcError);
+}
+
+TEST(IncrementalImporterTest, Finish_fromFileAndPackage_returnsAsset)
+{
+    const auto expected = MakeTexture(64, 64);
+    const auto nca = SerializeNca(expected, 42u);
+    WriteFile(ncaPath, nca);
+    WritePackage(packagePath, {{42u, nca}});
+
+    auto fromFile = nc::asset::IncrementalImporter<nc::asset::Texture>{ncaPath};
+    EXPECT_FALSE(fromFile.Step(nc::asset::ImportBudget{.bytes = 1024}));
+    EXPECT_EQ(expected.pixelData, fromFile.Finish().pixelData);
+
+    const auto package = nc::asset::AssetPackage{packagePath};
+    auto fromPackage = nc::asset::IncrementalImporter<nc::asset::Texture>{package, 42u};
+    EXPECT_FALSE(fromPackage.Step(nc::asset::ImportBudget{.bytes = 1024}));
+
+    // The package is not locked between steps.
+    auto other = nc::asset::IncrementalImporter<nc::asset::Texture>{package, 42u};
+    EXPECT_EQ(expected.pixelData, other.Finish().pixelData);
+    EXPECT_EQ(expected.pixelData, fromPackage.Finish().pixelData);
+
+    EXPECT_THROW((nc::asset::IncrementalImporter<nc::asset::Texture>{package, 7u}), nc::NcError);
+
+    std::filesystem::remove(ncaPath);
+    std::filesystem::remove(packagePath);
+}
+
+TEST(IncrementalImporterTest, Step_invalidData_throws)
+{
+    auto truncated = SerializeNca(MakeTexture(64, 64), 1u);
+    truncated.resize(truncated.size() - 1);
+    auto importer = nc::asset::IncrementalImporter<nc::asset::Texture>{MakeStream(truncated)};
+    EXPECT_THROW(importer.Finish(), nc::NcError);
+
+    auto wrongType = nc::asset::IncrementalImporter<nc::asset::Mesh>{MakeStream(SerializeNca(MakeTexture(1, 1), 1u))};
+    EXPECT_THROW(wrongType.Step(), nc::NcError);
+    EXPECT_TRUE(wrongType.IsComplete());
+}
+
+TEST(IncrementalImporterTest, Destroy_unfinishedImport_stopsWorker)
+{
+    auto importers = std::vector<nc::asset::IncrementalImporter<nc::asset::Texture>>{};
+    for (auto i = 0u; i < 4u; ++i)
+    {
+        importers.emplace_back(MakeStream(SerializeNca(MakeTexture(256, 256), i)));
+        EXPECT_FALSE(importers.back().Step(nc::asset::ImportBudget{.bytes = 1}));
+    }
+
+    importers[0] = std::move(importers[1]);
+    EXPECT_FALSE(importers[0].Step(nc::asset::ImportBudget{.bytes = 1}));
+    importers.clear();
+}
+
+TEST(IncrementalImporterTest, Step_morePausedImportsThanPoolThreads_allComplete)
+{
+    // Paused imports hold their pool threads, so the extra imports must not queue behind them.
+    const auto count = std::max(1u, std::thread::hardware_concurrency()) + 2u;
+    const auto expected = MakeTexture(64, 64);
+    auto importers = std::vector<nc::asset::IncrementalImporter<nc::asset::Texture>>{};
+    for (auto i = 0u; i < count; ++i)
+    {
+        importers.emplace_back(MakeStream(SerializeNca(expected, i)));
+        EXPECT_FALSE(importers.back().Step(nc::asset::ImportBudget{.bytes = 1}));
+    }
+
+    for (auto& importer : importers)
+    {
+        EXPECT_EQ(expected.pixelData, importer.Finish().pixelData);
+    }
+}
@@ -0,0 +1,134 @@
+#pragma once
+
+#include "ncasset/Assets.h"
+#include "ncasset/NcaHeader.h"
+#include "ncasset/NcpHeader.h"
+#include "ncutility/BinarySerialization.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+/** An nca to write into a test package with WritePackage(). */
+struct TestPackageEntry
+{
+    size_t assetId;
+    std::string nca;
+    int64_t lastUpdated = 0;
+};
+
+/** Make a 1x1 texture with every channel set to value. */
+inline auto MakeTexture(unsigned char value) -> nc::asset::Texture
+{
+    return nc::asset::Texture{
+        .width = 1,
+        .height = 1,
+        .pixelData = std::vector<unsigned char>{value, value, value, value}
+    };
+}
+
+/** Make a texture of a given size with a repeating pattern of pixel data. */
+inline auto MakeTexture(uint32_t width, uint32_t height) -> nc::asset::Texture
+{
+    auto texture = nc::asset::Texture{.width = width, .height = height, .pixelData = std::vector<unsigned char>(width * height * 4)};
+    for (auto i = size_t{0}; i < texture.pixelData.size(); ++i)
+    {
+        texture.pixelData[i] = static_cast<unsigned char>((i * 7) & 0xFF);
+    }
+
+    return texture;
+}
+
+/** Serialize an uncompressed texture nca, with no padding before the pixel array. */
+inline auto SerializeNca(const nc::asset::Texture& texture, size_t assetId) -> std::string
+{
+    auto blob = std::ostringstream{std::ios::binary};
+    nc::serialize::Serialize(blob, texture.width);
+    nc::serialize::Serialize(blob, texture.height);
+    nc::serialize::Serialize(blob, texture.pixelData.size());
+    nc::serialize::Serialize(blob, uint32_t{0}); // array padding
+    blob.write(reinterpret_cast<const char*>(texture.pixelData.data()), static_cast<std::streamsize>(texture.pixelData.size()));
+    const auto blobBytes = blob.str();
+
+    auto header = nc::asset::NcaHeader{};
+    std::memcpy(header.magicNumber, nc::asset::MagicNumber::texture.data(), 4);
+    header.assetId = assetId;
+    header.size = blobBytes.size();
+
+    auto out = std::ostringstream{std::ios::binary};
+    nc::asset::Serialize(out, header);
+    out << blobBytes;
+    return out.str();
+}
+
+/** Serialize a texture nca header followed by blobSize filler bytes, for tests that only read headers. */
+inline auto SerializeFillerNca(size_t assetId, size_t blobSize) -> std::string
+{
+    auto header = nc::asset::NcaHeader{};
+    std::memcpy(header.magicNumber, nc::asset::MagicNumber::texture.data(), 4);
+    header.assetId = assetId;
+    header.size = blobSize;
+
+    auto out = std::ostringstream{std::ios::binary};
+    nc::asset::Serialize(out, header);
+    out << std::string(blobSize, 'x');
+    return out.str();
+}
+
+inline void WriteFile(const std::filesystem::path& path, std::string_view contents)
+{
+    auto file = std::ofstream{path, std::ios::binary | std::ios::trunc};
+    file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+}
+
+/** Write a package with ncas stored in entry order, replacing any existing package by renaming over it. */
+inline void WritePackage(const std::filesystem::path& path, const std::vector<TestPackageEntry>& assets)
+{
+    auto header = nc::asset::NcpHeader{};
+    header.assetCount = assets.size();
+
+    auto ncas = std::string{};
+    auto entries = std::vector<nc::asset::LutEntry>{};
+    const auto dataOffset = nc::asset::NcpHeader::binarySize
+                          + assets.size() * nc::asset::LutEntry::binarySize
+                          + nc::asset::GetLutBucketCount(assets.size()) * sizeof(uint32_t);
+    for (const auto& asset : assets)
+    {
+        entries.push_back(nc::asset::LutEntry{asset.assetId, dataOffset + ncas.size(), asset.lastUpdated});
+        ncas += asset.nca;
+    }
+
+    const auto seeds = nc::asset::BuildLutHash(entries);
+    const auto tempPath = std::filesystem::path{path.string() + ".tmp"};
+    {
+        auto file = std::ofstream{tempPath, std::ios::binary | std::ios::trunc};
+        nc::asset::Serialize(file, header);
+        for (const auto& entry : entries)
+        {
+            nc::asset::Serialize(file, entry);
+        }
+
+        file.write(reinterpret_cast<const char*>(seeds.data()), static_cast<std::streamsize>(seeds.size() * sizeof(uint32_t)));
+        file << ncas;
+    }
+
+    std::filesystem::rename(tempPath, path);
+}
+
+/** Write a package of uncompressed texture ncas. */
+inline void WritePackage(const std::filesystem::path& path, const std::vector<std::pair<size_t, nc::asset::Texture>>& textures)
+{
+    auto assets = std::vector<TestPackageEntry>{};
+    assets.reserve(textures.size());
+    for (const auto& [id, texture] : textures)
+    {
+        assets.push_back(TestPackageEntry{id, SerializeNca(texture, id)});
+    }
+
+    WritePackage(path, assets);
+}
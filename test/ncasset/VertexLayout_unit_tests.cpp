@@ -0,0 +1,183 @@
+#include "gtest/gtest.h"
+#include "ncasset/VertexLayout.h"
+#include "ncutility/NcError.h"
+
+#include <cstring>
+#include <limits>
+
+namespace
+{
+using nc::asset::VertexAttribute;
+using nc::asset::VertexFormat;
+
+auto MakeVertices() -> std::vector<nc::asset::MeshVertex>
+{
+    return std::vector<nc::asset::MeshVertex>{
+        nc::asset::MeshVertex{
+            .position = nc::Vector3{1.0f, 2.0f, 3.0f},
+            .normal = nc::Vector3{0.0f, 1.0f, -1.0f},
+            .uv = nc::Vector2{0.5f, 0.25f},
+            .tangent = nc::Vector3{1.0f, 0.0f, 0.0f},
+            .bitangent = nc::Vector3{0.0f, 0.0f, 1.0f},
+            .boneWeights = nc::Vector4{1.0f, 0.0f, 0.5f, 0.0f},
+            .boneIds = {1u, 2u, 3u, 4u}
+        },
+        nc::asset::MeshVertex{
+            .position = nc::Vector3{-4.0f, 5.0f, -6.0f},
+            .normal = nc::Vector3{-1.0f, 0.0f, 0.0f},
+            .uv = nc::Vector2{1.0f, 0.0f},
+            .tangent = nc::Vector3{0.0f, 1.0f, 0.0f},
+            .bitangent = nc::Vector3{0.0f, -1.0f, 0.0f},
+            .boneWeights = nc::Vector4{0.25f, 0.75f, 0.0f, 0.0f},
+            .boneIds = {5u, 6u, 7u, 8u}
+        }
+    };
+}
+
+template<class T>
+auto ReadAt(const std::vector<std::byte>& bytes, size_t offset) -> T
+{
+    auto out = T{};
+    std::memcpy(&out, bytes.data() + offset, sizeof(T));
+    return out;
+}
+
+auto ToHalf(float value) -> uint16_t
+{
+    const auto vertices = std::vector<nc::asset::MeshVertex>{nc::asset::MeshVertex{.boneWeights = nc::Vector4{value, 0.0f, 0.0f, 0.0f}}};
+    const auto layout = nc::asset::MakeInterleavedLayout({{VertexAttribute::BoneWeights, VertexFormat::Float16x4}});
+    auto bytes = std::vector<std::byte>(layout.strides[0]);
+    const auto streams = std::vector<std::span<std::byte>>{bytes};
+    nc::asset::ConvertVertices(vertices, layout, streams);
+    return ReadAt<uint16_t>(bytes, 0);
+}
+} // anonymous namespace
+
+TEST(VertexLayoutTest, MakeInterleavedLayout_packsAttributesInOrder)
+{
+    const auto layout = nc::asset::MakeInterleavedLayout({
+        {VertexAttribute::Position, VertexFormat::Float32x3},
+        {VertexAttribute::Normal, VertexFormat::Snorm8x4},
+        {VertexAttribute::Uv, VertexFormat::Float16x2}
+    });
+
+    ASSERT_EQ(1u, layout.strides.size());
+    EXPECT_EQ(20u, layout.strides[0]);
+    ASSERT_EQ(3u, layout.elements.size());
+    EXPECT_EQ(0u, layout.elements[0].offset);
+    EXPECT_EQ(12u, layout.elements[1].offset);
+    EXPECT_EQ(16u, layout.elements[2].offset);
+    EXPECT_EQ(40u, nc::asset::GetVertexStreamSize(layout, 0, 2));
+}
+
+TEST(VertexLayoutTest, ConvertVertices_interleaved_writesEachFormat)
+{
+    const auto vertices = MakeVertices();
+    const auto layout = nc::asset::MakeInterleavedLayout({
+        {VertexAttribute::Position, VertexFormat::Float32x3},
+        {VertexAttribute::Normal, VertexFormat::Snorm8x4},
+        {VertexAttribute::Uv, VertexFormat::Float16x2},
+        {VertexAttribute::Tangent, VertexFormat::Snorm16x4},
+        {VertexAttribute::BoneWeights, VertexFormat::Unorm8x4},
+        {VertexAttribute::BoneIds, VertexFormat::Uint8x4}
+    });
+
+    const auto stride = size_t{layout.strides[0]};
+    auto bytes = std::vector<std::byte>(nc::asset::GetVertexStreamSize(layout, 0, vertices.size()));
+    const auto streams = std::vector<std::span<std::byte>>{bytes};
+    nc::asset::ConvertVertices(vertices, layout, streams);
+
+    const auto second = stride;
+    EXPECT_EQ(-4.0f, ReadAt<float>(bytes, second + 0));
+    EXPECT_EQ(5.0f, ReadAt<float>(bytes, second + 4));
+    EXPECT_EQ(-6.0f, ReadAt<float>(bytes, second + 8));
+
+    EXPECT_EQ(0, ReadAt<int8_t>(bytes, 12));
+    EXPECT_EQ(127, ReadAt<int8_t>(bytes, 13));
+    EXPECT_EQ(-127, ReadAt<int8_t>(bytes, 14));
+    EXPECT_EQ(0, ReadAt<int8_t>(bytes, 15));
+
+    EXPECT_EQ(0x3800u, ReadAt<uint16_t>(bytes, 16));
+    EXPECT_EQ(0x3400u, ReadAt<uint16_t>(bytes, 18));
+
+    EXPECT_EQ(0, ReadAt<int16_t>(bytes, second + 20));
+    EXPECT_EQ(32767, ReadAt<int16_t>(bytes, second + 22));
+    EXPECT_EQ(0, ReadAt<int16_t>(bytes, second + 24));
+    EXPECT_EQ(0, ReadAt<int16_t>(bytes, second + 26));
+
+    EXPECT_EQ(255u, ReadAt<uint8_t>(bytes, 28));
+    EXPECT_EQ(0u, ReadAt<uint8_t>(bytes, 29));
+    EXPECT_EQ(128u, ReadAt<uint8_t>(bytes, 30));
+    EXPECT_EQ(191u, ReadAt<uint8_t>(bytes, second + 29));
+
+    EXPECT_EQ(1u, ReadAt<uint8_t>(bytes, 32));
+    EXPECT_EQ(8u, ReadAt<uint8_t>(bytes, second + 35));
+}
+
+TEST(VertexLayoutTest, ConvertVertices_split_writesStreamsFromFirstVertex)
+{
+    const auto vertices = MakeVertices();
+    const auto layout = nc::asset::MakeSplitLayout({
+        {VertexAttribute::Position, VertexFormat::Float32x4},
+        {VertexAttribute::BoneIds, VertexFormat::Uint16x4}
+    });
+
+    ASSERT_EQ(2u, layout.strides.size());
+    auto positions = std::vector<std::byte>(nc::asset::GetVertexStreamSize(layout, 0, 3));
+    auto boneIds = std::vector<std::byte>(nc::asset::GetVertexStreamSize(layout, 1, 3));
+    const auto streams = std::vector<std::span<std::byte>>{positions, boneIds};
+    nc::asset::ConvertVertices(vertices, layout, streams, 1);
+
+    EXPECT_EQ(0.0f, ReadAt<float>(positions, 0));
+    EXPECT_EQ(1.0f, ReadAt<float>(positions, 16));
+    EXPECT_EQ(0.0f, ReadAt<float>(positions, 28));
+    EXPECT_EQ(-6.0f, ReadAt<float>(positions, 40));
+    EXPECT_EQ(1u, ReadAt<uint16_t>(boneIds, 8));
+    EXPECT_EQ(7u, ReadAt<uint16_t>(boneIds, 20));
+}
+
+TEST(VertexLayoutTest, ConvertVertices_float16_roundsToNearestEven)
+{
+    EXPECT_EQ(0x3c00u, ToHalf(1.0f));
+    EXPECT_EQ(0xc000u, ToHalf(-2.0f));
+    EXPECT_EQ(0x7bffu, ToHalf(65504.0f));
+    EXPECT_EQ(0x7c00u, ToHalf(1.0e6f));
+    EXPECT_EQ(0xfc00u, ToHalf(-std::numeric_limits<float>::infinity()));
+    EXPECT_EQ(0x7e00u, ToHalf(std::numeric_limits<float>::quiet_NaN()));
+    EXPECT_EQ(0x0001u, ToHalf(5.9604645e-8f));
+    EXPECT_EQ(0x3c00u, ToHalf(1.0f + 1.0f / 2048.0f));
+    EXPECT_EQ(0x3c02u, ToHalf(1.0f + 3.0f / 2048.0f));
+}
+
+TEST(VertexLayoutTest, ValidateVertexLayout_invalidLayouts_throw)
+{
+    const auto validate = [](nc::asset::VertexLayout layout)
+    {
+        nc::asset::ValidateVertexLayout(layout);
+    };
+
+    EXPECT_THROW(validate({{}, {16u}}), nc::NcError);
+    EXPECT_THROW(validate({{{VertexAttribute::Position, VertexFormat::Float32x3, 1u, 0u}}, {12u}}), nc::NcError);
+    EXPECT_THROW(validate({{{VertexAttribute::Position, VertexFormat::Float32x3, 0u, 4u}}, {12u}}), nc::NcError);
+    EXPECT_THROW(validate({{{VertexAttribute::Position, VertexFormat::Float32x2, 0u, 0u}}, {8u}}), nc::NcError);
+    EXPECT_THROW(validate({{{VertexAttribute::BoneIds, VertexFormat::Float32x4, 0u, 0u}}, {16u}}), nc::NcError);
+    EXPECT_THROW(validate({{{VertexAttribute::Normal, VertexFormat::Uint8x4, 0u, 0u}}, {4u}}), nc::NcError);
+    EXPECT_THROW(validate({{
+        {VertexAttribute::Position, VertexFormat::Float32x3, 0u, 0u},
+        {VertexAttribute::Normal, VertexFormat::Snorm8x4, 0u, 8u}
+    }, {16u}}), nc::NcError);
+    EXPECT_NO_THROW(validate({{{VertexAttribute::Uv, VertexFormat::Float16x2, 0u, 4u}}, {8u}}));
+}
+
+TEST(VertexLayoutTest, ConvertVertices_insufficientDestination_throws)
+{
+    auto vertices = MakeVertices();
+    const auto layout = nc::asset::MakeInterleavedLayout({{VertexAttribute::BoneIds, VertexFormat::Uint8x4}});
+    auto bytes = std::vector<std::byte>(nc::asset::GetVertexStreamSize(layout, 0, vertices.size()));
+    const auto streams = std::vector<std::span<std::byte>>{bytes};
+    EXPECT_THROW(nc::asset::ConvertVertices(vertices, layout, std::span{streams}.first(0)), nc::NcError);
+    EXPECT_THROW(nc::asset::ConvertVertices(vertices, layout, streams, 1), nc::NcError);
+
+    vertices[1].boneIds[0] = 256u;
+    EXPECT_THROW(nc::asset::ConvertVertices(vertices, layout, streams), nc::NcError);
+}
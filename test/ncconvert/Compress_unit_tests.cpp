@@ -0,0 +1,253 @@
+#include "gtest/gtest.h"
+#include "ChunkedReader.h"
+#include "Decompress.h"
+#include "utility/Compress.h"
+
+#include "ncasset/Dictionary.h"
+#include "ncasset/NcaHeader.h"
+#include "ncutility/NcError.h"
+
+#include <algorithm>
+#include <cstring>
+#include <random>
+
+namespace
+{
+auto MakeRandomBytes(size_t count, unsigned seed) -> std::vector<std::byte>
+{
+    auto engine = std::mt19937{seed};
+    auto distribution = std::uniform_int_distribution<int>{0, 255};
+    auto out = std::vector<std::byte>(count);
+    for (auto& byte : out)
+    {
+        byte = static_cast<std::byte>(distribution(engine));
+    }
+
+    return out;
+}
+
+auto MakeRepeatingBytes(size_t count, size_t period) -> std::vector<std::byte>
+{
+    auto out = std::vector<std::byte>(count);
+    for (auto i = size_t{0}; i < count; ++i)
+    {
+        out[i] = static_cast<std::byte>(i % period);
+    }
+
+    return out;
+}
+
+#ifdef NC_TOOLS_ZSTD
+/** Small records sharing a common layout with a few varying fields, like a set of colliders. */
+auto MakeSimilarRecords(size_t count) -> std::vector<std::vector<std::byte>>
+{
+    auto engine = std::mt19937{7u};
+    auto out = std::vector<std::vector<std::byte>>{};
+    for (auto i = size_t{0}; i < count; ++i)
+    {
+        auto& record = out.emplace_back(MakeRepeatingBytes(600, 24));
+        for (auto j = size_t{0}; j < record.size(); j += 24)
+        {
+            record[j] = static_cast<std::byte>(engine());
+            record[j + 1] = static_cast<std::byte>(i);
+        }
+    }
+
+    return out;
+}
+#endif
+
+auto RoundTrip(const std::vector<std::byte>& data) -> std::vector<std::byte>
+{
+    const auto compressed = nc::convert::Lz4Compress(data);
+    auto out = std::vector<std::byte>(data.size());
+    nc::asset::Lz4Decompress(compressed, out);
+    return out;
+}
+} // anonymous namespace
+
+TEST(CompressTest, Lz4_smallInputs_roundTrip)
+{
+    for (auto size : {0u, 1u, 4u, 12u, 13u, 16u, 17u, 64u})
+    {
+        const auto data = MakeRepeatingBytes(size, 3);
+        EXPECT_EQ(data, RoundTrip(data)) << "size: " << size;
+    }
+}
+
+TEST(CompressTest, Lz4_repetitiveData_compressesAndRoundTrips)
+{
+    for (auto period : {size_t{1}, size_t{2}, size_t{7}, size_t{88}, size_t{1000}})
+    {
+        const auto data = MakeRepeatingBytes(300000, period);
+        const auto compressed = nc::convert::Lz4Compress(data);
+        EXPECT_LT(compressed.size(), data.size() / 20) << "period: " << period;
+        EXPECT_EQ(data, RoundTrip(data)) << "period: " << period;
+    }
+}
+
+TEST(CompressTest, Lz4_randomAndMixedData_roundTrips)
+{
+    const auto random = MakeRandomBytes(100000, 42u);
+    EXPECT_EQ(random, RoundTrip(random));
+
+    // Alternate incompressible and repeated runs, including matches further back than the window.
+    auto mixed = std::vector<std::byte>{};
+    for (auto i = 0u; i < 20u; ++i)
+    {
+        const auto noise = MakeRandomBytes(1000u + i * 4000u, i);
+        const auto repeat = MakeRepeatingBytes(500u + i * 300u, 5u + i);
+        mixed.insert(mixed.end(), noise.cbegin(), noise.cend());
+        mixed.insert(mixed.end(), repeat.cbegin(), repeat.cend());
+        mixed.insert(mixed.end(), noise.cbegin(), noise.cbegin() + 300);
+    }
+
+    EXPECT_EQ(mixed, RoundTrip(mixed));
+}
+
+TEST(CompressTest, Lz4Decompress_malformedBlock_throws)
+{
+    const auto data = MakeRepeatingBytes(4096, 16);
+    const auto compressed = nc::convert::Lz4Compress(data);
+    auto out = std::vector<std::byte>(data.size());
+
+    auto truncated = compressed;
+    truncated.resize(truncated.size() / 2);
+    EXPECT_THROW(nc::asset::Lz4Decompress(truncated, out), nc::NcError);
+
+    auto tooSmall = std::vector<std::byte>(data.size() - 1);
+    EXPECT_THROW(nc::asset::Lz4Decompress(compressed, tooSmall), nc::NcError);
+
+    auto tooLarge = std::vector<std::byte>(data.size() + 1);
+    EXPECT_THROW(nc::asset::Lz4Decompress(compressed, tooLarge), nc::NcError);
+
+    // A match offset pointing before the start of the output.
+    const auto badOffset = std::vector<std::byte>{std::byte{0x10}, std::byte{0xAA}, std::byte{0x05}, std::byte{0x00}};
+    EXPECT_THROW(nc::asset::Lz4Decompress(badOffset, out), nc::NcError);
+}
+
+TEST(CompressTest, CompressBlob_roundTripsThroughDecompressBlob)
+{
+    const auto data = MakeRepeatingBytes(10000, 9);
+    const auto blob = nc::convert::CompressBlob(data, nc::asset::CompressionAlgorithm::lz4);
+    auto storedSize = uint64_t{};
+    std::memcpy(&storedSize, blob.data(), sizeof(storedSize));
+    EXPECT_EQ(data.size(), storedSize);
+    EXPECT_EQ(data, nc::asset::DecompressBlob(blob, nc::asset::CompressionAlgorithm::lz4));
+
+    EXPECT_THROW(nc::convert::CompressBlob(data, "ZZZ"), nc::NcError);
+    EXPECT_THROW(nc::asset::DecompressBlob(blob, nc::asset::CompressionAlgorithm::none), nc::NcError);
+
+    auto implausible = blob;
+    const auto hugeSize = uint64_t{1} << 40;
+    std::memcpy(implausible.data(), &hugeSize, sizeof(hugeSize));
+    EXPECT_THROW(nc::asset::DecompressBlob(implausible, nc::asset::CompressionAlgorithm::lz4), nc::NcError);
+}
+
+TEST(CompressTest, CompressBlob_multipleChunks_roundTrips)
+{
+    constexpr auto chunkSize = size_t{4096};
+    const auto data = MakeRandomBytes(chunkSize * 37 + 100, 3u);
+    const auto blob = nc::convert::CompressBlob(data, nc::asset::CompressionAlgorithm::lz4, nullptr, chunkSize);
+    EXPECT_EQ(38u, nc::asset::ChunkedReader(blob, nc::asset::CompressionAlgorithm::lz4).GetChunkCount());
+    EXPECT_EQ(data, nc::asset::DecompressBlob(blob, nc::asset::CompressionAlgorithm::lz4));
+
+    auto empty = std::vector<std::byte>{};
+    EXPECT_EQ(empty, nc::asset::DecompressBlob(nc::convert::CompressBlob(empty, nc::asset::CompressionAlgorithm::lz4), nc::asset::CompressionAlgorithm::lz4));
+}
+
+TEST(CompressTest, ChunkedReader_rangedReads_matchSource)
+{
+    constexpr auto chunkSize = size_t{1000};
+    const auto data = MakeRandomBytes(chunkSize * 12 + 1, 4u);
+    const auto blob = nc::convert::CompressBlob(data, nc::asset::CompressionAlgorithm::lz4, nullptr, chunkSize);
+    auto reader = nc::asset::ChunkedReader{blob, nc::asset::CompressionAlgorithm::lz4};
+
+    // A partial chunk, a skip past several chunks, then a read spanning a partial, whole, and partial chunk.
+    auto out = std::vector<std::byte>(10);
+    reader.ReadBytes(out.data(), out.size());
+    EXPECT_TRUE(std::equal(out.cbegin(), out.cend(), data.cbegin()));
+
+    reader.Skip(4500 - 10);
+    out.resize(3000);
+    reader.ReadBytes(out.data(), out.size());
+    EXPECT_TRUE(std::equal(out.cbegin(), out.cend(), data.cbegin() + 4500));
+    EXPECT_EQ(7500u, reader.Position());
+
+    reader.Skip(reader.Remaining() - 1);
+    auto last = std::byte{};
+    reader.Read(last);
+    EXPECT_EQ(data.back(), last);
+    EXPECT_THROW(reader.Read(last), nc::NcError);
+}
+
+TEST(CompressTest, ChunkedReader_invalidTable_throws)
+{
+    const auto data = MakeRepeatingBytes(5000, 11);
+    const auto blob = nc::convert::CompressBlob(data, nc::asset::CompressionAlgorithm::lz4, nullptr, 1024);
+
+    auto wrongCount = blob;
+    wrongCount[12] = std::byte{9};
+    EXPECT_THROW(nc::asset::ChunkedReader(wrongCount, nc::asset::CompressionAlgorithm::lz4), nc::NcError);
+
+    auto wrongSize = blob;
+    wrongSize[16] = static_cast<std::byte>(std::to_integer<int>(wrongSize[16]) + 1);
+    EXPECT_THROW(nc::asset::ChunkedReader(wrongSize, nc::asset::CompressionAlgorithm::lz4), nc::NcError);
+
+    auto truncated = blob;
+    truncated.resize(10);
+    EXPECT_THROW(nc::asset::ChunkedReader(truncated, nc::asset::CompressionAlgorithm::lz4), nc::NcError);
+
+    // A corrupt chunk surfaces as an exception from the reading thread, even when decoded by a worker.
+    auto corrupt = blob;
+    const auto chunkData = 16 + 5 * sizeof(uint32_t);
+    std::fill(corrupt.begin() + static_cast<std::ptrdiff_t>(chunkData), corrupt.end(), std::byte{0xFF});
+    EXPECT_THROW(nc::asset::DecompressBlob(corrupt, nc::asset::CompressionAlgorithm::lz4), nc::NcError);
+}
+
+#ifdef NC_TOOLS_ZSTD
+TEST(CompressTest, Zstd_noDictionary_roundTrips)
+{
+    const auto data = MakeRepeatingBytes(50000, 13);
+    const auto blob = nc::convert::CompressBlob(data, nc::asset::CompressionAlgorithm::zstd);
+    EXPECT_LT(blob.size(), data.size() / 20);
+    EXPECT_EQ(data, nc::asset::DecompressBlob(blob, nc::asset::CompressionAlgorithm::zstd));
+
+    auto truncated = blob;
+    truncated.resize(truncated.size() - 4);
+    EXPECT_THROW(nc::asset::DecompressBlob(truncated, nc::asset::CompressionAlgorithm::zstd), nc::NcError);
+}
+
+TEST(CompressTest, TrainDictionary_tooFewSamples_returnsNullopt)
+{
+    const auto records = MakeSimilarRecords(3);
+    const auto samples = std::vector<std::span<const std::byte>>{records.cbegin(), records.cend()};
+    EXPECT_FALSE(nc::convert::TrainDictionary(samples).has_value());
+}
+
+TEST(CompressTest, Zstd_withDictionary_requiresRegistrationAndImprovesRatio)
+{
+    const auto records = MakeSimilarRecords(64);
+    const auto samples = std::vector<std::span<const std::byte>>{records.cbegin(), records.cend()};
+    const auto dictionary = nc::convert::TrainDictionary(samples);
+    ASSERT_TRUE(dictionary.has_value());
+    EXPECT_NE(0u, dictionary->GetId());
+
+    const auto& record = records.front();
+    const auto plain = nc::convert::CompressBlob(record, nc::asset::CompressionAlgorithm::zstd);
+    const auto trained = nc::convert::CompressBlob(record, nc::asset::CompressionAlgorithm::zstd, &dictionary.value());
+    EXPECT_LT(trained.size(), plain.size());
+
+    EXPECT_THROW(nc::asset::DecompressBlob(trained, nc::asset::CompressionAlgorithm::zstd), nc::NcError);
+    EXPECT_EQ(dictionary->GetId(), nc::asset::RegisterDictionary(dictionary->GetBytes()));
+    EXPECT_EQ(record, nc::asset::DecompressBlob(trained, nc::asset::CompressionAlgorithm::zstd));
+}
+
+TEST(CompressTest, DictionaryAssetId_roundTrips)
+{
+    const auto assetId = nc::asset::GetDictionaryAssetId(123456u);
+    EXPECT_TRUE(nc::asset::IsDictionaryAssetId(assetId));
+    EXPECT_EQ(123456u, assetId & 0xFFFFFFFFu);
+    EXPECT_FALSE(nc::asset::IsDictionaryAssetId(123456u));
+}
+#endif
@@ -1,5 +1,6 @@
 #include "gtest/gtest.h"
 #include "utility/EnumExtensions.h"
+#include "ncasset/NcaHeader.h"
 
 #include "ncutility/NcError.h"
 
@@ -34,3 +35,15 @@ TEST(EnumExtensionsTest, ToString_badAssetType_throws)
 {
     EXPECT_THROW(nc::convert::ToString(static_cast<nc::asset::AssetType>(999)), nc::NcError);
 }
+
+TEST(EnumExtensionsTest, ToCompressionAlgorithm_fromString_succeeds)
+{
+    EXPECT_EQ(nc::convert::ToCompressionAlgorithm("none"), nc::asset::CompressionAlgorithm::none);
+    EXPECT_EQ(nc::convert::ToCompressionAlgorithm("LZ4"), nc::asset::CompressionAlgorithm::lz4);
+    EXPECT_THROW(nc::convert::ToCompressionAlgorithm("zip"), nc::NcError);
+#ifdef NC_TOOLS_ZSTD
+    EXPECT_EQ(nc::convert::ToCompressionAlgorithm("Zstd"), nc::asset::CompressionAlgorithm::zstd);
+#else
+    EXPECT_THROW(nc::convert::ToCompressionAlgorithm("zstd"), nc::NcError);
+#endif
+}